@@ -6,6 +6,8 @@
 
 #define USE_LAYOUT 1
 
+#include <cstring>
+
 #include <sbml/SBMLDocument.h>
 
 #include "copasi.h"
@@ -38,6 +40,8 @@
 #include "utilities/CCopasiProblem.h"
 #include "copasi/core/CDataVector.h"
 #include "utilities/CDirEntry.h"
+#include "utilities/Cmd5.h"
+#include "utilities/CVersion.h"
 #include "xml/CCopasiXML.h"
 #include "undo/CUndoData.h"
 #include "steadystate/CSteadyStateTask.h"
@@ -46,6 +50,7 @@
 #include "layout/CListOfLayouts.h"
 #include "layout/CLayoutInitializer.h"
 #include "copasi/core/CRootContainer.h"
+#include "copasi/core/CContext.h"
 
 #ifdef WITH_COMBINE_ARCHIVE
 # include <combine/combinearchive.h>
@@ -78,12 +83,20 @@ CDataModel::CDataModel(const bool withGUI):
   mpInfo(NULL),
   mTempFolders(),
   mNeedToSaveExperimentalData(false),
+  mSnapshotFileName(),
+  mSnapshotDigest(),
+  mCNIndex(),
+  mCNIndexKeys(),
+  mCNIndexEnabled(false),
+  mCNIndexValid(false),
   pOldMetabolites(new CDataVectorS < CMetabOld >)
 {
   mpInfo = new CInfo(this);
   newModel(NULL, true);
   new CCopasiTimer(CCopasiTimer::Type::WALL, this);
   new CCopasiTimer(CCopasiTimer::Type::PROCESS, this);
+
+  buildCNIndex();
 }
 
 // static
@@ -125,11 +138,19 @@ CDataModel::CDataModel(const std::string & name,
   mOldData(withGUI),
   mTempFolders(),
   mNeedToSaveExperimentalData(false),
+  mSnapshotFileName(),
+  mSnapshotDigest(),
+  mCNIndex(),
+  mCNIndexKeys(),
+  mCNIndexEnabled(false),
+  mCNIndexValid(false),
   pOldMetabolites(new CDataVectorS < CMetabOld >)
 {
   newModel(NULL, true);
   new CCopasiTimer(CCopasiTimer::Type::WALL, this);
   new CCopasiTimer(CCopasiTimer::Type::PROCESS, this);
+
+  buildCNIndex();
 }
 
 CDataModel::CDataModel(const CDataModel & src,
@@ -140,13 +161,259 @@ CDataModel::CDataModel(const CDataModel & src,
   mOldData(src.mOldData),
   mTempFolders(),
   mNeedToSaveExperimentalData(false),
+  mSnapshotFileName(),
+  mSnapshotDigest(),
+  mCNIndex(),
+  mCNIndexKeys(),
+  mCNIndexEnabled(false),
+  mCNIndexValid(false),
   pOldMetabolites((src.pOldMetabolites != NULL) ? new CDataVectorS < CMetabOld >(*src.pOldMetabolites, NO_PARENT) : NULL)
-{}
+{
+  buildCNIndex();
+}
+
+// virtual
+const CObjectInterface * CDataModel::getObject(const CCommonName & cn) const
+{
+  // The index is modified by lookups which create objects on demand, i.e.,
+  // it is not thread safe and parallel lookups use the hierarchy.
+  if (!CContext< bool >::inParallel())
+    {
+      if (mCNIndexEnabled && !mCNIndexValid)
+        const_cast< CDataModel * >(this)->buildCNIndex();
+
+      const CDataObject * pObject = findInCNIndex(cn);
+
+      if (pObject != NULL)
+        return pObject;
+    }
+
+  return CDataContainer::getObject(cn);
+}
+
+// virtual
+void CDataModel::hierarchyChanged(const CDataObject * pObject, const HierarchyChange & change)
+{
+  if (!mCNIndexEnabled)
+    return;
+
+  // Objects may be created and destroyed concurrently within a parallel
+  // region, e.g., by the workers of a fit. The index is rebuilt lazily.
+  if (CContext< bool >::inParallel())
+    {
+#ifdef USE_OMP
+#pragma omp critical (CDataModelCNIndex)
+#endif // USE_OMP
+      mCNIndexValid = false;
+
+      return;
+    }
+
+  if (!mCNIndexValid)
+    return;
+
+  switch (change)
+    {
+      case HierarchyChange::Added:
+        addToCNIndex(pObject);
+        break;
+
+      case HierarchyChange::Removed:
+        removeFromCNIndex(pObject);
+        break;
+
+      case HierarchyChange::Renamed:
+        // The descendants are indexed relative to the object and are not affected.
+        removeFromCNIndex(pObject, false);
+        addToCNIndex(pObject, false);
+        break;
+    }
+}
+
+void CDataModel::buildCNIndex()
+{
+  mCNIndex.clear();
+  mCNIndexKeys.clear();
+  mCNIndexEnabled = true;
+  mCNIndexValid = true;
+
+  objectMap::const_iterator it = CDataContainer::getObjects().begin();
+  objectMap::const_iterator end = CDataContainer::getObjects().end();
+
+  for (; it != end; ++it)
+    if ((*it)->getObjectParent() == this)
+      addToCNIndex(*it);
+}
+
+void CDataModel::addToCNIndex(const CDataObject * pObject, const bool & recursive)
+{
+  const CDataContainer * pParent = pObject->getObjectParent();
+
+  // Static strings and separators are created on demand.
+  if (pParent == NULL ||
+      pObject->hasFlag(CDataObject::StaticString))
+    return;
+
+  // The common names of elements of vectors without names and of arrays are
+  // based on indices which change without notice. The lookup of parameters of
+  // reactions depends on the parameter mapping. These are resolved through
+  // the hierarchy.
+  if ((pParent->hasFlag(CDataObject::Vector) && !pParent->hasFlag(CDataObject::NameVector)) ||
+      pParent->hasFlag(CDataObject::Array) ||
+      (dynamic_cast< const CReaction * >(pParent->getObjectParent()) != NULL &&
+       pParent->getObjectType() == "ParameterGroup"))
+    return;
+
+  // The parent is not indexed, i.e., its descendants are not indexed either.
+  if (pParent != this &&
+      mCNIndexKeys.find(pParent) == mCNIndexKeys.end())
+    return;
+
+  // This mirrors CDataObject::getCN()
+  std::string Name;
+
+  if (pParent->hasFlag(CDataObject::NameVector))
+    Name = "[" + CCommonName::escape(pObject->getObjectName()) + "]";
+  else
+    Name = "," + CCommonName::escape(pObject->getObjectType()) + "=" + CCommonName::escape(pObject->getObjectName());
+
+  removeFromCNIndex(pObject, false);
+
+  std::pair< std::unordered_map< std::string, const CDataObject * >::iterator, bool > Inserted =
+    mCNIndex[pParent].insert(std::make_pair(Name, pObject));
+
+  // Objects sharing the common name are ambiguous.
+  if (!Inserted.second && Inserted.first->second != pObject)
+    Inserted.first->second = NULL;
+
+  mCNIndexKeys[pObject] = std::make_pair(pParent, Name);
+
+  const CDataContainer * pContainer = dynamic_cast< const CDataContainer * >(pObject);
+
+  if (!recursive || pContainer == NULL)
+    return;
+
+  objectMap::const_iterator it = pContainer->getObjects().begin();
+  objectMap::const_iterator end = pContainer->getObjects().end();
+
+  for (; it != end; ++it)
+    if ((*it)->getObjectParent() == pContainer)
+      addToCNIndex(*it);
+}
+
+void CDataModel::removeFromCNIndex(const CDataObject * pObject, const bool & recursive)
+{
+  std::unordered_map< const CDataObject *, std::pair< const CDataObject *, std::string > >::iterator found = mCNIndexKeys.find(pObject);
+
+  if (found == mCNIndexKeys.end())
+    return;
+
+  std::unordered_map< const CDataObject *, std::unordered_map< std::string, const CDataObject * > >::iterator itParent = mCNIndex.find(found->second.first);
+
+  if (itParent != mCNIndex.end())
+    {
+      std::unordered_map< std::string, const CDataObject * >::iterator itIndex = itParent->second.find(found->second.second);
+
+      // An ambiguous name stays ambiguous.
+      if (itIndex != itParent->second.end() &&
+          itIndex->second == pObject)
+        itParent->second.erase(itIndex);
+
+      if (itParent->second.empty())
+        mCNIndex.erase(itParent);
+    }
+
+  mCNIndexKeys.erase(found);
+
+  if (!recursive)
+    return;
+
+  // Objects being destroyed are no longer containers, their children have
+  // already been removed.
+  const CDataContainer * pContainer = dynamic_cast< const CDataContainer * >(pObject);
+
+  if (pContainer != NULL)
+    {
+      objectMap::const_iterator it = pContainer->getObjects().begin();
+      objectMap::const_iterator end = pContainer->getObjects().end();
+
+      for (; it != end; ++it)
+        if ((*it)->getObjectParent() == pContainer)
+          removeFromCNIndex(*it);
+    }
+
+  mCNIndex.erase(pObject);
+}
+
+const CDataObject * CDataModel::findInCNIndex(const std::string & cn) const
+{
+  static const std::string Root("CN=Root");
+
+  if (cn.compare(0, Root.size(), Root) != 0)
+    return NULL;
+
+  const CDataObject * pObject = this;
+  std::string::size_type Start = Root.size();
+  std::string::size_type Size = cn.size();
+
+  // Split the common name into the relative names of the objects along
+  // the path, e.g., ",Model=model", ",Vector=Compartments", "[compartment]".
+  while (Start < Size)
+    {
+      bool Bracket = (cn[Start] == '[');
+
+      if (!Bracket && cn[Start] != ',')
+        return NULL;
+
+      std::string::size_type End = Start + 1;
+
+      for (; End < Size; ++End)
+        {
+          if (cn[End] == '\\')
+            {
+              ++End;
+              continue;
+            }
+
+          if (Bracket)
+            {
+              if (cn[End] == ']')
+                {
+                  ++End;
+                  break;
+                }
+            }
+          else if (cn[End] == ',' || cn[End] == '[')
+            break;
+        }
+
+      std::unordered_map< const CDataObject *, std::unordered_map< std::string, const CDataObject * > >::const_iterator itParent = mCNIndex.find(pObject);
+
+      if (itParent == mCNIndex.end())
+        return NULL;
+
+      std::unordered_map< std::string, const CDataObject * >::const_iterator itIndex = itParent->second.find(cn.substr(Start, std::min(End, Size) - Start));
+
+      if (itIndex == itParent->second.end() ||
+          itIndex->second == NULL)
+        return NULL;
+
+      pObject = itIndex->second;
+      Start = End;
+    }
+
+  return pObject != this ? pObject : NULL;
+}
 
 CDataModel::~CDataModel()
 {
   CRegisteredCommonName::setEnabled(false);
 
+  // The index is not maintained while the hierarchy is destroyed.
+  mCNIndexEnabled = false;
+  mCNIndex.clear();
+  mCNIndexKeys.clear();
+
   // Make sure that the old data is deleted
   deleteOldData();
 
@@ -360,7 +627,23 @@ bool CDataModel::loadModel(const std::string & fileName,
       return false;
     }
 
-  if (!loadModel(File, PWD, pProcessReport, deleteOldData))
+  // The snapshot is only valid for the exact file content and COPASI version.
+  if (CRootContainer::getConfiguration() != NULL &&
+      CRootContainer::getConfiguration()->cacheStructuralAnalysis())
+    {
+      mSnapshotFileName = FileName + ".snapshot";
+      mSnapshotDigest = Cmd5::digest(File) + CVersion::VERSION.getVersion();
+
+      File.clear();
+      File.seekg(0, std::ios_base::beg);
+    }
+
+  bool success = loadModel(File, PWD, pProcessReport, deleteOldData);
+
+  mSnapshotFileName.clear();
+  mSnapshotDigest.clear();
+
+  if (!success)
     {
       return false;
     }
@@ -2636,6 +2919,8 @@ void CDataModel::commonAfterLoad(CProcessReport* pProcessReport,
 
 #endif
 
+  bool SnapshotFound = loadSnapshot();
+
   if (mData.pModel->isCompileNecessary() &&
       mData.pModel->compileIfNecessary(pProcessReport))
     {
@@ -2687,6 +2972,9 @@ void CDataModel::commonAfterLoad(CProcessReport* pProcessReport,
         }
 
       mData.pModel->updateInitialValues(CCore::Framework::ParticleNumbers);
+
+      if (status && !SnapshotFound)
+        saveSnapshot();
     }
 
   changed(false);
@@ -2697,6 +2985,71 @@ void CDataModel::commonAfterLoad(CProcessReport* pProcessReport,
     }
 }
 
+bool CDataModel::loadSnapshot()
+{
+  if (mSnapshotFileName.empty() || mData.pModel == NULL)
+    return false;
+
+  std::ifstream File(CLocaleString::fromUtf8(mSnapshotFileName).c_str(), std::ios_base::in | std::ios_base::binary);
+
+  if (File.fail())
+    return false;
+
+  char Magic[8];
+  unsigned C_INT32 Version = 0;
+  unsigned C_INT32 ByteOrder = 0;
+  unsigned C_INT32 Length = 0;
+
+  File.read(Magic, 8);
+  File.read((char *) &Version, sizeof(Version));
+  File.read((char *) &ByteOrder, sizeof(ByteOrder));
+  File.read((char *) &Length, sizeof(Length));
+
+  if (File.fail() ||
+      memcmp(Magic, "COPASISS", 8) != 0 ||
+      Version != 2 ||
+      ByteOrder != 0x01020304 ||
+      Length != mSnapshotDigest.size())
+    return false;
+
+  std::string Digest(Length, '\0');
+  File.read(&Digest[0], Length);
+
+  if (File.fail() || Digest != mSnapshotDigest)
+    return false;
+
+  return mData.pModel->loadStructuralAnalysis(File);
+}
+
+void CDataModel::saveSnapshot()
+{
+  if (mSnapshotFileName.empty() || mData.pModel == NULL)
+    return;
+
+  std::ofstream File(CLocaleString::fromUtf8(mSnapshotFileName).c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+  // The snapshot is only an optimization, i.e., we silently ignore write failures.
+  if (File.fail())
+    return;
+
+  unsigned C_INT32 Version = 2;
+  unsigned C_INT32 ByteOrder = 0x01020304;
+  unsigned C_INT32 Length = (unsigned C_INT32) mSnapshotDigest.size();
+
+  File.write("COPASISS", 8);
+  File.write((const char *) &Version, sizeof(Version));
+  File.write((const char *) &ByteOrder, sizeof(ByteOrder));
+  File.write((const char *) &Length, sizeof(Length));
+  File.write(mSnapshotDigest.c_str(), Length);
+
+  bool success = mData.pModel->saveStructuralAnalysis(File);
+
+  File.close();
+
+  if (!success || File.fail())
+    CDirEntry::remove(mSnapshotFileName);
+}
+
 CUndoData::ChangeSet CDataModel::applyData(const CUndoData & data)
 {
   if (mData.mpUndoStack != NULL &&
@@ -7,6 +7,7 @@
 #define COPASI_CDataModel
 
 #include <map>
+#include <unordered_map>
 
 #include "copasi.h"
 
@@ -173,6 +174,16 @@ public:
 
   virtual ~CDataModel();
 
+  /**
+   * Retrieve the object with the given common name. The names of the objects
+   * in the hierarchy are kept in an index which is updated whenever an object
+   * is added, removed, or renamed. Names which are not in the index are
+   * resolved through the hierarchy.
+   * @param const CCommonName & cn
+   * @return const CObjectInterface * pObject
+   */
+  virtual const CObjectInterface * getObject(const CCommonName & cn) const;
+
   bool loadModel(std::istream & in,
                  const std::string & pwd,
                  CProcessReport* pProcessReport,
@@ -354,6 +365,54 @@ protected:
   void commonAfterLoad(CProcessReport* pProcessReport,
                        const bool & deleteOldData);
 
+  /**
+   * Provide the model with the structural analysis stored in the snapshot file
+   * if the snapshot was created for the loaded file content. Only the
+   * factorization of the stoichiometry matrix is skipped, the file is still
+   * parsed and the model and its math container are still compiled.
+   * @return bool found
+   */
+  bool loadSnapshot();
+
+  /**
+   * Store the structural analysis of the model in the snapshot file
+   */
+  void saveSnapshot();
+
+  /**
+   * Update the common name index for the added, removed, or renamed object
+   * @param const CDataObject * pObject
+   * @param const HierarchyChange & change
+   */
+  virtual void hierarchyChanged(const CDataObject * pObject, const HierarchyChange & change);
+
+  /**
+   * Build the common name index for all objects in the hierarchy and
+   * enable its maintenance
+   */
+  void buildCNIndex();
+
+  /**
+   * Add the object and optionally its descendants to the common name index
+   * @param const CDataObject * pObject
+   * @param const bool & recursive (default: true)
+   */
+  void addToCNIndex(const CDataObject * pObject, const bool & recursive = true);
+
+  /**
+   * Remove the object and optionally its descendants from the common name index
+   * @param const CDataObject * pObject
+   * @param const bool & recursive (default: true)
+   */
+  void removeFromCNIndex(const CDataObject * pObject, const bool & recursive = true);
+
+  /**
+   * Find the object with the given common name in the index
+   * @param const std::string & cn
+   * @return const CDataObject * pObject (NULL if not indexed or ambiguous)
+   */
+  const CDataObject * findInCNIndex(const std::string & cn) const;
+
   // Attributes
 protected:
   CContent mData;
@@ -362,6 +421,41 @@ protected:
   std::vector<std::string> mTempFolders;
   bool mNeedToSaveExperimentalData;
 
+  /**
+   * The snapshot file of the file being loaded (empty if no snapshot is used)
+   */
+  std::string mSnapshotFileName;
+
+  /**
+   * The digest of the content of the file being loaded and the COPASI version
+   */
+  std::string mSnapshotDigest;
+
+  /**
+   * The index of the objects in the hierarchy. For each indexed container the
+   * children are stored by the part of the common name relative to the
+   * container, e.g., ",Vector=Compartments" or "[compartment]". Ambiguous
+   * names map to NULL.
+   */
+  std::unordered_map< const CDataObject *, std::unordered_map< std::string, const CDataObject * > > mCNIndex;
+
+  /**
+   * The parent and the relative name under which each indexed object is stored
+   */
+  std::unordered_map< const CDataObject *, std::pair< const CDataObject *, std::string > > mCNIndexKeys;
+
+  /**
+   * Indicates whether the index is maintained
+   */
+  bool mCNIndexEnabled;
+
+  /**
+   * Indicates whether the index is up to date. Changes of the hierarchy
+   * within a parallel region invalidate the index, which is rebuilt on the
+   * next serial lookup.
+   */
+  bool mCNIndexValid;
+
 public:
   /**
    *  This is a hack at the moment to be able to read Gepasi model files
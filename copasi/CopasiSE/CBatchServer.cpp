@@ -0,0 +1,550 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <sstream>
+#include <streambuf>
+#include <set>
+
+#ifndef WIN32
+# include <unistd.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+#endif // WIN32
+
+#include "copasi.h"
+
+#include "CBatchServer.h"
+
+#include "CopasiDataModel/CDataModel.h"
+#include "copasi/core/CRootContainer.h"
+#include "copasi/core/CDataVector.h"
+#include "copasi/model/CModel.h"
+#include "copasi/math/CMathContainer.h"
+#include "utilities/CCopasiMessage.h"
+#include "utilities/CCopasiTask.h"
+#include "utilities/CDirEntry.h"
+#include "copasi/core/CVector.h"
+
+/**
+ * Stream buffer which forwards the output to the target stream in chunks
+ * of the form "DATA <size>\n<data>". A chunk is written whenever the
+ * buffer is full or the stream is flushed, e.g., at the end of a report row.
+ */
+class CChunkedStreamBuf : public std::streambuf
+{
+public:
+  CChunkedStreamBuf(std::ostream & target):
+    std::streambuf(),
+    mTarget(target)
+  {
+    setp(mBuffer, mBuffer + sizeof(mBuffer));
+  }
+
+  virtual ~CChunkedStreamBuf()
+  {
+    sync();
+  }
+
+protected:
+  virtual int_type overflow(int_type c)
+  {
+    if (sync() != 0)
+      return traits_type::eof();
+
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+      {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+      }
+
+    return traits_type::not_eof(c);
+  }
+
+  virtual int sync()
+  {
+    std::ptrdiff_t Size = pptr() - pbase();
+
+    if (Size > 0)
+      {
+        mTarget << "DATA " << Size << "\n";
+        mTarget.write(pbase(), Size);
+        mTarget.flush();
+        setp(mBuffer, mBuffer + sizeof(mBuffer));
+      }
+
+    return mTarget.good() ? 0 : -1;
+  }
+
+private:
+  std::ostream & mTarget;
+  char mBuffer[65536];
+};
+
+#ifndef WIN32
+/**
+ * Stream buffer reading from and writing to a file descriptor.
+ */
+class CFileDescriptorStreamBuf : public std::streambuf
+{
+public:
+  CFileDescriptorStreamBuf(int fd):
+    std::streambuf(),
+    mFd(fd)
+  {
+    setg(mInput, mInput, mInput);
+    setp(mOutput, mOutput + sizeof(mOutput));
+  }
+
+  virtual ~CFileDescriptorStreamBuf()
+  {
+    sync();
+  }
+
+protected:
+  virtual int_type underflow()
+  {
+    ssize_t Size;
+
+    do
+      Size = ::read(mFd, mInput, sizeof(mInput));
+
+    while (Size < 0 && errno == EINTR);
+
+    if (Size <= 0)
+      return traits_type::eof();
+
+    setg(mInput, mInput, mInput + Size);
+
+    return traits_type::to_int_type(*gptr());
+  }
+
+  virtual int_type overflow(int_type c)
+  {
+    if (sync() != 0)
+      return traits_type::eof();
+
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+      {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+      }
+
+    return traits_type::not_eof(c);
+  }
+
+  virtual int sync()
+  {
+    const char * pData = pbase();
+    const char * pEnd = pptr();
+
+    while (pData < pEnd)
+      {
+        ssize_t Size = ::write(mFd, pData, pEnd - pData);
+
+        if (Size < 0)
+          {
+            if (errno == EINTR) continue;
+
+            return -1;
+          }
+
+        pData += Size;
+      }
+
+    setp(mOutput, mOutput + sizeof(mOutput));
+
+    return 0;
+  }
+
+private:
+  int mFd;
+  char mInput[4096];
+  char mOutput[65536];
+};
+#endif // not WIN32
+
+CBatchServer::CBatchServer():
+  mModels(),
+  mFiles(),
+  mNextHandle(1)
+{}
+
+CBatchServer::~CBatchServer()
+{
+  while (!mModels.empty())
+    close(mModels.begin()->first);
+}
+
+CBatchServer::Status CBatchServer::serve(std::istream & in, std::ostream & out)
+{
+  std::string Line;
+
+  while (std::getline(in, Line))
+    {
+      Status Result = processLine(Line, out);
+      out.flush();
+
+      if (Result != Status::Continue)
+        return Result;
+    }
+
+  return Status::Close;
+}
+
+int CBatchServer::listen(const std::string & socketPath)
+{
+#ifdef WIN32
+  std::cerr << "Local sockets are not supported on this platform, use: --server -" << std::endl;
+  return 1;
+#else
+  struct sockaddr_un Address;
+
+  if (socketPath.size() >= sizeof(Address.sun_path))
+    {
+      std::cerr << "Socket path too long: " << socketPath << std::endl;
+      return 1;
+    }
+
+  int Socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if (Socket < 0)
+    {
+      std::cerr << "Unable to create socket: " << strerror(errno) << std::endl;
+      return 1;
+    }
+
+  memset(&Address, 0, sizeof(Address));
+  Address.sun_family = AF_UNIX;
+  strncpy(Address.sun_path, socketPath.c_str(), sizeof(Address.sun_path) - 1);
+
+  ::unlink(socketPath.c_str());
+
+  if (::bind(Socket, (struct sockaddr *) &Address, sizeof(Address)) != 0 ||
+      ::listen(Socket, 8) != 0)
+    {
+      std::cerr << "Unable to listen on socket " << socketPath << ": " << strerror(errno) << std::endl;
+      ::close(Socket);
+      return 1;
+    }
+
+  Status Result = Status::Continue;
+
+  while (Result != Status::Shutdown)
+    {
+      int Connection = ::accept(Socket, NULL, NULL);
+
+      if (Connection < 0)
+        {
+          if (errno == EINTR) continue;
+
+          std::cerr << "Unable to accept connection: " << strerror(errno) << std::endl;
+          break;
+        }
+
+      {
+        CFileDescriptorStreamBuf Buffer(Connection);
+        std::iostream Stream(&Buffer);
+
+        Result = serve(Stream, Stream);
+      }
+
+      ::close(Connection);
+    }
+
+  ::close(Socket);
+  ::unlink(socketPath.c_str());
+
+  return Result == Status::Shutdown ? 0 : 1;
+#endif // WIN32
+}
+
+// static
+std::vector< std::string > CBatchServer::tokenize(const std::string & line)
+{
+  std::vector< std::string > Tokens;
+  std::string Token;
+  bool InToken = false;
+  bool Quoted = false;
+
+  std::string::const_iterator it = line.begin();
+  std::string::const_iterator end = line.end();
+
+  for (; it != end; ++it)
+    {
+      if (*it == '"')
+        {
+          Quoted = !Quoted;
+          InToken = true;
+        }
+      else if (!Quoted && isspace((unsigned char) *it))
+        {
+          if (InToken)
+            {
+              Tokens.push_back(Token);
+              Token.clear();
+              InToken = false;
+            }
+        }
+      else
+        {
+          Token += *it;
+          InToken = true;
+        }
+    }
+
+  if (InToken)
+    Tokens.push_back(Token);
+
+  return Tokens;
+}
+
+CBatchServer::Status CBatchServer::processLine(const std::string & line, std::ostream & out)
+{
+  std::vector< std::string > Tokens = tokenize(line);
+
+  // Empty lines are ignored.
+  if (Tokens.empty())
+    return Status::Continue;
+
+  CCopasiMessage::clearDeque();
+
+  std::string Command = Tokens[0];
+  std::string Error;
+
+  for (std::string::iterator it = Command.begin(); it != Command.end(); ++it)
+    *it = toupper((unsigned char) *it);
+
+  if (Command == "QUIT")
+    {
+      out << "OK" << std::endl;
+      return Status::Close;
+    }
+
+  if (Command == "SHUTDOWN")
+    {
+      out << "OK" << std::endl;
+      return Status::Shutdown;
+    }
+
+  if (Command == "LOAD" && Tokens.size() == 2)
+    {
+      size_t Handle = load(Tokens[1], Error);
+
+      if (Handle != C_INVALID_INDEX)
+        out << "OK " << Handle << std::endl;
+    }
+  else if (Command == "CLOSE" && Tokens.size() == 2)
+    {
+      size_t Handle = find(Tokens[1], Error);
+
+      if (Handle != C_INVALID_INDEX)
+        {
+          close(Handle);
+          out << "OK" << std::endl;
+        }
+    }
+  else if (Command == "RUN" && Tokens.size() >= 3)
+    {
+      size_t Handle = find(Tokens[1], Error);
+
+      if (Handle != C_INVALID_INDEX)
+        {
+          bool success;
+
+          {
+            CChunkedStreamBuf Buffer(out);
+            std::ostream Stream(&Buffer);
+
+            success = run(mModels[Handle], Tokens[2], Tokens.begin() + 3, Tokens.end(), Stream, Error);
+          }
+
+          if (success)
+            out << "OK " << Handle << std::endl;
+        }
+    }
+  else
+    {
+      Error = "Invalid command: " + line;
+    }
+
+  if (!Error.empty())
+    {
+      // The message must fit on a single line.
+      for (std::string::iterator it = Error.begin(); it != Error.end(); ++it)
+        if (*it == '\n' || *it == '\r') *it = ' ';
+
+      out << "ERROR " << Error << std::endl;
+    }
+
+  return Status::Continue;
+}
+
+size_t CBatchServer::load(const std::string & fileName, std::string & error)
+{
+  std::string FileName = CDirEntry::normalize(fileName);
+  std::map< std::string, size_t >::const_iterator found = mFiles.find(FileName);
+
+  if (found != mFiles.end())
+    return found->second;
+
+  CDataModel * pDataModel = CRootContainer::addDatamodel();
+
+  if (!pDataModel->loadModel(FileName, NULL))
+    {
+      error = "File: " + FileName + " " + CCopasiMessage::getAllMessageText();
+      CRootContainer::removeDatamodel(pDataModel);
+
+      return C_INVALID_INDEX;
+    }
+
+  // We compile the model once so that it is ready for the following jobs.
+  if (pDataModel->getModel() != NULL)
+    pDataModel->getModel()->compileIfNecessary(NULL);
+
+  size_t Handle = mNextHandle++;
+  mModels[Handle] = pDataModel;
+  mFiles[FileName] = Handle;
+
+  return Handle;
+}
+
+size_t CBatchServer::find(const std::string & reference, std::string & error)
+{
+  char * pEnd;
+  size_t Handle = strtoul(reference.c_str(), &pEnd, 10);
+
+  if (!reference.empty() && *pEnd == 0)
+    {
+      if (mModels.find(Handle) != mModels.end())
+        return Handle;
+
+      error = "Invalid model handle: " + reference;
+      return C_INVALID_INDEX;
+    }
+
+  return load(reference, error);
+}
+
+void CBatchServer::close(const size_t & handle)
+{
+  std::map< size_t, CDataModel * >::iterator found = mModels.find(handle);
+
+  if (found == mModels.end()) return;
+
+  std::map< std::string, size_t >::iterator it = mFiles.begin();
+  std::map< std::string, size_t >::iterator end = mFiles.end();
+
+  for (; it != end; ++it)
+    if (it->second == handle)
+      {
+        mFiles.erase(it);
+        break;
+      }
+
+  CRootContainer::removeDatamodel(found->second);
+  mModels.erase(found);
+}
+
+bool CBatchServer::run(CDataModel * pDataModel,
+                       const std::string & taskName,
+                       std::vector< std::string >::const_iterator itOverride,
+                       std::vector< std::string >::const_iterator endOverride,
+                       std::ostream & out,
+                       std::string & error)
+{
+  CModel * pModel = pDataModel->getModel();
+  CDataVectorN< CCopasiTask > & TaskList = *pDataModel->getTaskList();
+
+  if (pModel == NULL)
+    {
+      error = "No model";
+      return false;
+    }
+
+  if (TaskList.getIndex(taskName) == C_INVALID_INDEX)
+    {
+      error = "No task '" + taskName + "'";
+      return false;
+    }
+
+  // Remember the initial state so that the overrides and any changes
+  // made by the task do not affect subsequent jobs.
+  CMathContainer & Container = pModel->getMathContainer();
+  CVector< C_FLOAT64 > InitialState = Container.getInitialState();
+
+  std::set< const CDataObject * > ChangedObjects;
+
+  for (; itOverride != endOverride; ++itOverride)
+    {
+      // The CN itself contains '=', i.e., the value follows the last one.
+      std::string::size_type Separator = itOverride->rfind('=');
+      const CDataObject * pObject = NULL;
+
+      if (Separator != std::string::npos)
+        pObject = CObjectInterface::DataObject(pDataModel->getObjectFromCN(itOverride->substr(0, Separator)));
+
+      if (pObject == NULL || !pObject->hasFlag(CDataObject::ValueDbl))
+        {
+          error = "Invalid override: " + *itOverride;
+          break;
+        }
+
+      const char * pValue = itOverride->c_str() + Separator + 1;
+      char * pEnd;
+      C_FLOAT64 Value = strtod(pValue, &pEnd);
+
+      if (*pValue == 0 || *pEnd != 0)
+        {
+          error = "Invalid value: " + *itOverride;
+          break;
+        }
+
+      *static_cast< C_FLOAT64 * >(pObject->getValuePointer()) = Value;
+      ChangedObjects.insert(pObject);
+    }
+
+  bool success = error.empty();
+
+  if (success && !ChangedObjects.empty())
+    pModel->updateInitialValues(ChangedObjects);
+
+  CCopasiTask & Task = TaskList[taskName];
+
+  if (success)
+    {
+      try
+        {
+          success = Task.initialize(CCopasiTask::OUTPUT_SE, pDataModel, &out);
+
+          if (success)
+            success &= Task.process(true);
+        }
+
+      catch (...)
+        {
+          success = false;
+        }
+
+      Task.restore();
+      pDataModel->finish();
+      out.flush();
+
+      if (!success)
+        error = "Task: " + taskName + " " + CCopasiMessage::getAllMessageText();
+    }
+
+  Container.setInitialState(InitialState);
+  Container.pushInitialState();
+
+  // The active parameter set must reflect the restored values since it is
+  // saved with the model.
+  pModel->refreshActiveParameterSet();
+
+  return success;
+}
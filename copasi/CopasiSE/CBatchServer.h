@@ -0,0 +1,153 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_CBatchServer
+#define COPASI_CBatchServer
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+class CDataModel;
+
+/**
+ * The class CBatchServer implements the persistent server mode of CopasiSE.
+ * Jobs are read line by line from an input stream, which is either stdin or a
+ * connection to a local socket. Loaded models stay compiled in memory and are
+ * reused by subsequent jobs.
+ *
+ * Each line contains a command and its arguments separated by white space.
+ * Arguments containing white space must be enclosed in double quotes.
+ *
+ *   LOAD <file>                        Load the model (or reuse the cached one)
+ *                                      and reply with its handle.
+ *   RUN <handle|file> <task> [<CN>=<value>]...
+ *                                      Run the task after overriding the given
+ *                                      initial values. The initial state of the
+ *                                      model is restored after the job.
+ *   CLOSE <handle|file>                Remove the model from the cache.
+ *   QUIT                               Close the connection.
+ *   SHUTDOWN                           Stop the server.
+ *
+ * Each response consists of any number of data chunks "DATA <size>\n" followed
+ * by <size> bytes of report output. It is terminated by a single line which is
+ * either "OK [<information>]" or "ERROR <message>". Report output is streamed
+ * to the client as it is produced.
+ */
+class CBatchServer
+{
+public:
+  /**
+   * The status after processing a command
+   */
+  enum struct Status
+  {
+    Continue,
+    Close,
+    Shutdown
+  };
+
+  /**
+   * Constructor
+   */
+  CBatchServer();
+
+  /**
+   * Destructor. All cached models are removed.
+   */
+  ~CBatchServer();
+
+  /**
+   * Process all commands read from the input stream and write the
+   * responses to the output stream.
+   * @param std::istream & in
+   * @param std::ostream & out
+   * @return CBatchServer::Status status
+   */
+  Status serve(std::istream & in, std::ostream & out);
+
+  /**
+   * Listen on the local socket with the given path and serve the connections
+   * one after another until a SHUTDOWN command is received.
+   * @param const std::string & socketPath
+   * @return int retcode
+   */
+  int listen(const std::string & socketPath);
+
+  /**
+   * Split the line into white space separated tokens. Double quotes may be
+   * used to include white space in a token.
+   * @param const std::string & line
+   * @return std::vector< std::string > tokens
+   */
+  static std::vector< std::string > tokenize(const std::string & line);
+
+private:
+  /**
+   * Process a single command line
+   * @param const std::string & line
+   * @param std::ostream & out
+   * @return CBatchServer::Status status
+   */
+  Status processLine(const std::string & line, std::ostream & out);
+
+  /**
+   * Load the model from the file unless it is already cached.
+   * @param const std::string & fileName
+   * @param std::string & error
+   * @return size_t handle (C_INVALID_INDEX on failure)
+   */
+  size_t load(const std::string & fileName, std::string & error);
+
+  /**
+   * Find the cached model for the given handle or file. Files which are not
+   * yet cached are loaded.
+   * @param const std::string & reference
+   * @param std::string & error
+   * @return size_t handle (C_INVALID_INDEX on failure)
+   */
+  size_t find(const std::string & reference, std::string & error);
+
+  /**
+   * Remove the model with the given handle from the cache
+   * @param const size_t & handle
+   */
+  void close(const size_t & handle);
+
+  /**
+   * Run the task of the given model after applying the overrides
+   * @param CDataModel * pDataModel
+   * @param const std::string & taskName
+   * @param std::vector< std::string >::const_iterator itOverride
+   * @param std::vector< std::string >::const_iterator endOverride
+   * @param std::ostream & out
+   * @param std::string & error
+   * @return bool success
+   */
+  bool run(CDataModel * pDataModel,
+           const std::string & taskName,
+           std::vector< std::string >::const_iterator itOverride,
+           std::vector< std::string >::const_iterator endOverride,
+           std::ostream & out,
+           std::string & error);
+
+  /**
+   * The cached models
+   */
+  std::map< size_t, CDataModel * > mModels;
+
+  /**
+   * Map of the normalized file names to the handles of the cached models
+   */
+  std::map< std::string, size_t > mFiles;
+
+  /**
+   * The handle assigned to the next loaded model
+   */
+  size_t mNextHandle;
+};
+
+#endif // COPASI_CBatchServer
@@ -52,6 +52,8 @@
 #include "utilities/CSparseMatrix.h"
 #include "utilities/CProcessReport.h"
 
+#include "CBatchServer.h"
+
 #define OPERATION_FAILED 1
 #define NO_EXPORT_REQUESTED 2
 
@@ -137,6 +139,28 @@ int main(int argc, char *argv[])
       goto finish;
     }
 
+  {
+    std::string Server;
+    COptions::getValue("Server", Server);
+
+    if (!Server.empty())
+      {
+        CBatchServer BatchServer;
+
+        if (Server == "-")
+          {
+            BatchServer.serve(std::cin, std::cout);
+            retcode = 0;
+          }
+        else
+          {
+            retcode = BatchServer.listen(Server);
+          }
+
+        goto finish;
+      }
+  }
+
   COptions::getValue("MaxTime", MaxTime);
 
   if (MaxTime > 0)
@@ -624,6 +648,12 @@ void writeLogo()
 
   if (NoLogo) return;
 
+  // The logo would corrupt the protocol of the batch server.
+  std::string Server;
+  COptions::getValue("Server", Server);
+
+  if (!Server.empty()) return;
+
   std::cout << "COPASI "
             << CVersion::VERSION.getVersion() << std::endl
             << "The use of this software indicates the acceptance of the attached license." << std::endl
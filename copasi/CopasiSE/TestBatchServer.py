@@ -0,0 +1,185 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+# Test of the protocol of the server mode of CopasiSE.
+#
+# Usage: python TestBatchServer.py <CopasiSE> <EventTest1.cps>
+#
+# The model contains two events, each incrementing the model value
+# 'Event Counter' once at time pi. The time course report lists the time and
+# the values of 'Event Counter', 'Time 1', and 'Time 2' for 101 steps.
+
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+COUNTER = '"CN=Root,Model=New Model,Vector=Values[Event Counter],Reference=InitialValue=%s"'
+
+failures = []
+
+
+def check(condition, message):
+  if not condition:
+    failures.append(message)
+    print('FAILED: ' + message)
+
+
+class Client:
+  def __init__(self, input, output):
+    self.input = input
+    self.output = output
+
+  def readLine(self):
+    line = self.input.readline()
+
+    if not line:
+      raise EOFError('Connection closed')
+
+    return line.decode('utf-8').rstrip('\n')
+
+  def request(self, line):
+    # Returns the status line and the concatenated data chunks
+    self.output.write((line + '\n').encode('utf-8'))
+    self.output.flush()
+
+    data = b''
+
+    while True:
+      response = self.readLine()
+
+      if not response.startswith('DATA '):
+        return response, data.decode('utf-8')
+
+      data += self.input.read(int(response[5:]))
+
+
+def rows(data):
+  # The report rows without the header
+  return [[float(value) for value in line.split('\t')] for line in data.splitlines()[1:] if line]
+
+
+def testProtocol(client, model):
+  response, data = client.request('LOAD "%s"' % model)
+  check(response == 'OK 1', 'LOAD: ' + response)
+
+  # Loading the same file again returns the cached model.
+  response, data = client.request('LOAD "%s"' % model)
+  check(response == 'OK 1', 'LOAD cached: ' + response)
+
+  response, data = client.request('RUN 1 Time-Course')
+  check(response == 'OK 1', 'RUN: ' + response)
+  Reference = rows(data)
+  check(len(Reference) == 101, 'RUN: %d rows' % len(Reference))
+  check(len(Reference) > 0 and Reference[0][1] == 0.0 and Reference[-1][1] == 2.0, 'RUN: event counter')
+
+  response, data = client.request('RUN 1 Time-Course ' + COUNTER % '10')
+  check(response == 'OK 1', 'RUN override: ' + response)
+  Result = rows(data)
+  check(len(Result) == 101, 'RUN override: %d rows' % len(Result))
+  check(len(Result) > 0 and Result[0][1] == 10.0 and Result[-1][1] == 12.0, 'RUN override: event counter')
+
+  # The override must not affect the following jobs.
+  response, data = client.request('RUN "%s" Time-Course' % model)
+  check(response == 'OK 1', 'RUN restored: ' + response)
+  check(rows(data) == Reference, 'RUN restored: result differs')
+
+  response, data = client.request('RUN 1 Time-Course ' + COUNTER % 'abc')
+  check(response.startswith('ERROR '), 'RUN invalid value: ' + response)
+
+  response, data = client.request('RUN 1 Unknown-Task')
+  check(response.startswith('ERROR '), 'RUN invalid task: ' + response)
+
+  response, data = client.request('RUN 2 Time-Course')
+  check(response.startswith('ERROR '), 'RUN invalid handle: ' + response)
+
+  response, data = client.request('INVALID')
+  check(response.startswith('ERROR '), 'INVALID: ' + response)
+
+  response, data = client.request('CLOSE 1')
+  check(response == 'OK', 'CLOSE: ' + response)
+
+  response, data = client.request('RUN 1 Time-Course')
+  check(response.startswith('ERROR '), 'RUN closed: ' + response)
+
+
+def testStdin(copasiSE, model):
+  process = subprocess.Popen([copasiSE, '--server', '-'], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+  client = Client(process.stdout, process.stdin)
+
+  testProtocol(client, model)
+
+  response, data = client.request('SHUTDOWN')
+  check(response == 'OK', 'SHUTDOWN: ' + response)
+  check(process.wait() == 0, 'SHUTDOWN: exit code')
+
+
+def testSocket(copasiSE, model):
+  if not hasattr(socket, 'AF_UNIX'):
+    return
+
+  directory = tempfile.mkdtemp()
+  path = os.path.join(directory, 'server.sock')
+  process = subprocess.Popen([copasiSE, '--server', path])
+
+  # Wait until the server listens.
+  connection = None
+
+  for i in range(100):
+    try:
+      connection = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+      connection.connect(path)
+      break
+    except socket.error:
+      connection.close()
+      connection = None
+      time.sleep(0.1)
+
+  check(connection != None, 'Socket: no connection')
+
+  if connection != None:
+    stream = connection.makefile('rwb')
+    client = Client(stream, stream)
+
+    testProtocol(client, model)
+
+    # The server accepts new connections after a client quits.
+    response, data = client.request('QUIT')
+    check(response == 'OK', 'QUIT: ' + response)
+    stream.close()
+    connection.close()
+
+    connection = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    connection.connect(path)
+    stream = connection.makefile('rwb')
+    client = Client(stream, stream)
+
+    response, data = client.request('SHUTDOWN')
+    check(response == 'OK', 'SHUTDOWN: ' + response)
+    stream.close()
+    connection.close()
+  else:
+    process.kill()
+
+  check(process.wait() == 0, 'SHUTDOWN: exit code')
+  os.rmdir(directory)
+
+
+def main(args):
+  if len(args) != 2:
+    print('Usage: python TestBatchServer.py <CopasiSE> <EventTest1.cps>')
+    return 1
+
+  testStdin(args[0], os.path.abspath(args[1]))
+  testSocket(args[0], os.path.abspath(args[1]))
+
+  return 1 if failures else 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv[1:]))
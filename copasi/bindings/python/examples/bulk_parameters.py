@@ -0,0 +1,105 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+# This example applies many sets of initial values to a model and compares the
+# time needed when the values of a set are changed individually and the
+# dependent initial values are updated with CModel::updateInitialValues with
+# the time needed by CInitialValueSetter, which compiles the update once and
+# applies all values of a set at once.
+#
+# Usage: python bulk_parameters.py <COPASI file> [number of sets]
+
+from __future__ import print_function
+import random
+import sys
+import time
+from COPASI import *
+
+
+def get_entities(model):
+  # All entities whose initial value is not determined by an expression
+  entities = []
+
+  for i in range(model.getNumCompartments()):
+    entities.append(model.getCompartment(i))
+
+  for i in range(model.getNumMetabs()):
+    entities.append(model.getMetabolite(i))
+
+  for i in range(model.getNumModelValues()):
+    entities.append(model.getModelValue(i))
+
+  return [e for e in entities
+          if e.getStatus() != CModelEntity.Status_ASSIGNMENT and e.getInitialExpression() == ""]
+
+
+def main(args):
+  if len(args) < 1 or len(args) > 2:
+    print("Usage: python bulk_parameters.py <COPASI file> [number of sets]", file=sys.stderr)
+    sys.exit(1)
+
+  count = int(args[1]) if len(args) == 2 else 1000
+
+  dataModel = CRootContainer.addDatamodel()
+
+  if not dataModel.loadModel(args[0]):
+    print("Error while loading the model:", CCopasiMessage.getAllMessageText(), file=sys.stderr)
+    sys.exit(1)
+
+  model = dataModel.getModel()
+  entities = get_entities(model)
+  original = [e.getInitialValue() for e in entities]
+
+  random.seed(1)
+  sets = [[v * random.uniform(0.5, 2.0) for v in original] for i in range(count)]
+
+  # Each value is changed individually and the dependent initial values of
+  # all changed objects are updated once per set.
+  changedObjects = ObjectStdVector()
+
+  for entity in entities:
+    changedObjects.push_back(entity.getInitialValueReference())
+
+  start = time.time()
+
+  for values in sets:
+    for entity, value in zip(entities, values):
+      entity.setInitialValue(value)
+
+    model.updateInitialValues(changedObjects)
+
+  individual = time.time() - start
+
+  # All values of a set are applied at once.
+  setter = CInitialValueSetter(model)
+
+  if not setter.compileTargets([e.getInitialValueReference().getCN().getString() for e in entities]):
+    print("Error while compiling the targets:", CCopasiMessage.getAllMessageText(), file=sys.stderr)
+    sys.exit(1)
+
+  start = time.time()
+
+  for values in sets:
+    setter.applyValues(values)
+
+  bulk = time.time() - start
+
+  print("targets:", setter.size(), "sets:", count)
+  print("updateInitialValues: %.3f s, CInitialValueSetter: %.3f s" % (individual, bulk))
+
+  setter.applyValues(original)
+
+  # The active parameter set can be applied in the same way.
+  parameterSet = model.getActiveModelParameterSet()
+
+  if setter.compile(parameterSet):
+    setter.apply(parameterSet)
+
+  CRootContainer.removeDatamodel(dataModel)
+
+
+if __name__ == '__main__':
+  main(sys.argv[1:])
@@ -0,0 +1,75 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+# This example measures the time needed to compile a model while reactions
+# are added one at a time. A linear chain of species is created first, then
+# additional reactions between existing species are added and the model is
+# compiled after each addition.
+#
+# Only the factorization of the stoichiometry matrix is reused between the
+# compiles, the math container is compiled completely each time.
+#
+# Usage: python incremental_compile.py [number of species]
+
+from __future__ import print_function
+import sys
+import time
+from COPASI import *
+
+
+def add_reaction(model, name, substrate, product):
+  reaction = model.createReaction(name)
+  chemEq = reaction.getChemEq()
+  chemEq.addMetabolite(substrate.getKey(), 1.0, CChemEq.SUBSTRATE)
+  chemEq.addMetabolite(product.getKey(), 1.0, CChemEq.PRODUCT)
+  reaction.setReversible(False)
+  reaction.setFunction("Mass action (irreversible)")
+  return reaction
+
+
+def main(args):
+  n = 100
+
+  if len(args) > 0:
+    n = int(args[0])
+
+  dataModel = CRootContainer.addDatamodel()
+  model = dataModel.getModel()
+  compartment = model.createCompartment("cell", 1.0)
+
+  species = []
+
+  for i in range(n):
+    species.append(model.createMetabolite("S%d" % i, compartment.getObjectName(), 1.0, CModelEntity.Status_REACTIONS))
+
+  for i in range(n - 1):
+    add_reaction(model, "chain%d" % i, species[i], species[i + 1])
+
+  start = time.time()
+  model.compileIfNecessary()
+  initial = time.time() - start
+
+  # Reactions between existing species do not change the conserved total,
+  # i.e., the structural analysis of the previous compile remains valid.
+  start = time.time()
+
+  for i in range(n):
+    add_reaction(model, "shortcut%d" % i, species[(7 * i) % n], species[(7 * i + 3) % n])
+    model.compileIfNecessary()
+
+  incremental = time.time() - start
+
+  print("species:                       %d" % n)
+  print("initial compile:               %.3f s" % initial)
+  print("%d incremental compiles:       %.3f s (%.3f s per compile)" % (n, incremental, incremental / n))
+  print("independent species:           %d" % model.getNumIndependentReactionMetabs())
+  print("dependent species:             %d" % model.getNumDependentReactionMetabs())
+
+  CRootContainer.removeDatamodel(dataModel)
+
+
+if __name__ == '__main__':
+  main(sys.argv[1:])
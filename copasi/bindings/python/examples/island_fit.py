@@ -0,0 +1,98 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+# This example runs the parameter estimation of a model as an island model.
+# A copy of the model is created for each island and all islands are started
+# as independent CopasiSE processes sharing one island directory. Every
+# "Migration Interval" generations each island publishes its best individuals
+# in the directory and adopts the ones of its neighbors. The directory may be
+# located on a file system shared by the nodes of a cluster, in which case the
+# generated model files can be submitted as separate jobs.
+#
+# Usage: python island_fit.py <model file> [number of islands] [GA|SRES] [island directory] [CopasiSE]
+
+from __future__ import print_function
+import os
+import subprocess
+import sys
+import tempfile
+from COPASI import *
+
+
+def create_island(file_name, island_directory, method_type, index, islands):
+  dataModel = CRootContainer.addDatamodel()
+
+  if not dataModel.loadModel(file_name):
+    print("Error while loading the model %s" % file_name, file=sys.stderr)
+    sys.exit(1)
+
+  for i in range(dataModel.getNumTasks()):
+    dataModel.getTask(i).setScheduled(False)
+
+  fitTask = dataModel.getTask("Parameter Estimation")
+  fitTask.setMethodType(method_type)
+  fitTask.setScheduled(True)
+
+  fitMethod = fitTask.getMethod()
+  fitMethod.getParameter("Island Directory").setStringValue(island_directory)
+  fitMethod.getParameter("Island Index").setUIntValue(index)
+  fitMethod.getParameter("Number of Islands").setUIntValue(islands)
+
+  island_file = os.path.join(island_directory, "island_%d.cps" % index)
+  dataModel.saveModel(island_file, True)
+  CRootContainer.removeDatamodel(dataModel)
+
+  return island_file
+
+
+def best_value(island_directory, index):
+  # The first individual published by an island is its best one.
+  try:
+    with open(os.path.join(island_directory, "island_%d.txt" % index)) as f:
+      f.readline()
+      return float(f.readline().split()[0])
+  except (IOError, IndexError, ValueError):
+    return None
+
+
+def main(args):
+  if len(args) < 1:
+    print("Usage: python island_fit.py <model file> [number of islands] [GA|SRES] [island directory] [CopasiSE]", file=sys.stderr)
+    sys.exit(1)
+
+  file_name = os.path.abspath(args[0])
+  islands = int(args[1]) if len(args) > 1 else 4
+  method_type = CTaskEnum.Method_SRES if len(args) > 2 and args[2] == "SRES" else CTaskEnum.Method_GeneticAlgorithm
+  island_directory = os.path.abspath(args[3]) if len(args) > 3 else tempfile.mkdtemp(prefix="islands_")
+  copasi_se = args[4] if len(args) > 4 else "CopasiSE"
+
+  if not os.path.isdir(island_directory):
+    os.makedirs(island_directory)
+
+  processes = []
+
+  for index in range(islands):
+    island_file = create_island(file_name, island_directory, method_type, index, islands)
+    processes.append(subprocess.Popen([copasi_se, island_file]))
+
+  failed = 0
+
+  for process in processes:
+    if process.wait() != 0:
+      failed += 1
+
+  print("island directory: %s" % island_directory)
+
+  for index in range(islands):
+    print("island %d: last published best value %s" % (index, best_value(island_directory, index)))
+
+  if failed > 0:
+    print("%d islands failed" % failed, file=sys.stderr)
+    sys.exit(1)
+
+
+if __name__ == '__main__':
+  main(sys.argv[1:])
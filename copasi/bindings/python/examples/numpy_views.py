@@ -0,0 +1,71 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+# This example runs a time course and accesses the results as numpy arrays
+# instead of retrieving each value individually. The arrays returned by
+# getNumpyArray and getNumpyBlocks share the memory of the COPASI objects
+# where possible. They must not be used after the owning object has been
+# changed, e.g., after the task was run again or the data model was deleted.
+#
+# Usage: python numpy_views.py <COPASI file>
+
+from __future__ import print_function
+import sys
+import numpy
+from COPASI import *
+
+
+def main(args):
+  if len(args) != 1:
+    print("Usage: python numpy_views.py <COPASI file>", file=sys.stderr)
+    sys.exit(1)
+
+  dataModel = CRootContainer.addDatamodel()
+
+  if not dataModel.loadModel(args[0]):
+    print("Error while loading the model:", CCopasiMessage.getAllMessageText(), file=sys.stderr)
+    sys.exit(1)
+
+  model = dataModel.getModel()
+  container = model.getMathContainer()
+
+  # The initial state is a view, we keep a copy to restore it later.
+  initialState = container.getInitialState().getNumpyArray().copy()
+
+  trajectoryTask = dataModel.getTask("Time-Course")
+  trajectoryTask.setScheduled(True)
+
+  if not trajectoryTask.process(True):
+    print("Error while running the time course:", CCopasiMessage.getAllMessageText(), file=sys.stderr)
+    sys.exit(1)
+
+  timeSeries = trajectoryTask.getTimeSeries()
+
+  # The recorded blocks are shared with the time series without copying.
+  blocks = timeSeries.getNumpyBlocks()
+  print("recorded steps:", sum(block.shape[0] for block in blocks), "in", len(blocks), "block(s)")
+
+  # All variables ordered like the titles, species in concentrations
+  data = timeSeries.getNumpyArray(True)
+  titles = timeSeries.getTitles()
+
+  for i in range(len(titles)):
+    print(titles[i], "min:", numpy.min(data[:, i]), "max:", numpy.max(data[:, i]))
+
+  # The jacobian is a FloatMatrix which is shared as well.
+  jacobian = FloatMatrix()
+  container.calculateJacobian(jacobian, 1e-12, True)
+  print("eigenvalues of the reduced jacobian:", numpy.linalg.eigvals(jacobian.getNumpyArray()))
+
+  # Restore the initial state in bulk and push it to the model.
+  container.getInitialState().setNumpyArray(initialState)
+  container.pushInitialState()
+
+  CRootContainer.removeDatamodel(dataModel)
+
+
+if __name__ == '__main__':
+  main(sys.argv[1:])
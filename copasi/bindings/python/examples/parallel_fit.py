@@ -0,0 +1,82 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+# This example measures how the Levenberg-Marquardt parameter estimation
+# scales with the number of threads evaluating the columns of the Jacobian.
+# COPASI must be configured with ENABLE_OMP. The fit is run in a separate
+# process for each thread count since the OpenMP runtime reads
+# OMP_NUM_THREADS only once.
+#
+# Usage: python parallel_fit.py [model file] [maximal number of threads]
+#
+# The default model is TestSuite/fitting/LM-test1.cps.
+
+from __future__ import print_function
+import os
+import subprocess
+import sys
+import time
+from COPASI import *
+
+
+def run_fit(file_name):
+  dataModel = CRootContainer.addDatamodel()
+
+  if not dataModel.loadModel(file_name):
+    print("Error while loading the model %s" % file_name, file=sys.stderr)
+    sys.exit(1)
+
+  fitTask = dataModel.getTask("Parameter Estimation")
+  fitTask.setMethodType(CTaskEnum.Method_LevenbergMarquardt)
+  fitProblem = fitTask.getProblem()
+
+  start = time.time()
+
+  if not fitTask.process(True):
+    print("Error while running the fit: %s" % CCopasiMessage.getAllMessageText(), file=sys.stderr)
+    sys.exit(1)
+
+  print("%.3f %d %.6g" % (time.time() - start,
+                          fitProblem.getFunctionEvaluations(),
+                          fitProblem.getSolutionValue()))
+
+  CRootContainer.removeDatamodel(dataModel)
+
+
+def main(args):
+  if len(args) > 1 and args[0] == "--run":
+    run_fit(args[1])
+    return
+
+  file_name = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           "..", "..", "..", "..", "TestSuite", "fitting", "LM-test1.cps")
+  max_threads = 4
+
+  if len(args) > 0:
+    file_name = args[0]
+
+  if len(args) > 1:
+    max_threads = int(args[1])
+
+  print("threads    time [s]   speedup   evaluations   objective")
+  reference = None
+
+  for threads in range(1, max_threads + 1):
+    env = dict(os.environ)
+    env["OMP_NUM_THREADS"] = str(threads)
+
+    output = subprocess.check_output([sys.executable, os.path.abspath(__file__), "--run", file_name], env=env)
+    elapsed, evaluations, objective = output.decode().split()
+    elapsed = float(elapsed)
+
+    if reference is None:
+      reference = elapsed
+
+    print("%7d %11.3f %9.2f %13s %11s" % (threads, elapsed, reference / elapsed, evaluations, objective))
+
+
+if __name__ == '__main__':
+  main(sys.argv[1:])
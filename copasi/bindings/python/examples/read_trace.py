@@ -0,0 +1,64 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+# This example reads the binary evaluation trace written by an optimization or
+# parameter estimation when the problem parameter "Evaluation Trace File" is set
+# and prints it as tab separated text.
+#
+# Usage: python read_trace.py <trace file>
+
+from __future__ import print_function
+import struct
+import sys
+
+STATUS = ["success", "cached", "exception", "NaN", "terminated"]
+
+
+def read_trace(file_name):
+  with open(file_name, "rb") as f:
+    if f.read(8) != b"COPASIOT":
+      raise ValueError("%s is not an evaluation trace" % file_name)
+
+    # The byte order mark tells us the byte order of the writer.
+    order = "<" if struct.unpack("<I", f.read(8)[4:])[0] == 0x01020304 else ">"
+    count = struct.unpack(order + "I", f.read(4))[0]
+
+    names = []
+
+    for i in range(count):
+      length = struct.unpack(order + "I", f.read(4))[0]
+      names.append(f.read(length).decode("utf-8"))
+
+    record = struct.Struct(order + "QqqdII" + "d" * count)
+    records = []
+
+    while True:
+      data = f.read(record.size)
+
+      if len(data) < record.size:
+        break
+
+      records.append(record.unpack(data))
+
+  return names, records
+
+
+def main(args):
+  if len(args) != 1:
+    print("Usage: python read_trace.py <trace file>", file=sys.stderr)
+    sys.exit(1)
+
+  names, records = read_trace(args[0])
+
+  print("\t".join(["evaluation", "start [s]", "duration [s]", "value", "status", "thread"] + names))
+
+  for r in records:
+    status = STATUS[r[4]] if r[4] < len(STATUS) else str(r[4])
+    print("\t".join([str(r[0]), str(r[1] * 1e-6), str(r[2] * 1e-6), repr(r[3]), status, str(r[5])] + [repr(v) for v in r[6:]]))
+
+
+if __name__ == '__main__':
+  main(sys.argv[1:])
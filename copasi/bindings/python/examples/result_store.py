@@ -0,0 +1,106 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+# This example runs repeated stochastic time courses through a scan and records
+# the concentrations of all species in an indexed binary result store. Each
+# repeat is a run in the store. The runs are read back with CResultStoreReader
+# and, if numpy is available, a single run is mapped into memory directly
+# using the index of the file.
+#
+# Usage: python result_store.py <COPASI file> <result file>
+
+from __future__ import print_function
+import struct
+import sys
+from COPASI import *
+
+
+def record(file_name, result_name):
+  dataModel = CRootContainer.addDatamodel()
+
+  if not dataModel.loadModel(file_name):
+    print("Error while loading the model:", CCopasiMessage.getAllMessageText(), file=sys.stderr)
+    sys.exit(1)
+
+  model = dataModel.getModel()
+
+  store = CResultStore()
+  store.setFileName(result_name)
+  store.addObject(CRegisteredCommonName(model.getCN().getString() + ",Reference=Time"))
+
+  for i in range(model.getMetabolites().size()):
+    store.addObject(CRegisteredCommonName(model.getMetabolite(i).getObject(CCommonName("Reference=Concentration")).getCN().getString()))
+
+  trajectoryTask = dataModel.getTask("Time-Course")
+  trajectoryTask.setScheduled(False)
+  trajectoryTask.setMethodType(CTaskEnum.Method_stochastic)
+
+  scanTask = dataModel.getTask("Scan")
+  scanTask.setScheduled(True)
+  scanProblem = scanTask.getProblem()
+  scanProblem.setSubtask(CTaskEnum.Task_timeCourse)
+  scanProblem.addScanItem(CScanProblem.SCAN_REPEAT, 10)
+  scanProblem.setOutputInSubtask(True)
+  scanProblem.setContinueFromCurrentState(False)
+
+  # The store receives the output of all tasks run with this data model.
+  dataModel.addInterface(store)
+
+  try:
+    if not scanTask.process(True):
+      print("Error while running the scan:", CCopasiMessage.getAllMessageText(), file=sys.stderr)
+      sys.exit(1)
+  finally:
+    dataModel.removeInterface(store)
+    store.close()
+
+  CRootContainer.removeDatamodel(dataModel)
+
+
+def map_run(result_name, run):
+  # Map all chunks of a run as arrays of shape (datasets, steps) without copying.
+  import numpy
+
+  with open(result_name, "rb") as f:
+    header = f.read(32)
+    index_offset, count = struct.unpack("=QI", header[16:28])
+    f.seek(index_offset)
+    chunk_count = struct.unpack("=Q", f.read(8))[0]
+    chunks = [struct.unpack("=QQQQ", f.read(32)) for i in range(chunk_count)]
+
+  return [numpy.memmap(result_name, dtype=numpy.float64, mode="r", offset=offset, shape=(count, steps))
+          for (r, first, steps, offset) in chunks if r == run]
+
+
+def main(args):
+  if len(args) != 2:
+    print("Usage: python result_store.py <COPASI file> <result file>", file=sys.stderr)
+    sys.exit(1)
+
+  record(args[0], args[1])
+
+  reader = CResultStoreReader()
+
+  if not reader.open(args[1]):
+    print("Error while reading the results.", file=sys.stderr)
+    sys.exit(1)
+
+  print("datasets:", reader.getDatasetCount(), "runs:", reader.getRunCount())
+
+  for run in range(reader.getRunCount()):
+    # The last recorded value of each dataset in this run
+    last = reader.getStepCount(run) - 1
+    print(run, [reader.getValue(run, last, i) for i in range(reader.getDatasetCount())])
+
+  try:
+    chunks = map_run(args[1], 0)
+    print("run 0 mapped in", len(chunks), "chunk(s)")
+  except ImportError:
+    pass
+
+
+if __name__ == '__main__':
+  main(sys.argv[1:])
@@ -508,4 +508,141 @@ TextGlyphVector.__iter__ = __add_iterator
 VectorOfStringVectors.__iter__ = __add_iterator
 
 
+%}
+
+%pythoncode
+%{
+
+class _NumpyBuffer(object):
+    """Exposes the memory at an address through the NumPy array interface.
+    The buffer is the base of all arrays sharing the memory and holds a
+    reference to the owner of the memory.
+    """
+
+    def __init__(self, owner, address, shape, writeable):
+        import numpy
+        self.owner = owner
+        self.__array_interface__ = {
+            'version': 3,
+            'shape': tuple(shape),
+            'typestr': numpy.dtype(numpy.float64).str,
+            'data': (address, not writeable)
+        }
+
+def _getNumpyView(owner, address, shape, writeable=True):
+    """Returns a NumPy array sharing the memory at the given address.
+
+    The array holds a reference to the owner and through it to the objects
+    the owner was retrieved from (see _returnsPart). Thus an owner created in
+    Python, e.g., a FloatMatrix or a copy of a CMathContainer, stays alive as
+    long as the array exists. Objects owned by a data model are deleted with
+    the data model regardless of any array. In any case the array is only
+    valid as long as the memory is not reallocated, e.g., by resizing or
+    compiling the owner or by running the task again.
+    Copy the array if its values are needed beyond that.
+    """
+    import numpy
+    count = 1
+    for n in shape:
+        count *= n
+    if count == 0:
+        return numpy.zeros(shape)
+    if address == 0:
+        return None
+    return numpy.asarray(_NumpyBuffer(owner, address, shape, writeable))
+
+def _returnsPart(method):
+    """Wraps a method returning a part of the object, e.g., a vector stored in
+    it, so that the returned proxy holds a reference to the object.
+    """
+    def wrapper(self, *args):
+        result = method(self, *args)
+        if result is not None:
+            result._parent = self
+        return result
+    wrapper.__doc__ = method.__doc__
+    return wrapper
+
+CMathContainer.getInitialState = _returnsPart(CMathContainer.getInitialState)
+CMathContainer.getState = _returnsPart(CMathContainer.getState)
+CModel.getMathContainer = _returnsPart(CModel.getMathContainer)
+CTrajectoryTask.getTimeSeries = _returnsPart(CTrajectoryTask.getTimeSeries)
+
+def _getVectorNumpyArray(self):
+    """Returns a NumPy array sharing the memory of the vector.
+    Values assigned to the array are directly set in the vector, i.e., this can
+    be used to set parameter vectors or the initial state of a CMathContainer
+    in bulk. See _getNumpyView for the lifetime of the array.
+    """
+    return _getNumpyView(self, self.getArrayAddress(), (self.size(),))
+
+def _getMatrixNumpyArray(self):
+    """Returns a NumPy array with shape (numRows, numCols) sharing the memory
+    of the matrix. See _getNumpyView for the lifetime of the array.
+    """
+    return _getNumpyView(self, self.getArrayAddress(), (self.numRows(), self.numCols()))
+
+def _setNumpyArray(self, values):
+    """Sets all values from an array or sequence with matching shape.
+    """
+    import numpy
+    view = self.getNumpyArray()
+    view[...] = numpy.asarray(values, dtype=numpy.float64).reshape(view.shape)
+
+FloatVectorCore.getNumpyArray = _getVectorNumpyArray
+FloatVectorCore.setNumpyArray = _setNumpyArray
+FloatMatrix.getNumpyArray = _getMatrixNumpyArray
+FloatMatrix.setNumpyArray = _setNumpyArray
+
+def _getDataArrayNumpyArray(self):
+    """Returns a read only NumPy array sharing the memory of the array.
+    None is returned if the values are not stored contiguously, e.g., for the
+    link matrix. See _getNumpyView for the lifetime of the array.
+    """
+    shape = tuple(self.getArraySize(d) for d in range(self.dimensionality()))
+    return _getNumpyView(self, self.getArrayAddress(), shape, False)
+
+CDataArray.getNumpyArray = _getDataArrayNumpyArray
+
+def _getTimeSeriesNumpyBlocks(self):
+    """Returns the recorded steps as a list of read only NumPy arrays sharing
+    the memory of the time series. Each array has the shape
+    (steps, getColumnCount()) and its columns are the stored columns, i.e.,
+    use getColumn(variable) to find the column of a variable.
+    The arrays are valid until the time series is compiled again, i.e., the
+    task is run again, or cleared.
+    """
+    result = []
+    for block in range(0, self.getBlockCount()):
+        steps = self.getBlockSteps(block)
+        if steps > 0:
+            result.append(_getNumpyView(self, self.getBlockAddress(block), (steps, self.getColumnCount()), False))
+    return result
+
+def _getTimeSeriesNumpyArray(self, concentrations=False):
+    """Returns all recorded data as a NumPy array with the shape
+    (getRecordedSteps(), getNumVariables()) where the columns are ordered
+    like the titles. Species are reported in particle numbers or, if
+    concentrations is True, in concentrations.
+    The result is a copy, use getNumpyBlocks to access the recorded
+    values without copying.
+    """
+    import numpy
+    blocks = self.getNumpyBlocks()
+    count = self.getNumVariables()
+    if len(blocks) == 0 or count == 0:
+        return numpy.zeros((self.getRecordedSteps(), count))
+    data = blocks[0] if len(blocks) == 1 else numpy.concatenate(blocks)
+    columns = numpy.array([self.getColumn(v) for v in range(0, count)], dtype=numpy.intp)
+    result = data[:, columns]
+    if concentrations:
+        species = [v for v in range(0, count) if self.getCompartmentColumn(v) < self.getColumnCount()]
+        if len(species) > 0:
+            compartments = numpy.array([self.getCompartmentColumn(v) for v in species], dtype=numpy.intp)
+            result[:, species] *= self.getNumberToQuantityFactor() / data[:, compartments]
+    return result
+
+CTimeSeries.getNumpyBlocks = _getTimeSeriesNumpyBlocks
+CTimeSeries.getNumpyArray = _getTimeSeriesNumpyArray
+
 %}
@@ -106,6 +106,26 @@ class Test_CDataModel(unittest.TestCase):
     self.assert_(type(fileName)==StringType)
     self.assert_(fileName.endswith(SBML_FILE))
 
+  def test_getObjectAfterRename(self):
+    model=self.datamodel.getModel()
+    comp=model.createCompartment("comp1")
+    metab=model.createMetabolite("A","comp1")
+    cn=metab.getCN()
+    self.assert_(self.datamodel.getObject(cn)!=None)
+    # the indexed lookup must not return renamed objects under their old name
+    self.assert_(metab.setObjectName("B"))
+    self.assert_(self.datamodel.getObject(cn)==None)
+    self.assert_(self.datamodel.getObject(metab.getCN()).getCN().getString()==metab.getCN().getString())
+    # renaming the compartment changes the common names of its species
+    cn=metab.getCN()
+    self.assert_(comp.setObjectName("comp2"))
+    self.assert_(self.datamodel.getObject(cn)==None)
+    self.assert_(self.datamodel.getObject(metab.getCN()).getCN().getString()==metab.getCN().getString())
+    # removed objects are no longer found
+    cn=metab.getCN().getString()
+    model.removeMetabolite(metab.getKey())
+    self.assert_(self.datamodel.getObject(COPASI.CCommonName(cn))==None)
+
   def CHECK_CALCIUM_JUERGEN(self):
     # check the model
     self.CHECK_CALCIUM_JUERGEN_MODEL()
@@ -137,6 +157,7 @@ def suite():
          ,'test_addDefaultReports'
          ,'test_getFileName'
          ,'test_getSBMLFileName'
+         ,'test_getObjectAfterRename'
         ]
   return unittest.TestSuite(map(Test_CDataModel,tests))
 
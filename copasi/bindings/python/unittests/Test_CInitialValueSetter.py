@@ -0,0 +1,96 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+import COPASI
+import unittest
+import Test_CreateSimpleModel
+
+class Test_CInitialValueSetter(unittest.TestCase):
+  def setUp(self):
+    self.datamodel=Test_CreateSimpleModel.createModel()
+    self.model=self.datamodel.getModel()
+    self.compartment=self.model.getCompartment(0)
+    self.metab=self.model.getMetabolite(0)
+    self.k=self.model.createModelValue("k")
+    self.k.setInitialValue(2.0)
+    # the initial value of d depends on the initial value of k
+    self.d=self.model.createModelValue("d")
+    self.d.setInitialExpression("<"+self.k.getInitialValueReference().getCN().getString()+">*2")
+    self.model.compileIfNecessary()
+    self.setter=COPASI.CInitialValueSetter(self.model)
+
+  def tearDown(self):
+    COPASI.CRootContainer.removeDatamodel(self.datamodel)
+
+  def particleNumber(self,concentration,volume):
+    return concentration*volume*self.model.getQuantity2NumberFactor()
+
+  def assertClose(self,value,expected):
+    self.assert_(abs(value-expected)<=1e-12*abs(expected))
+
+  def test_applyValues(self):
+    targets=[
+              self.compartment.getInitialValueReference().getCN().getString()
+             ,self.metab.getObject(COPASI.CCommonName("Reference=InitialConcentration")).getCN().getString()
+             ,self.k.getInitialValueReference().getCN().getString()
+            ]
+    self.assert_(self.setter.compileTargets(targets))
+    self.assert_(self.setter.size()==3)
+    self.assert_(self.setter.getTarget(1)==targets[1])
+    self.assert_(self.setter.applyValues([2.0,1.0e-4,3.0]))
+    self.assertClose(self.compartment.getInitialValue(),2.0)
+    self.assertClose(self.metab.getInitialConcentration(),1.0e-4)
+    # the particle number is calculated from the concentration and the new volume
+    self.assertClose(self.metab.getInitialValue(),self.particleNumber(1.0e-4,2.0))
+    self.assertClose(self.k.getInitialValue(),3.0)
+    self.assertClose(self.d.getInitialValue(),6.0)
+    # the number of values must match the number of targets
+    self.assert_(not self.setter.applyValues([1.0,2.0]))
+    self.assertClose(self.k.getInitialValue(),3.0)
+
+  def test_applyParticleNumber(self):
+    targets=[self.metab.getInitialValueReference().getCN().getString()]
+    self.assert_(self.setter.compileTargets(targets))
+    volume=self.compartment.getInitialValue()
+    number=self.particleNumber(5.0e-5,volume)
+    self.assert_(self.setter.applyValues([number]))
+    # the concentration is calculated from the particle number
+    self.assertClose(self.metab.getInitialValue(),number)
+    self.assertClose(self.metab.getInitialConcentration(),5.0e-5)
+
+  def test_invalidTarget(self):
+    # initial values determined by an expression cannot be set
+    targets=[self.d.getInitialValueReference().getCN().getString()]
+    self.assert_(not self.setter.compileTargets(targets))
+    self.assert_(self.setter.size()==0)
+
+  def test_applyParameterSet(self):
+    parameterSet=self.model.getActiveModelParameterSet()
+    self.assert_(self.setter.compile(parameterSet))
+    self.assert_(self.setter.size()>0)
+    # parameters with an initial expression are not targets
+    for i in range(self.setter.size()):
+      self.assert_(self.setter.getTarget(i)!=self.d.getInitialValueReference().getCN().getString())
+    parameterSet.getModelParameter(self.metab.getCN().getString()).setValue(3.0e-4)
+    parameterSet.getModelParameter(self.k.getCN().getString()).setValue(5.0)
+    self.assert_(self.setter.apply(parameterSet))
+    volume=self.compartment.getInitialValue()
+    self.assertClose(self.metab.getInitialConcentration(),3.0e-4)
+    self.assertClose(self.metab.getInitialValue(),self.particleNumber(3.0e-4,volume))
+    self.assertClose(self.k.getInitialValue(),5.0)
+    self.assertClose(self.d.getInitialValue(),10.0)
+
+def suite():
+  tests=[
+          'test_applyValues'
+         ,'test_applyParticleNumber'
+         ,'test_invalidTarget'
+         ,'test_applyParameterSet'
+        ]
+  return unittest.TestSuite(map(Test_CInitialValueSetter,tests))
+
+if(__name__ == '__main__'):
+    unittest.TextTestRunner(verbosity=2).run(suite())
@@ -0,0 +1,126 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+import COPASI
+import unittest
+import os
+import shutil
+import tempfile
+import Test_CreateSimpleModel
+
+class Test_COutputInterval(unittest.TestCase):
+  def setUp(self):
+    self.datamodel=Test_CreateSimpleModel.createModel()
+    self.model=self.datamodel.getModel()
+    self.directory=tempfile.mkdtemp()
+    self.fileName=os.path.join(self.directory,'report.txt')
+    self.trajectoryTask=self.datamodel.getTask("Time-Course")
+    problem=self.trajectoryTask.getProblem()
+    problem.getParameter("StepNumber").setValue(100)
+    problem.getParameter("StepSize").setValue(0.1)
+    problem.getParameter("Duration").setValue(10.0)
+    problem.getParameter("TimeSeriesRequested").setValue(False)
+    self.reportDefinition=self.datamodel.getReportDefinitionList().createReportDefinition("Interval","Time only")
+    self.reportDefinition.setTaskType(COPASI.CTaskEnum.Task_timeCourse)
+    self.reportDefinition.setIsTable(False)
+    self.reportDefinition.getBodyAddr().push_back(COPASI.CRegisteredCommonName(self.model.getCN().getString()+",Reference=Time"))
+
+  def tearDown(self):
+    shutil.rmtree(self.directory)
+    COPASI.CRootContainer.removeDatamodel(self.datamodel)
+
+  def runReport(self,task):
+    report=task.getReport()
+    report.setReportDefinition(self.reportDefinition)
+    report.setTarget(self.fileName)
+    report.setAppend(False)
+    self.assert_(task.process(True))
+    f=open(self.fileName,'r')
+    lines=f.read().splitlines()
+    f.close()
+    # runs are separated by empty lines
+    runs=[[]]
+    for line in lines:
+      if line=='':
+        runs.append([])
+      else:
+        runs[-1].append(float(line))
+    return [run for run in runs if len(run)!=0]
+
+  def test_saveAndLoad(self):
+    self.reportDefinition.setOutputInterval(0.5)
+    plotList=self.datamodel.getPlotDefinitionList()
+    plot=plotList.createPlotSpec("Interval",COPASI.CPlotItem.plot2d)
+    self.assert_(plot.getOutputInterval()==0.0)
+    plot.setOutputInterval(2.5)
+    fileName=os.path.join(self.directory,'model.cps')
+    self.assert_(self.datamodel.saveModel(fileName,True))
+    datamodel=COPASI.CRootContainer.addDatamodel()
+    try:
+      self.assert_(datamodel.loadModel(fileName))
+      reportList=datamodel.getReportDefinitionList()
+      reportDefinition=reportList.get(reportList.getIndexByName("Interval"))
+      self.assert_(reportDefinition.getOutputInterval()==0.5)
+      # report definitions without an interval output every step
+      for i in range(reportList.size()):
+        if i!=reportList.getIndexByName("Interval"):
+          self.assert_(reportList.get(i).getOutputInterval()==0.0)
+      plotList=datamodel.getPlotDefinitionList()
+      plot=plotList.get(plotList.getIndexByName("Interval"))
+      self.assert_(plot.getOutputInterval()==2.5)
+    finally:
+      COPASI.CRootContainer.removeDatamodel(datamodel)
+
+  def test_everyStep(self):
+    runs=self.runReport(self.trajectoryTask)
+    self.assert_(len(runs)==1)
+    self.assert_(len(runs[0])==101)
+
+  def test_interval(self):
+    self.reportDefinition.setOutputInterval(1.0)
+    runs=self.runReport(self.trajectoryTask)
+    self.assert_(len(runs)==1)
+    times=runs[0]
+    # the first step is always output
+    self.assert_(times[0]==0.0)
+    self.assert_(len(times)>=10 and len(times)<=11)
+    for i in range(1,len(times)):
+      # the next output is at the first step at least one interval later
+      self.assert_(times[i]-times[i-1]>=1.0-1e-9)
+      self.assert_(times[i]-times[i-1]<=1.1+1e-9)
+
+  def test_separatorForcesOutput(self):
+    # The repeats continue in time, i.e., only the separator forces the
+    # output at the start of each repeat.
+    self.reportDefinition.setOutputInterval(3.0)
+    self.trajectoryTask.setScheduled(False)
+    problem=self.trajectoryTask.getProblem()
+    problem.getParameter("StepNumber").setValue(20)
+    problem.getParameter("Duration").setValue(2.0)
+    scanTask=self.datamodel.getTask("Scan")
+    scanProblem=scanTask.getProblem()
+    scanProblem.setSubtask(COPASI.CTaskEnum.Task_timeCourse)
+    scanProblem.addScanItem(COPASI.CScanProblem.SCAN_REPEAT,3)
+    scanProblem.setOutputInSubtask(True)
+    scanProblem.setContinueFromCurrentState(True)
+    runs=self.runReport(scanTask)
+    self.assert_(len(runs)==3)
+    for run in range(3):
+      # the interval is longer than a repeat, i.e., the separator resets it
+      self.assert_(len(runs[run])==1)
+      self.assert_(abs(runs[run][0]-2.0*run)<1e-9)
+
+def suite():
+  tests=[
+          'test_saveAndLoad'
+         ,'test_everyStep'
+         ,'test_interval'
+         ,'test_separatorForcesOutput'
+        ]
+  return unittest.TestSuite(map(Test_COutputInterval,tests))
+
+if(__name__ == '__main__'):
+    unittest.TextTestRunner(verbosity=2).run(suite())
@@ -0,0 +1,62 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+import COPASI
+import unittest
+
+MASK=0xffffffff
+
+def philox4x32_10(counter,key):
+  # Reference implementation of Philox4x32-10 (Salmon et al., SC11)
+  c=list(counter)
+  k=list(key)
+  for round in range(10):
+    p0=0xD2511F53*c[0]
+    p1=0xCD9E8D57*c[2]
+    c=[((p1>>32)^c[1]^k[0])&MASK,p1&MASK,((p0>>32)^c[3]^k[1])&MASK,p0&MASK]
+    k=[(k[0]+0x9E3779B9)&MASK,(k[1]+0xBB67AE85)&MASK]
+  return c
+
+def philoxSequence(seed,size):
+  values=[]
+  counter=0
+  while len(values)<size:
+    values+=philox4x32_10([counter&MASK,(counter>>32)&MASK,0,0],[seed,0])
+    counter+=1
+  return values[:size]
+
+class Test_CRandom(unittest.TestCase):
+  def test_philox4x32Reference(self):
+    # Known answer vectors of the Random123 distribution
+    self.assert_(philox4x32_10([0,0,0,0],[0,0])==[0x6627e8d5,0xe169c58d,0xbc57ac4c,0x9b00dbd8])
+    self.assert_(philox4x32_10([MASK,MASK,MASK,MASK],[MASK,MASK])==[0x408f276d,0x41c83b0e,0xa20bc7c6,0x6d5451fd])
+    self.assert_(philox4x32_10([0x243f6a88,0x85a308d3,0x13198a2e,0x03707344],[0xa4093822,0x299f31d0])==[0xd16cfe09,0x94fdcceb,0x5001e420,0x24126ea1])
+
+  def test_philox4x32KnownAnswer(self):
+    generator=COPASI.CRandom.createGenerator(COPASI.CRandom.philox4x32,1)
+    # The seed 0 selects a system seed when the generator is created.
+    generator.initialize(0)
+    values=[generator.getRandomU() for i in range(4)]
+    self.assert_(values==[0x6627e8d5,0xe169c58d,0xbc57ac4c,0x9b00dbd8])
+
+  def test_philox4x32Sequence(self):
+    for seed in [1,0x12345678,MASK]:
+      generator=COPASI.CRandom.createGenerator(COPASI.CRandom.philox4x32,seed)
+      values=[generator.getRandomU() for i in range(103)]
+      self.assert_(values==philoxSequence(seed,103))
+      generator.initialize(seed)
+      self.assert_(generator.getRandomU()==values[0])
+
+def suite():
+  tests=[
+          'test_philox4x32Reference'
+         ,'test_philox4x32KnownAnswer'
+         ,'test_philox4x32Sequence'
+        ]
+  return unittest.TestSuite(map(Test_CRandom,tests))
+
+if(__name__ == '__main__'):
+    unittest.TextTestRunner(verbosity=2).run(suite())
@@ -0,0 +1,103 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+import COPASI
+import unittest
+import os
+import shutil
+import tempfile
+import Test_CreateSimpleModel
+
+class Test_CReportWriter(unittest.TestCase):
+  def setUp(self):
+    self.datamodel=Test_CreateSimpleModel.createModel()
+    self.model=self.datamodel.getModel()
+    self.directory=tempfile.mkdtemp()
+    self.trajectoryTask=self.datamodel.getTask("Time-Course")
+    problem=self.trajectoryTask.getProblem()
+    problem.getParameter("StepNumber").setValue(10000)
+    problem.getParameter("StepSize").setValue(0.001)
+    problem.getParameter("Duration").setValue(10.0)
+    problem.getParameter("TimeSeriesRequested").setValue(False)
+    self.reportDefinition=self.createReportDefinition()
+
+  def tearDown(self):
+    shutil.rmtree(self.directory)
+    COPASI.CRootContainer.removeDatamodel(self.datamodel)
+
+  def createReportDefinition(self):
+    reportDefinition=self.datamodel.getReportDefinitionList().createReportDefinition("Writer","Time and concentrations")
+    reportDefinition.setTaskType(COPASI.CTaskEnum.Task_timeCourse)
+    reportDefinition.setIsTable(False)
+    reportDefinition.setSeparator(COPASI.CCopasiReportSeparator(", "))
+    separator=COPASI.CRegisteredCommonName(reportDefinition.getSeparator().getCN().getString())
+    header=reportDefinition.getHeaderAddr()
+    body=reportDefinition.getBodyAddr()
+    header.push_back(COPASI.CRegisteredCommonName(COPASI.CDataString("time").getCN().getString()))
+    body.push_back(COPASI.CRegisteredCommonName(self.model.getCN().getString()+",Reference=Time"))
+    for i in range(self.model.getMetabolites().size()):
+      metab=self.model.getMetabolite(i)
+      header.push_back(separator)
+      header.push_back(COPASI.CRegisteredCommonName(COPASI.CDataString(metab.getObjectName()).getCN().getString()))
+      body.push_back(separator)
+      body.push_back(COPASI.CRegisteredCommonName(metab.getObject(COPASI.CCommonName("Reference=Concentration")).getCN().getString()))
+    return reportDefinition
+
+  def runReport(self,task,fileName,asynchronous):
+    report=task.getReport()
+    report.setReportDefinition(self.reportDefinition)
+    report.setTarget(os.path.join(self.directory,fileName))
+    report.setAppend(False)
+    report.setAsynchronous(asynchronous)
+    self.assert_(task.process(True))
+    f=open(os.path.join(self.directory,fileName),'rb')
+    content=f.read()
+    f.close()
+    return content
+
+  def test_setAsynchronous(self):
+    report=self.trajectoryTask.getReport()
+    report.setAsynchronous(False)
+    self.assert_(not report.isAsynchronous())
+    # asynchronous output is only available if compiled with COPASI_ASYNC_REPORT,
+    # otherwise the comparisons below run the synchronous writer twice
+    report.setAsynchronous(True)
+    copy=COPASI.CReport(report)
+    self.assert_(copy.isAsynchronous()==report.isAsynchronous())
+
+  def test_timeCourse(self):
+    # more rows than the writer buffers, i.e., the task has to wait for the writer
+    synchronous=self.runReport(self.trajectoryTask,'synchronous.txt',False)
+    self.assert_(len(synchronous.splitlines())==10002)
+    asynchronous=self.runReport(self.trajectoryTask,'asynchronous.txt',True)
+    self.assert_(asynchronous==synchronous)
+
+  def test_repeatedRuns(self):
+    # the separators between the runs are written by the task and must be ordered with the rows
+    self.trajectoryTask.setScheduled(False)
+    problem=self.trajectoryTask.getProblem()
+    problem.getParameter("StepNumber").setValue(100)
+    problem.getParameter("StepSize").setValue(0.1)
+    scanTask=self.datamodel.getTask("Scan")
+    scanProblem=scanTask.getProblem()
+    scanProblem.setSubtask(COPASI.CTaskEnum.Task_timeCourse)
+    scanProblem.addScanItem(COPASI.CScanProblem.SCAN_REPEAT,3)
+    scanProblem.setOutputInSubtask(True)
+    scanProblem.setContinueFromCurrentState(False)
+    synchronous=self.runReport(scanTask,'synchronous.txt',False)
+    asynchronous=self.runReport(scanTask,'asynchronous.txt',True)
+    self.assert_(asynchronous==synchronous)
+
+def suite():
+  tests=[
+          'test_setAsynchronous'
+         ,'test_timeCourse'
+         ,'test_repeatedRuns'
+        ]
+  return unittest.TestSuite(map(Test_CReportWriter,tests))
+
+if(__name__ == '__main__'):
+    unittest.TextTestRunner(verbosity=2).run(suite())
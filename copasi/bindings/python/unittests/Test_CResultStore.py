@@ -0,0 +1,126 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+import COPASI
+import unittest
+import math
+import os
+import tempfile
+import Test_CreateSimpleModel
+
+class Test_CResultStore(unittest.TestCase):
+  def setUp(self):
+    self.datamodel=Test_CreateSimpleModel.createModel()
+    self.model=self.datamodel.getModel()
+    self.directory=tempfile.mkdtemp()
+    self.fileName=os.path.join(self.directory,'results.crs')
+    self.metab=None
+    for i in range(self.model.getMetabolites().size()):
+      if self.model.getMetabolite(i).getObjectName()=="A":
+        self.metab=self.model.getMetabolite(i)
+    self.timeCN=self.model.getCN().getString()+",Reference=Time"
+    self.concentrationCN=self.metab.getObject(COPASI.CCommonName("Reference=Concentration")).getCN().getString()
+    self.trajectoryTask=self.datamodel.getTask("Time-Course")
+    problem=self.trajectoryTask.getProblem()
+    problem.getParameter("StepNumber").setValue(100)
+    problem.getParameter("StepSize").setValue(0.1)
+    problem.getParameter("Duration").setValue(10.0)
+    problem.getParameter("TimeSeriesRequested").setValue(False)
+
+  def tearDown(self):
+    if os.path.exists(self.fileName):
+      os.remove(self.fileName)
+    os.rmdir(self.directory)
+    COPASI.CRootContainer.removeDatamodel(self.datamodel)
+
+  def createStore(self,chunkSteps):
+    store=COPASI.CResultStore()
+    store.setFileName(self.fileName)
+    store.setChunkSteps(chunkSteps)
+    store.addObject(COPASI.CRegisteredCommonName(self.timeCN))
+    store.addObject(COPASI.CRegisteredCommonName(self.concentrationCN))
+    return store
+
+  def record(self,store,task):
+    self.datamodel.addInterface(store)
+    try:
+      return task.process(True)
+    finally:
+      self.datamodel.removeInterface(store)
+      store.close()
+
+  def assertConcentration(self,time,value):
+    # A decays with the rate constant 0.5 from its initial concentration 2e-4
+    expected=2.0e-4*math.exp(-0.5*time)
+    self.assert_(abs(value-expected)<=1e-4*expected)
+
+  def test_timeCourse(self):
+    # 101 steps in chunks of 8 steps, i.e., the last chunk is not full
+    self.assert_(self.record(self.createStore(8),self.trajectoryTask))
+    reader=COPASI.CResultStoreReader()
+    self.assert_(reader.open(self.fileName))
+    self.assert_(reader.getDatasetCount()==2)
+    self.assert_(reader.getDatasetName(0)==self.timeCN)
+    self.assert_(reader.getDatasetName(1)==self.concentrationCN)
+    self.assert_(reader.getDatasetIndex(self.concentrationCN)==1)
+    self.assert_(reader.getRunCount()==1)
+    self.assert_(reader.getStepCount(0)==101)
+    times=reader.getData(0,0)
+    values=reader.getData(0,1)
+    self.assert_(len(times)==101)
+    self.assert_(len(values)==101)
+    for step in range(101):
+      self.assert_(abs(times[step]-0.1*step)<1e-9)
+      self.assertConcentration(times[step],values[step])
+      self.assert_(reader.getValue(0,step,0)==times[step])
+      self.assert_(reader.getValue(0,step,1)==values[step])
+    # invalid indexes
+    self.assert_(math.isnan(reader.getValue(0,101,0)))
+    self.assert_(math.isnan(reader.getValue(1,0,0)))
+    self.assert_(math.isnan(reader.getValue(0,0,2)))
+    reader.close()
+
+  def test_repeatedRuns(self):
+    # Each repeat of the scan is a run, chunks do not span runs.
+    self.trajectoryTask.setScheduled(False)
+    problem=self.trajectoryTask.getProblem()
+    problem.getParameter("StepNumber").setValue(10)
+    problem.getParameter("StepSize").setValue(1.0)
+    scanTask=self.datamodel.getTask("Scan")
+    scanProblem=scanTask.getProblem()
+    scanProblem.setSubtask(COPASI.CTaskEnum.Task_timeCourse)
+    scanProblem.addScanItem(COPASI.CScanProblem.SCAN_REPEAT,3)
+    scanProblem.setOutputInSubtask(True)
+    scanProblem.setContinueFromCurrentState(False)
+    self.assert_(self.record(self.createStore(4),scanTask))
+    reader=COPASI.CResultStoreReader()
+    self.assert_(reader.open(self.fileName))
+    self.assert_(reader.getRunCount()==3)
+    for run in range(3):
+      self.assert_(reader.getStepCount(run)==11)
+      times=reader.getData(run,0)
+      values=reader.getData(run,1)
+      self.assert_(len(values)==11)
+      for step in range(11):
+        self.assert_(abs(times[step]-step)<1e-9)
+        self.assertConcentration(times[step],values[step])
+        self.assert_(reader.getValue(run,step,1)==values[step])
+    reader.close()
+
+  def test_missingFile(self):
+    reader=COPASI.CResultStoreReader()
+    self.assert_(not reader.open(os.path.join(self.directory,'missing.crs')))
+
+def suite():
+  tests=[
+          'test_timeCourse'
+         ,'test_repeatedRuns'
+         ,'test_missingFile'
+        ]
+  return unittest.TestSuite(map(Test_CResultStore,tests))
+
+if(__name__ == '__main__'):
+    unittest.TextTestRunner(verbosity=2).run(suite())
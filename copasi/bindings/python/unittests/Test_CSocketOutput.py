@@ -0,0 +1,188 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+import COPASI
+import unittest
+import os
+import socket
+import struct
+import tempfile
+import threading
+import time
+import Test_CreateSimpleModel
+
+HEADER=1
+DATA=2
+SEPARATOR=3
+FINISH=4
+
+class Consumer(threading.Thread):
+  # A local client reading the frames published by a CSocketOutput
+  def __init__(self,path,wait=None,delay=0):
+    threading.Thread.__init__(self)
+    self.daemon=True
+    self.server=socket.socket(socket.AF_UNIX,socket.SOCK_STREAM)
+    self.server.bind(path)
+    self.server.listen(1)
+    self.wait=wait
+    self.delay=delay
+    self.frames=[]
+    self.names=[]
+    self.rows=[]
+
+  def read(self,connection,size):
+    data=b''
+    while len(data)<size:
+      chunk=connection.recv(size-len(data))
+      if not chunk:
+        return None
+      data+=chunk
+    return data
+
+  def run(self):
+    connection=self.server.accept()[0]
+    if self.wait!=None:
+      self.wait.wait()
+    while True:
+      header=self.read(connection,16)
+      if header==None:
+        break
+      type,count,size=struct.unpack('=IIQ',header)
+      payload=self.read(connection,size) if size>0 else b''
+      if payload==None:
+        break
+      if self.delay>0:
+        time.sleep(self.delay)
+      self.frames.append((type,count))
+      if type==HEADER:
+        version,byteOrder=struct.unpack('=II',payload[:8])
+        offset=8
+        for i in range(count):
+          length=struct.unpack('=I',payload[offset:offset+4])[0]
+          self.names.append(payload[offset+4:offset+4+length].decode('utf-8'))
+          offset+=4+length
+      elif type==DATA:
+        columns=len(self.names)
+        values=struct.unpack('=%dd' % (count*columns),payload)
+        for i in range(count):
+          self.rows.append(values[i*columns:(i+1)*columns])
+      elif type==FINISH:
+        break
+    connection.close()
+    self.server.close()
+
+class Test_CSocketOutput(unittest.TestCase):
+  def setUp(self):
+    self.datamodel=Test_CreateSimpleModel.createModel()
+    self.model=self.datamodel.getModel()
+    self.directory=tempfile.mkdtemp()
+    self.path=os.path.join(self.directory,'output.sock')
+    self.task=None
+    for x in range(0,self.datamodel.getTaskList().size()):
+      if(self.datamodel.getTask(x).getType()==COPASI.CCopasiTask.timeCourse):
+        self.task=self.datamodel.getTask(x)
+
+  def tearDown(self):
+    if os.path.exists(self.path):
+      os.remove(self.path)
+    os.rmdir(self.directory)
+    COPASI.CRootContainer.removeDatamodel(self.datamodel)
+
+  def createOutput(self):
+    output=COPASI.CSocketOutput()
+    output.setSocketName(self.path)
+    output.addObject(COPASI.CRegisteredCommonName(self.model.getCN().getString()+",Reference=Time"))
+    output.addObject(COPASI.CRegisteredCommonName(self.model.getMetabolite(0).getObject(COPASI.CCommonName("Reference=Concentration")).getCN().getString()))
+    return output
+
+  def runTimeCourse(self,output,steps):
+    problem=self.task.getProblem()
+    problem.getParameter("StepNumber").setValue(steps)
+    problem.getParameter("StepSize").setValue(10.0/steps)
+    problem.getParameter("Duration").setValue(10.0)
+    problem.getParameter("TimeSeriesRequested").setValue(False)
+    self.datamodel.addInterface(output)
+    try:
+      return self.task.process(True)
+    finally:
+      self.datamodel.removeInterface(output)
+
+  def test_streamTimeCourse(self):
+    if not hasattr(socket,'AF_UNIX'):
+      return
+    consumer=Consumer(self.path)
+    consumer.start()
+    output=self.createOutput()
+    output.setBatchRows(8)
+    output.setTimeout(10000)
+    self.assert_(self.runTimeCourse(output,100))
+    output.close()
+    consumer.join(10)
+    self.assert_(not consumer.is_alive())
+    self.assert_(consumer.frames[0]==(HEADER,2))
+    self.assert_(len(consumer.names)==2)
+    self.assert_(consumer.frames[-1]==(FINISH,0))
+    self.assert_(len(consumer.rows)==101)
+    self.assert_(output.getDroppedRows()==0)
+    self.assert_(consumer.rows[0][0]==0.0)
+    self.assert_(abs(consumer.rows[-1][0]-10.0)<1e-9)
+    self.assert_(consumer.rows[0][1]>consumer.rows[-1][1])
+
+  def test_slowConsumer(self):
+    if not hasattr(socket,'AF_UNIX'):
+      return
+    # The consumer reads slower than the timeout allows. Batches are dropped
+    # while the task runs but the remaining frames are delivered at the end.
+    consumer=Consumer(self.path,None,0.002)
+    consumer.start()
+    output=self.createOutput()
+    output.setBatchRows(64)
+    output.setTimeout(1)
+    self.assert_(self.runTimeCourse(output,100000))
+    dropped=output.getDroppedRows()
+    output.close()
+    consumer.join(30)
+    self.assert_(not consumer.is_alive())
+    self.assert_(consumer.frames[-1]==(FINISH,dropped))
+    self.assert_(len(consumer.rows)+dropped==100001)
+
+  def test_stalledConsumer(self):
+    if not hasattr(socket,'AF_UNIX'):
+      return
+    # The consumer does not read until the task has finished, i.e., the
+    # remaining frames are discarded and counted as dropped.
+    wait=threading.Event()
+    consumer=Consumer(self.path,wait)
+    consumer.start()
+    output=self.createOutput()
+    output.setBatchRows(64)
+    output.setTimeout(1)
+    output.setFinishTimeout(1)
+    self.assert_(self.runTimeCourse(output,100000))
+    dropped=output.getDroppedRows()
+    wait.set()
+    output.close()
+    consumer.join(10)
+    self.assert_(not consumer.is_alive())
+    self.assert_(dropped>0)
+    self.assert_(len(consumer.rows)+dropped==100001)
+
+  def test_noConsumer(self):
+    output=self.createOutput()
+    output.setSocketName(os.path.join(self.directory,'missing.sock'))
+    self.assert_(not self.runTimeCourse(output,10))
+
+def suite():
+  tests=[
+          'test_streamTimeCourse'
+         ,'test_slowConsumer'
+         ,'test_stalledConsumer'
+         ,'test_noConsumer'
+        ]
+  return unittest.TestSuite(map(Test_CSocketOutput,tests))
+
+if(__name__ == '__main__'):
+    unittest.TextTestRunner(verbosity=2).run(suite())
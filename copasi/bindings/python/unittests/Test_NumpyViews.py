@@ -0,0 +1,96 @@
+# -*- coding: utf-8 -*-
+# Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+# Properties, Inc., University of Heidelberg, and University of
+# of Connecticut School of Medicine.
+# All rights reserved.
+
+import COPASI
+import unittest
+import gc
+import weakref
+import Test_CreateSimpleModel
+
+try:
+  import numpy
+except ImportError:
+  numpy=None
+
+class Test_NumpyViews(unittest.TestCase):
+  def setUp(self):
+    self.datamodel=Test_CreateSimpleModel.createModel()
+    self.model=self.datamodel.getModel()
+
+  def tearDown(self):
+    COPASI.CRootContainer.removeDatamodel(self.datamodel)
+
+  def test_vectorAliasesData(self):
+    if numpy==None:
+      return
+    vector=COPASI.FloatVector(3)
+    view=vector.getNumpyArray()
+    self.assert_(view.shape==(3,))
+    view[:]=[1.0,2.0,3.0]
+    for i in range(3):
+      self.assert_(vector.get(i)==i+1.0)
+    vector.setNumpyArray([4.0,5.0,6.0])
+    self.assert_(view[2]==6.0)
+
+  def test_matrixAliasesData(self):
+    if numpy==None:
+      return
+    matrix=COPASI.FloatMatrix(2,3)
+    view=matrix.getNumpyArray()
+    self.assert_(view.shape==(2,3))
+    view[1,2]=7.0
+    self.assert_(matrix.get(1,2)==7.0)
+    matrix.setNumpyArray(numpy.arange(6.0))
+    self.assert_(view[1,0]==3.0)
+
+  def test_ownerStaysAlive(self):
+    if numpy==None:
+      return
+    matrix=COPASI.FloatMatrix(2,3)
+    matrix.setNumpyArray(numpy.arange(6.0))
+    owner=weakref.ref(matrix)
+    # derived views share the owner as well
+    view=matrix.getNumpyArray().reshape(6)
+    del matrix
+    gc.collect()
+    self.assert_(owner()!=None)
+    self.assert_(list(view)==[0.0,1.0,2.0,3.0,4.0,5.0])
+    del view
+    gc.collect()
+    self.assert_(owner()==None)
+
+  def test_containerStaysAlive(self):
+    if numpy==None:
+      return
+    # The state is a part of the container copy, which is owned by Python.
+    container=COPASI.CMathContainer(self.model.getMathContainer())
+    state=container.getInitialState()
+    expected=[state.get(i) for i in range(len(state))]
+    view=state.getNumpyArray()
+    view[len(expected)-1]+=1.0
+    expected[-1]+=1.0
+    self.assert_(container.getInitialState().get(len(expected)-1)==expected[-1])
+    owner=weakref.ref(container)
+    del container
+    del state
+    gc.collect()
+    self.assert_(owner()!=None)
+    self.assert_(list(view)==expected)
+    del view
+    gc.collect()
+    self.assert_(owner()==None)
+
+def suite():
+  tests=[
+          'test_vectorAliasesData'
+         ,'test_matrixAliasesData'
+         ,'test_ownerStaysAlive'
+         ,'test_containerStaysAlive'
+        ]
+  return unittest.TestSuite(map(Test_NumpyViews,tests))
+
+if(__name__ == '__main__'):
+    unittest.TextTestRunner(verbosity=2).run(suite())
@@ -45,6 +45,7 @@ import Test_CModel
 import Test_CModelValue
 import Test_CMoiety
 import Test_COutputAssistant
+import Test_CRandom
 import Test_CReaction
 import Test_CreateSimpleModel
 import Test_CReport
@@ -59,6 +60,12 @@ import Test_CTrajectoryTask
 import Test_CVersion
 import Test_CEvent
 import Test_CRootContainer
+import Test_CSocketOutput
+import Test_CInitialValueSetter
+import Test_CResultStore
+import Test_NumpyViews
+import Test_CReportWriter
+import Test_COutputInterval
 
 suites=[
           Test_CVersion.suite()
@@ -100,6 +107,13 @@ suites=[
          ,Test_COutputAssistant.suite()
          ,Test_CreateSimpleModel.suite()
          ,Test_RunSimulations.suite()
+         ,Test_CSocketOutput.suite()
+         ,Test_CInitialValueSetter.suite()
+         ,Test_CResultStore.suite()
+         ,Test_NumpyViews.suite()
+         ,Test_CReportWriter.suite()
+         ,Test_COutputInterval.suite()
+         ,Test_CRandom.suite()
        ]
 
 def suite():
@@ -20,6 +20,7 @@
 %ignore CVectorInterface::operator[] (const index_type & index) const;
 %ignore CDataArray::operator=(const CDataArray&);
 %ignore CDataArray::array() const;
+%ignore CArrayInterface::data;
 %ignore operator<<(std::ostream &os, const CDataArray & o);
 
 
@@ -95,3 +96,22 @@
 %template(AnnotatedFloatMatrix) CMatrixInterface<CMatrix<C_FLOAT64> >;
 typedef CMatrixInterface<CMatrix<C_FLOAT64> > AnnotatedFloatMatrix;
 
+
+#ifdef SWIGPYTHON
+%extend CDataArray {
+   // needed to create NumPy arrays sharing the memory of the array
+   size_t getArrayAddress() const
+   {
+      if ($self->array() == NULL) return 0;
+
+      return (size_t) $self->array()->data();
+   }
+
+   size_t getArraySize(const size_t & dimension) const
+   {
+      if ($self->array() == NULL || dimension >= $self->dimensionality()) return 0;
+
+      return $self->array()->size()[dimension];
+   }
+};
+#endif // SWIGPYTHON
@@ -0,0 +1,33 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+%{
+
+#include "model/CInitialValueSetter.h"
+
+%}
+
+%ignore CInitialValueSetter::compile(const std::vector< CCommonName > & targets);
+%ignore CInitialValueSetter::getTargets;
+
+%include "model/CInitialValueSetter.h"
+
+%extend CInitialValueSetter
+{
+  // the list of common names is passed as strings
+  bool compileTargets(const std::vector< std::string > & targets)
+  {
+    std::vector< CCommonName > Targets(targets.begin(), targets.end());
+    return self->compile(Targets);
+  }
+
+  std::string getTarget(unsigned C_INT32 index) const
+  {
+    if (index >= self->size())
+      return "";
+
+    return self->getTargets()[index];
+  }
+}
@@ -42,6 +42,14 @@
     {
         return (*self)(row,col);
     }
+
+#ifdef SWIGPYTHON
+    // needed to create NumPy arrays sharing the memory of the matrix
+    size_t getArrayAddress() const
+    {
+        return (size_t) self->array();
+    }
+#endif // SWIGPYTHON
 }
 
 %template(FloatMatrix) CMatrix<C_FLOAT64>;
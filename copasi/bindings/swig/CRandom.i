@@ -25,6 +25,14 @@
 %ignore CRandom::vare;
 %ignore CRandom::XMLType;
 %ignore CRandom::TypeName;
+%ignore CRandom::fillRandomU;
+%ignore CRandom::fillRandomCC;
+%ignore CRandom::fillRandomCO;
+%ignore CRandom::fillRandomOO;
+%ignore CRandom::fillRandomExp;
+%ignore CRandom::fillRandomNormal;
+%ignore CRandom::fillRandomPoisson;
+%ignore CRandom::fillRandomBinomial;
 
 // suppress warnings on nested structures
 %warnfilter(325) PoissonVars;
@@ -0,0 +1,16 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+%{
+
+#include "output/CResultStore.h"
+#include "output/CResultStoreReader.h"
+
+%}
+
+%ignore CResultStore::Chunk;
+
+%include "output/CResultStore.h"
+%include "output/CResultStoreReader.h"
@@ -0,0 +1,12 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+%{
+
+#include "output/CSocketOutput.h"
+
+%}
+
+%include "output/CSocketOutput.h"
@@ -24,6 +24,8 @@
 %}
 
 
+%ignore CTimeSeries::getBlock;
+
 %include "trajectory/CTimeSeries.h"
 
 
@@ -44,6 +46,14 @@
         return result;
     }
 #endif // SWIGJAVA || CSHARP
+
+#ifdef SWIGPYTHON
+    // needed to create NumPy arrays sharing the memory of the blocks
+    size_t getBlockAddress(const size_t & block) const
+    {
+        return (size_t) self->getBlock(block);
+    }
+#endif // SWIGPYTHON
 };
 
 
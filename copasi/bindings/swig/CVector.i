@@ -66,6 +66,12 @@
   {
     return self->size();
   }
+
+  // needed to create NumPy arrays sharing the memory of the vector
+  size_t getArrayAddress() const
+  {
+    return (size_t) self->array();
+  }
 #endif // SWIGPYTHON
 }
 
@@ -182,6 +182,7 @@ size_t INVALID_INDEX();
 %include "CModelParameterGroup.i"
 %include "CModelParameterSet.i"
 %include "CDataVector.i"
+%include "CInitialValueSetter.i"
 %include "CVersion.i"
 %include "CCopasiMethod.i"
 %include "CCopasiProblem.i"
@@ -202,6 +203,8 @@ size_t INVALID_INDEX();
 %include "CReportDefinitionVector.i"
 %include "CDataModel.i"
 %include "CTimeSeries.i"
+%include "CResultStore.i"
+%include "CSocketOutput.i"
 %include "CTrajectoryProblem.i"
 %include "CTrajectoryMethod.i"
 %include "CTrajectoryTask.i"
@@ -119,6 +119,7 @@ CConfigurationFile::CConfigurationFile(const std::string & name,
   mpRecentMIRIAMResources(NULL),
   mpApplicationFont(NULL),
   mpValidateUnits(NULL),
+  mpCacheStructuralAnalysis(NULL),
   mpDisplayIssueSeverity(NULL),
   mpDisplayIssueKinds(NULL),
   mpUseOpenGL(NULL),
@@ -149,6 +150,7 @@ CConfigurationFile::CConfigurationFile(const CConfigurationFile & src,
   mpRecentMIRIAMResources(NULL),
   mpApplicationFont(NULL),
   mpValidateUnits(NULL),
+  mpCacheStructuralAnalysis(NULL),
   mpDisplayIssueSeverity(NULL),
   mpDisplayIssueKinds(NULL),
   mpUseOpenGL(NULL),
@@ -221,6 +223,7 @@ void CConfigurationFile::initializeParameter()
   mpDisplayIssueSeverity = assertGroup("Display Issue Severity");
   mpDisplayIssueKinds = assertGroup("Display Issue Kinds");
   mpValidateUnits = assertParameter("Validate Units", CCopasiParameter::Type::BOOL, false);
+  mpCacheStructuralAnalysis = assertParameter("Cache Structural Analysis", CCopasiParameter::Type::BOOL, false);
 
   // Remove display issue kinds which can no longer be mapped;
   CCopasiParameterGroup::elements::const_iterator itKind = mpDisplayIssueKinds->beginIndex();
@@ -496,6 +499,16 @@ void CConfigurationFile::setValidateUnits(bool validateUnits)
   *mpValidateUnits = validateUnits;
 }
 
+bool CConfigurationFile::cacheStructuralAnalysis() const
+{
+  return *mpCacheStructuralAnalysis;
+}
+
+void CConfigurationFile::setCacheStructuralAnalysis(bool cacheStructuralAnalysis)
+{
+  *mpCacheStructuralAnalysis = cacheStructuralAnalysis;
+}
+
 CConfigurationFile::CXML::CXML():
   CCopasiXMLInterface(),
   mConfiguration("Configuration")
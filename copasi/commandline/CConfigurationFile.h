@@ -189,6 +189,19 @@ public:
    */
   void setValidateUnits(bool validateUnits);
 
+  /**
+   * Cache the structural analysis of loaded COPASI files in a snapshot file
+   * next to the model. This does not cache the parsed or compiled model.
+   * @return a flag indicating whether the structural analysis is cached
+   */
+  bool cacheStructuralAnalysis() const;
+
+  /**
+   * Set whether the structural analysis of loaded COPASI files is cached.
+   * @param bool cacheStructuralAnalysis
+   */
+  void setCacheStructuralAnalysis(bool cacheStructuralAnalysis);
+
   /**
    * Show item issues
    * @return a flag indicating whether an icon and tooltip should be
@@ -477,6 +490,11 @@ private:
    */
   bool * mpValidateUnits;
 
+  /**
+   * A pointer indicating whether the structural analysis is cached
+   */
+  bool * mpCacheStructuralAnalysis;
+
   /**
   * A pointer indicating whether to use the OpenGL rendering, or the Qt based one
    */
@@ -68,6 +68,9 @@ const char const_usage[] =
   "  --report-file file            Override report file name to be used except\n"
   "                                for the one defined in the scheduled task.\n"
   "  --scheduled-task taskName     Override the task marked as executable.\n"
+  "  --server endpoint             Run as a persistent batch server reading jobs\n"
+  "                                from stdin (endpoint: -) or from connections\n"
+  "                                to the local socket with the given path.\n"
   "  --validate                    Only validate the given input file (COPASI,\n"
   "                                Gepasi, or SBML) without performing any\n"
   "                                calculations.\n"
@@ -266,6 +269,9 @@ void copasi::COptionParser::finalize(void)
           case option_ScheduledTask:
             throw option_error("missing value for 'scheduled-task' option");
 
+          case option_Server:
+            throw option_error("missing value for 'server' option");
+
           case option_Tmp:
             throw option_error("missing value for 'tmp' option");
 
@@ -739,6 +745,20 @@ void copasi::COptionParser::parse_long_option(const char *option, int position,
       state_ = state_value;
       return;
     }
+  else if (strcmp(option, "server") == 0)
+    {
+      if (source != source_cl) throw option_error("the 'server' option is only allowed on the command line");
+
+      if (locations_.Server)
+        {
+          throw option_error("the 'server' option is only allowed once");
+        }
+
+      openum_ = option_Server;
+      locations_.Server = position;
+      state_ = state_value;
+      return;
+    }
   else if (strcmp(option, "tmp") == 0)
     {
       source = source; // kill compiler unused variable warning
@@ -970,6 +990,12 @@ void copasi::COptionParser::parse_value(const char *value)
       }
       break;
 
+      case option_Server:
+      {
+        options_.Server = value;
+      }
+      break;
+
       case option_Tmp:
       {
         options_.Tmp = value;
@@ -1059,6 +1085,9 @@ const char* expand_long_name(const std::string &name)
   if (name_size <= 14 && name.compare("scheduled-task") == 0)
     matches.push_back("scheduled-task");
 
+  if (name_size <= 6 && name.compare("server") == 0)
+    matches.push_back("server");
+
   if (name_size <= 3 && name.compare("tmp") == 0)
     matches.push_back("tmp");
 
@@ -102,6 +102,7 @@ struct options
   SBMLSchema_enum     SBMLSchema;
   std::string     Save;
   std::string     ScheduledTask;
+  std::string     Server;
   std::string     Tmp;
   bool     Validate;
   bool     Verbose;
@@ -135,6 +136,7 @@ struct option_locations
   size_type SBMLSchema;
   size_type Save;
   size_type ScheduledTask;
+  size_type Server;
   size_type Tmp;
   size_type Validate;
   size_type Verbose;
@@ -235,7 +237,8 @@ private:
     option_MaxTime,
     option_ConvertToIrreversible,
     option_ReportFile,
-    option_ScheduledTask
+    option_ScheduledTask,
+    option_Server
   } openum_;
 
   enum parser_state {state_option, state_value, state_consume } state_;
@@ -246,6 +246,7 @@ void COptions::init(C_INT argc, char *argv[])
 
   setValue("ConvertToIrreversible", Options.ConvertToIrreversible);
   setValue("ScheduledTask", Options.ScheduledTask);
+  setValue("Server", Options.Server);
   setValue("ReportFile", Options.ReportFile);
 
 
@@ -88,3 +88,9 @@ size_t CArray::dimensionality() const
 {
   return mDim;
 }
+
+// virtual
+const CArray::data_type * CArray::data() const
+{
+  return mData.data();
+}
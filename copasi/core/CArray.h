@@ -32,6 +32,32 @@ public:
   virtual const index_type & size() const = 0;
 
   virtual size_t dimensionality() const = 0;
+
+  /**
+   * Retrieve a pointer to the values if they are stored contiguously in row
+   * major order
+   * @return const data_type * data (NULL if the values are not contiguous)
+   */
+  virtual const data_type * data() const
+  {return NULL;}
+
+protected:
+  /**
+   * Retrieve the contiguous values of a wrapped container
+   * @param const CType * pContainer
+   * @return const data_type * data (NULL if the values are not contiguous)
+   */
+  template < class CType > static const data_type * Data(const CType * /* pContainer */)
+  {return NULL;}
+
+  static const data_type * Data(const CMatrix< data_type > * pMatrix)
+  {return pMatrix->array();}
+
+  static const data_type * Data(const CVector< data_type > * pVector)
+  {return pVector->array();}
+
+  static const data_type * Data(const CVectorCore< data_type > * pVector)
+  {return pVector->array();}
 };
 
 /**
@@ -57,6 +83,8 @@ public:
 
   size_t dimensionality() const;
 
+  virtual const data_type * data() const;
+
 private:
   std::vector<data_type> mData;
 
@@ -120,6 +148,11 @@ public:
   {
     return 2;
   }
+
+  virtual const data_type * data() const
+  {
+    return Data(mMatrix);
+  }
 };
 
 /**
@@ -174,6 +207,11 @@ public:
   {
     return 1;
   }
+
+  virtual const data_type * data() const
+  {
+    return Data(mVector);
+  }
 };
 
 #endif
@@ -0,0 +1,200 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_CContext
+#define COPASI_CContext
+
+#include <cstddef>
+
+#include "copasi/core/CCore.h"
+
+#ifdef USE_OMP
+# include <omp.h>
+#endif // USE_OMP
+
+/**
+ * The template CContext holds the data of the master and of each thread
+ * participating in an OpenMP parallel region. Without OpenMP support the
+ * context has a size of 1 and the master data is the only active data.
+ * A context initialized within a parallel region has a size of 1 too, i.e.,
+ * we do not nest parallel regions.
+ */
+template < class Data > class CContext
+{
+public:
+  /**
+   * Constructor
+   * @param const bool & parallel (default: true)
+   */
+  CContext(const bool & parallel = true):
+    mMaster(),
+    mSize(1),
+    mpThreadData(NULL)
+  {
+    init(parallel);
+  }
+
+  /**
+   * Destructor
+   */
+  ~CContext()
+  {
+    if (mpThreadData != NULL)
+      delete [] mpThreadData;
+  }
+
+  /**
+   * Initialize the thread data. Any previously existing thread data is
+   * destroyed.
+   * @param const bool & parallel
+   */
+  void init(const bool & parallel)
+  {
+    if (mpThreadData != NULL)
+      {
+        delete [] mpThreadData;
+        mpThreadData = NULL;
+      }
+
+    mSize = 1;
+
+#ifdef USE_OMP
+
+    if (parallel && !inParallel())
+      mSize = omp_get_max_threads();
+
+#endif // USE_OMP
+
+    if (mSize > 1)
+      mpThreadData = new Data[mSize];
+  }
+
+  /**
+   * Retrieve the master data
+   * @return Data & master
+   */
+  Data & master()
+  {
+    return mMaster;
+  }
+
+  /**
+   * Retrieve the master data
+   * @return const Data & master
+   */
+  const Data & master() const
+  {
+    return mMaster;
+  }
+
+  /**
+   * Retrieve the data of the calling thread. Outside a parallel region or
+   * if the context is not parallel the master data is returned.
+   * @return Data & active
+   */
+  Data & active()
+  {
+    if (mSize == 1) return mMaster;
+
+    return mpThreadData[localIndex()];
+  }
+
+  /**
+   * Retrieve the data of the calling thread. Outside a parallel region or
+   * if the context is not parallel the master data is returned.
+   * @return const Data & active
+   */
+  const Data & active() const
+  {
+    if (mSize == 1) return mMaster;
+
+    return mpThreadData[localIndex()];
+  }
+
+  /**
+   * Retrieve a pointer to the begin of the thread data
+   * @return Data * beginThread (NULL if the context is not parallel)
+   */
+  Data * beginThread()
+  {
+    return mpThreadData;
+  }
+
+  /**
+   * Retrieve a pointer to the end of the thread data
+   * @return Data * endThread (NULL if the context is not parallel)
+   */
+  Data * endThread()
+  {
+    return mpThreadData + (mpThreadData != NULL ? mSize : 0);
+  }
+
+  /**
+   * Retrieve the number of threads
+   * @return const size_t & size
+   */
+  const size_t & size() const
+  {
+    return mSize;
+  }
+
+  /**
+   * Check whether the context provides data for more than one thread
+   * @return bool isParallel
+   */
+  bool isParallel() const
+  {
+    return mSize > 1;
+  }
+
+  /**
+   * Retrieve the index of the calling thread
+   * @return size_t localIndex
+   */
+  static size_t localIndex()
+  {
+#ifdef USE_OMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif // USE_OMP
+  }
+
+  /**
+   * Check whether the calling thread executes a parallel region
+   * @return bool inParallel
+   */
+  static bool inParallel()
+  {
+#ifdef USE_OMP
+    return omp_in_parallel() != 0;
+#else
+    return false;
+#endif // USE_OMP
+  }
+
+private:
+  /**
+   * Copy constructor is not supported
+   */
+  CContext(const CContext & src);
+
+  /**
+   * The master data
+   */
+  Data mMaster;
+
+  /**
+   * The number of threads
+   */
+  size_t mSize;
+
+  /**
+   * The data for each thread
+   */
+  Data * mpThreadData;
+};
+
+#endif // COPASI_CContext
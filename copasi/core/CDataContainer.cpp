@@ -331,7 +331,10 @@ bool CDataContainer::add(CDataObject * pObject,
   bool success = mObjects.insert(pObject).second;
 
   if (adopt)
-    pObject->setObjectParent(this);
+    {
+      pObject->setObjectParent(this);
+      notifyHierarchyChange(pObject, HierarchyChange::Added);
+    }
   else
     pObject->addReference(this);
 
@@ -345,6 +348,9 @@ bool CDataContainer::remove(CDataObject * pObject)
 {
   if (pObject != NULL)
     {
+      if (pObject->getObjectParent() == this)
+        notifyHierarchyChange(pObject, HierarchyChange::Removed);
+
       validityRemoved(pObject->getValidity());
       pObject->removeReference(this);
     }
@@ -380,8 +386,27 @@ void CDataContainer::getDescendants(CDataObject::DataObjectSet & descendants, co
 void CDataContainer::objectRenamed(CDataObject * pObject, const std::string & oldName)
 {
   mObjects.objectRenamed(pObject, oldName);
+
+  if (pObject->getObjectParent() == this)
+    notifyHierarchyChange(pObject, HierarchyChange::Renamed);
 }
 
+void CDataContainer::notifyHierarchyChange(const CDataObject * pChild, const HierarchyChange & change)
+{
+  // Only the data model is interested in changes of its hierarchy.
+  CDataContainer * pContainer = this;
+
+  while (pContainer != NULL && !pContainer->hasFlag(DataModel))
+    pContainer = pContainer->getObjectParent();
+
+  if (pContainer != NULL)
+    pContainer->hierarchyChanged(pChild, change);
+}
+
+// virtual
+void CDataContainer::hierarchyChanged(const CDataObject * /* pObject */, const HierarchyChange & /* change */)
+{}
+
 // virtual
 const std::string CDataContainer::getUnits() const
 {return "?";}
@@ -119,6 +119,24 @@ public:
 
   void objectRenamed(CDataObject * pObject, const std::string & oldName);
 
+  /**
+   * The change of an owned child
+   */
+  enum struct HierarchyChange
+  {
+    Added,
+    Removed,
+    Renamed
+  };
+
+  /**
+   * Notify the data model the container belongs to that an owned child has
+   * been added, removed, or renamed
+   * @param const CDataObject * pChild
+   * @param const HierarchyChange & change
+   */
+  void notifyHierarchyChange(const CDataObject * pChild, const HierarchyChange & change);
+
   /**
    * Retrieve the units of the object.
    * @return std::string units
@@ -151,6 +169,15 @@ public:
 protected:
   void initObjects();
 
+  /**
+   * Called for the data model whenever an object in its hierarchy has been
+   * added, removed, or renamed. Removed and renamed objects still have their
+   * parent.
+   * @param const CDataObject * pObject
+   * @param const HierarchyChange & change
+   */
+  virtual void hierarchyChanged(const CDataObject * pObject, const HierarchyChange & change);
+
   template <class CType> CDataObjectReference< CType > * addObjectReference(const std::string & name,
       CType & reference,
       const CFlags< Flag > & flag = CFlags< Flag >::None);
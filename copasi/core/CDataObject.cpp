@@ -324,6 +324,14 @@ bool CDataObject::setObjectParent(const CDataContainer * pParent)
       mpObjectParent->remove(this);
     }
 
+  // Objects which are released without being removed from their parent are
+  // no longer part of the hierarchy.
+  if (mpObjectParent != NULL &&
+      pParent == NULL)
+    {
+      mpObjectParent->notifyHierarchyChange(this, CDataContainer::HierarchyChange::Removed);
+    }
+
   removeReference(mpObjectParent);
 
   mpObjectParent = const_cast<CDataContainer *>(pParent);
@@ -16,12 +16,14 @@
 #include <sstream>
 #include <iterator>
 #include <cstddef>
+#include <unordered_map>
 
 #include "copasi/utilities/CCopasiMessage.h"
 #include "copasi/utilities/utility.h"
 
 #include "copasi/core/CRegisteredCommonName.h"
 #include "copasi/core/CDataContainer.h"
+#include "copasi/core/CContext.h"
 
 #include "copasi/undo/CData.h"
 #undef min
@@ -412,7 +414,8 @@ public:
               const CDataContainer * pParent = NO_PARENT,
               const CFlags< Flag > & flag = CFlags< Flag >::None):
     std::vector< CType * >(),
-    CDataContainer(name, pParent, "Vector", flag | CDataObject::Vector)
+    CDataContainer(name, pParent, "Vector", flag | CDataObject::Vector),
+    mIndexCache()
   {CONSTRUCTOR_TRACE;}
 
   /**
@@ -423,7 +426,8 @@ public:
   CDataVector(const CDataVector < CType > & src,
               const CDataContainer * pParent):
     std::vector< CType * >(src),
-    CDataContainer(src, pParent)
+    CDataContainer(src, pParent),
+    mIndexCache()
   {
     CONSTRUCTOR_TRACE;
 
@@ -651,6 +655,7 @@ public:
     if (pNew != NULL)
       {
         std::vector< CType * >::push_back(pNew);
+        mIndexCache[pObject] = size() - 1;
       }
 
     return CDataContainer::add(pObject, adopt);
@@ -843,20 +848,65 @@ public:
    */
   virtual size_t getIndex(const CDataObject * pObject) const
   {
-    size_t i, imax = size();
-    typename std::vector< CType * >::const_iterator itTarget = std::vector< CType * >::begin();
-
-    for (i = 0; i < imax; i++, itTarget++)
+    // The cache is not thread safe, i.e., lookups within a parallel region
+    // compare all elements.
+    if (CContext< bool >::inParallel())
       {
-        if (pObject == static_cast< const CDataObject * >(*itTarget))
+        size_t i, imax = size();
+        typename std::vector< CType * >::const_iterator itTarget = std::vector< CType * >::begin();
+
+        for (i = 0; i < imax; i++, itTarget++)
           {
-            return i;
+            if (pObject == static_cast< const CDataObject * >(*itTarget))
+              {
+                return i;
+              }
           }
+
+        return CDataContainer::getIndex(pObject);
+      }
+
+    // The elements may be moved, inserted, or erased without notice. Thus we
+    // verify the cached index and rebuild the cache if it is outdated.
+    std::unordered_map< const CDataObject *, size_t >::const_iterator found = mIndexCache.find(pObject);
+
+    if (found == mIndexCache.end() ||
+        found->second >= size() ||
+        static_cast< const CDataObject * >(*(std::vector< CType * >::begin() + found->second)) != pObject)
+      {
+        buildIndexCache();
+        found = mIndexCache.find(pObject);
       }
 
+    if (found != mIndexCache.end())
+      return found->second;
+
     return CDataContainer::getIndex(pObject);
   }
 
+private:
+  /**
+   * Build the cache of the indices of the elements
+   */
+  void buildIndexCache() const
+  {
+    mIndexCache.clear();
+
+    size_t i, imax = size();
+    typename std::vector< CType * >::const_iterator itTarget = std::vector< CType * >::begin();
+
+    // The first occurrence of an element determines its index.
+    for (i = 0; i < imax; i++, itTarget++)
+      mIndexCache.insert(std::make_pair(static_cast< const CDataObject * >(*itTarget), i));
+  }
+
+  /**
+   * The cached indices of the elements
+   */
+  mutable std::unordered_map< const CDataObject *, size_t > mIndexCache;
+
+public:
+
   /**
    * ostream operator
    * @param std::ostream & os
@@ -1360,20 +1410,36 @@ public:
     CDataObject::sanitizeObjectName(Sanitized);
     std::string Unquoted = unQuote(Sanitized);
 
-    size_t i, imax = CDataVector< CType >::size();
-    typename std::vector< CType * >::const_iterator Target = std::vector< CType * >::begin();
+    // We look up the candidates by name in the object map instead of comparing
+    // the names of all elements. Their indices are retrieved from the index
+    // cache of the vector.
+    size_t Index = getIndexByName(Sanitized);
 
-    for (i = 0; i < imax; i++, ++Target)
-      {
-        if (*Target &&
-            ((*Target)->getObjectName() == Sanitized ||
-             (*Target)->getObjectName() == Unquoted))
-          return i;
-      }
+    if (Unquoted != Sanitized)
+      Index = std::min(Index, getIndexByName(Unquoted));
 
-    return C_INVALID_INDEX;
+    return Index;
   }
 
+private:
+  /**
+   * Retrieve the smallest index of the elements with the given name
+   * @param const std::string & name
+   * @return size_t index
+   */
+  size_t getIndexByName(const std::string & name) const
+  {
+    size_t Index = C_INVALID_INDEX;
+    CDataContainer::objectMap::range Range = CDataContainer::getObjects().equal_range(name);
+
+    for (; Range.first != Range.second; ++Range.first)
+      if (dynamic_cast< const CType * >(*Range.first) != NULL)
+        Index = std::min(Index, CDataVector< CType >::getIndex(*Range.first));
+
+    return Index;
+  }
+
+public:
   void createUniqueName(std::string & name) const
   {
     std::string Name = name;
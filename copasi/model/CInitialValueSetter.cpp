@@ -0,0 +1,259 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include "copasi/copasi.h"
+
+#include "CInitialValueSetter.h"
+
+#include "copasi/model/CModel.h"
+#include "copasi/model/CModelParameterSet.h"
+#include "copasi/math/CMathContainer.h"
+#include "copasi/utilities/CCopasiMessage.h"
+
+CInitialValueSetter::CInitialValueSetter(CModel * pModel):
+  mpModel(NULL),
+  mpContainer(NULL),
+  mTargets(),
+  mContainerValues(),
+  mTargetIndex(),
+  mUpdateSequence()
+{
+  setModel(pModel);
+}
+
+CInitialValueSetter::~CInitialValueSetter()
+{}
+
+void CInitialValueSetter::setModel(CModel * pModel)
+{
+  mpModel = pModel;
+  mpContainer = NULL;
+
+  mTargets.clear();
+  mContainerValues.clear();
+  mTargetIndex.clear();
+  mUpdateSequence.clear();
+}
+
+CModel * CInitialValueSetter::getModel() const
+{
+  return mpModel;
+}
+
+bool CInitialValueSetter::compile(const std::vector< CCommonName > & targets)
+{
+  CModel * pModel = mpModel;
+  setModel(pModel);
+
+  if (mpModel == NULL)
+    return false;
+
+  bool success = mpModel->compileIfNecessary(NULL);
+
+  mpContainer = &mpModel->getMathContainer();
+
+  // The initial values are located before the transient values.
+  const C_FLOAT64 * pInitialBegin = mpContainer->getValues().array();
+  const C_FLOAT64 * pInitialEnd = mpContainer->getState(false).array() - mpContainer->getCountFixed();
+
+  CObjectInterface::ContainerList ListOfContainer;
+  ListOfContainer.push_back(mpContainer);
+
+  CObjectInterface::ObjectSet ChangedObjects;
+
+  std::vector< CCommonName >::const_iterator it = targets.begin();
+  std::vector< CCommonName >::const_iterator end = targets.end();
+
+  for (; it != end; ++it)
+    {
+      const CObjectInterface * pObject = CObjectInterface::GetObjectFromCN(ListOfContainer, *it);
+      const CMathObject * pMathObject = dynamic_cast< const CMathObject * >(pObject);
+
+      if (pMathObject == NULL && pObject != NULL)
+        pMathObject = mpContainer->getMathObject(pObject);
+
+      C_FLOAT64 * pValue = (pMathObject != NULL) ? (C_FLOAT64 *) pMathObject->getValuePointer() : NULL;
+
+      if (pValue == NULL ||
+          pValue < pInitialBegin ||
+          pValue >= pInitialEnd ||
+          pMathObject->getValueType() != CMath::ValueType::Value ||
+          pMathObject->getSimulationType() == CMath::SimulationType::Assignment)
+        {
+          CCopasiMessage(CCopasiMessage::ERROR, MCMathModel + 4, it->c_str());
+          success = false;
+          continue;
+        }
+
+      mTargetIndex[pMathObject->getDataObject()] = mTargets.size();
+      mTargets.push_back(*it);
+      mContainerValues.push_back(pValue);
+      ChangedObjects.insert(pMathObject);
+    }
+
+  // We request all initial values since intensive and extensive values of species must be synchronized.
+  CObjectInterface::ObjectSet RequestedObjects;
+  const CMathObject * pObject = mpContainer->getMathObject(pInitialBegin);
+  const CMathObject * pObjectEnd = pObject + (pInitialEnd - pInitialBegin);
+
+  for (; pObject != pObjectEnd; ++pObject)
+    RequestedObjects.insert(pObject);
+
+  mpContainer->getInitialDependencies().getUpdateSequence(mUpdateSequence,
+      CCore::SimulationContext::UpdateMoieties,
+      ChangedObjects,
+      RequestedObjects);
+
+  return success;
+}
+
+bool CInitialValueSetter::compile(const CModelParameterSet & parameterSet)
+{
+  std::vector< CCommonName > Targets;
+  collectTargets(parameterSet, Targets);
+
+  return compile(Targets);
+}
+
+const std::vector< CCommonName > & CInitialValueSetter::getTargets() const
+{
+  return mTargets;
+}
+
+size_t CInitialValueSetter::size() const
+{
+  return mTargets.size();
+}
+
+bool CInitialValueSetter::applyValues(const CVectorCore< C_FLOAT64 > & values)
+{
+  if (mpContainer == NULL)
+    return false;
+
+  if (values.size() != mContainerValues.size())
+    {
+      CCopasiMessage(CCopasiMessage::ERROR, MCMathModel + 5, (int) values.size(), (int) mContainerValues.size());
+      return false;
+    }
+
+  // Other changes to the model must not be lost.
+  mpContainer->fetchInitialState();
+
+  const C_FLOAT64 * pValue = values.array();
+  std::vector< C_FLOAT64 * >::iterator it = mContainerValues.begin();
+  std::vector< C_FLOAT64 * >::iterator end = mContainerValues.end();
+
+  for (; it != end; ++it, ++pValue)
+    **it = *pValue;
+
+  update();
+
+  return true;
+}
+
+bool CInitialValueSetter::applyValues(const std::vector< C_FLOAT64 > & values)
+{
+  CVectorCore< C_FLOAT64 > Values(values.size(), const_cast< C_FLOAT64 * >(values.data()));
+
+  return applyValues(Values);
+}
+
+bool CInitialValueSetter::apply(const CModelParameterSet & parameterSet)
+{
+  if (mpContainer == NULL)
+    return false;
+
+  mpContainer->fetchInitialState();
+  assignValues(parameterSet);
+  update();
+
+  return true;
+}
+
+// static
+const CDataObject * CInitialValueSetter::getTarget(const CModelParameter * pParameter)
+{
+  if (pParameter->getObject() == NULL ||
+      (pParameter->isInitialExpressionValid() && !pParameter->getInitialExpression().empty()))
+    return NULL;
+
+  switch (pParameter->getType())
+    {
+      case CModelParameter::Type::Compartment:
+      case CModelParameter::Type::Species:
+      case CModelParameter::Type::ModelValue:
+      {
+        const CModelEntity * pEntity = static_cast< const CModelEntity * >(pParameter->getObject());
+
+        if (pEntity->getStatus() != CModelEntity::Status::ASSIGNMENT)
+          return pEntity->getInitialValueReference();
+      }
+      break;
+
+      case CModelParameter::Type::ReactionParameter:
+        return static_cast< const CCopasiParameter * >(pParameter->getObject())->getValueReference();
+        break;
+
+      default:
+        break;
+    }
+
+  return NULL;
+}
+
+// static
+void CInitialValueSetter::collectTargets(const CModelParameterGroup & group,
+    std::vector< CCommonName > & targets)
+{
+  CModelParameterGroup::const_iterator it = group.begin();
+  CModelParameterGroup::const_iterator end = group.end();
+
+  for (; it != end; ++it)
+    {
+      const CModelParameterGroup * pGroup = dynamic_cast< const CModelParameterGroup * >(*it);
+
+      if (pGroup != NULL)
+        {
+          collectTargets(*pGroup, targets);
+          continue;
+        }
+
+      const CDataObject * pTarget = getTarget(*it);
+
+      if (pTarget != NULL)
+        targets.push_back(pTarget->getCN());
+    }
+}
+
+void CInitialValueSetter::assignValues(const CModelParameterGroup & group)
+{
+  CModelParameterGroup::const_iterator it = group.begin();
+  CModelParameterGroup::const_iterator end = group.end();
+  std::map< const CDataObject *, size_t >::const_iterator found;
+
+  for (; it != end; ++it)
+    {
+      const CModelParameterGroup * pGroup = dynamic_cast< const CModelParameterGroup * >(*it);
+
+      if (pGroup != NULL)
+        {
+          assignValues(*pGroup);
+          continue;
+        }
+
+      found = mTargetIndex.find(getTarget(*it));
+
+      if (found != mTargetIndex.end())
+        *mContainerValues[found->second] = (*it)->getValue(CCore::Framework::ParticleNumbers);
+    }
+}
+
+void CInitialValueSetter::update()
+{
+  mpContainer->applyUpdateSequence(mUpdateSequence);
+  mpContainer->pushInitialState();
+
+  mpModel->refreshActiveParameterSet();
+}
@@ -0,0 +1,170 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_CInitialValueSetter
+#define COPASI_CInitialValueSetter
+
+#include <map>
+#include <vector>
+
+#include "copasi/math/CMathUpdateSequence.h"
+#include "copasi/core/CVector.h"
+#include "copasi/core/CCommonName.h"
+
+class CModel;
+class CMathContainer;
+class CDataObject;
+class CModelParameter;
+class CModelParameterGroup;
+class CModelParameterSet;
+
+/**
+ * The class CInitialValueSetter applies values to a compiled list of initial
+ * values of a model in bulk. All dependent initial values are updated with a
+ * single update sequence and the model is synchronized once per application.
+ * This is much faster than changing the values object by object or through the
+ * parameters of a CModelParameterSet when many sets of values are applied,
+ * e.g., in a scan performed by a script.
+ *
+ * Only values are changed, i.e., initial expressions and the mapping of
+ * reaction parameters are not modified. The targets must be compiled again if
+ * the model is compiled.
+ */
+class CInitialValueSetter
+{
+public:
+  /**
+   * Specific constructor
+   * @param CModel * pModel (default: NULL)
+   */
+  CInitialValueSetter(CModel * pModel = NULL);
+
+  /**
+   * Destructor
+   */
+  ~CInitialValueSetter();
+
+  /**
+   * Set the model
+   * @param CModel * pModel
+   */
+  void setModel(CModel * pModel);
+
+  /**
+   * Retrieve the model
+   * @return CModel * pModel
+   */
+  CModel * getModel() const;
+
+  /**
+   * Compile the list of targets. Each target must be an initial value, e.g.,
+   * the initial concentration of a species or the value of a local reaction
+   * parameter.
+   * @param const std::vector< CCommonName > & targets
+   * @return bool success
+   */
+  bool compile(const std::vector< CCommonName > & targets);
+
+  /**
+   * Compile the targets from the parameters of a set which determine initial
+   * values, i.e., parameters without an initial expression.
+   * @param const CModelParameterSet & parameterSet
+   * @return bool success
+   */
+  bool compile(const CModelParameterSet & parameterSet);
+
+  /**
+   * Retrieve the compiled targets
+   * @return const std::vector< CCommonName > & targets
+   */
+  const std::vector< CCommonName > & getTargets() const;
+
+  /**
+   * Retrieve the number of compiled targets
+   * @return size_t size
+   */
+  size_t size() const;
+
+  /**
+   * Apply the values to the targets. The values must be in the order of the targets.
+   * @param const CVectorCore< C_FLOAT64 > & values
+   * @return bool success
+   */
+  bool applyValues(const CVectorCore< C_FLOAT64 > & values);
+
+  /**
+   * Apply the values to the targets. The values must be in the order of the targets.
+   * @param const std::vector< C_FLOAT64 > & values
+   * @return bool success
+   */
+  bool applyValues(const std::vector< C_FLOAT64 > & values);
+
+  /**
+   * Apply the values of the parameters of the set to the targets. Targets which
+   * are not determined by the set keep their current value.
+   * @param const CModelParameterSet & parameterSet
+   * @return bool success
+   */
+  bool apply(const CModelParameterSet & parameterSet);
+
+private:
+  /**
+   * Retrieve the initial value determined by a model parameter
+   * @param const CModelParameter * pParameter
+   * @return const CDataObject * pTarget (NULL if none)
+   */
+  static const CDataObject * getTarget(const CModelParameter * pParameter);
+
+  /**
+   * Collect the targets determined by the parameters of a group
+   * @param const CModelParameterGroup & group
+   * @param std::vector< CCommonName > & targets
+   */
+  static void collectTargets(const CModelParameterGroup & group,
+                             std::vector< CCommonName > & targets);
+
+  /**
+   * Assign the values of the parameters of a group to the targets
+   * @param const CModelParameterGroup & group
+   */
+  void assignValues(const CModelParameterGroup & group);
+
+  /**
+   * Update the dependent initial values and synchronize the model
+   */
+  void update();
+
+  /**
+   * The model
+   */
+  CModel * mpModel;
+
+  /**
+   * The math container of the model
+   */
+  CMathContainer * mpContainer;
+
+  /**
+   * The common names of the targets
+   */
+  std::vector< CCommonName > mTargets;
+
+  /**
+   * Pointers to the values of the targets in the math container
+   */
+  std::vector< C_FLOAT64 * > mContainerValues;
+
+  /**
+   * Map from the data object of a target to its index
+   */
+  std::map< const CDataObject *, size_t > mTargetIndex;
+
+  /**
+   * The sequence updating all initial values depending on the targets
+   */
+  CCore::CUpdateSequence mUpdateSequence;
+};
+
+#endif // COPASI_CInitialValueSetter
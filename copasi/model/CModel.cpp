@@ -25,6 +25,7 @@
 #include <limits>
 #include <cmath>
 #include <algorithm>
+#include <unordered_map>
 
 #include "copasi.h"
 
@@ -227,6 +228,11 @@ CModel::CModel(CDataContainer* pParent):
   mL(),
   mpLinkMatrixAnnotation(NULL),
   mLView(mL),
+  mLinkZeroColumns(),
+  mLinkZeroEntries(),
+  mLinkZeroSpecies(),
+  mLinkZeroReactions(),
+  mLinkZero(),
   mAvogadro(CUnit::Avogadro),
   mpAvogadroReference(new CDataObjectReference< C_FLOAT64 >("Avogadro Constant", this, mAvogadro, CDataObject::ValueDbl)),
   mQuantity2NumberFactor(std::numeric_limits< C_FLOAT64 >::quiet_NaN()),
@@ -767,12 +773,21 @@ void CModel::buildStoi()
   pCol = mStoi.array();
   pColEnd = mStoi.array() + numCols;
 
-  C_FLOAT64 * pRow, *pRowEnd;
-  pRowEnd = mStoi.array() + numRows * numCols;
+  C_FLOAT64 * pRow;
+
+  // Map the species keys to the rows of the stoichiometry matrix
+  std::vector< const CMetab * > RowSpecies(numRows);
+  std::unordered_map< std::string, size_t > RowIndex;
+  CDataVector< CMetab >::const_iterator itMetab = CDataVector< CMetab >::const_iterator(mMetabolitesX.begin()) + mNumMetabolitesODE;
+
+  for (size_t Row = 0; Row < numRows; ++Row, ++itMetab)
+    {
+      RowSpecies[Row] = &*itMetab;
+      RowIndex.insert(std::make_pair(itMetab->getKey(), Row));
+    }
 
   CDataVector< CReaction >::iterator itStep = mSteps.begin();
-  CDataVector< CMetab >::const_iterator itMetab;
-  size_t reactionNum = 0, speciesNum = 0;
+  size_t reactionNum = 0;
 
   for (; pCol < pColEnd; ++pCol, ++itStep, ++reactionNum)
     {
@@ -793,18 +808,14 @@ void CModel::buildStoi()
 
       for (; itBalance != endBalance; ++itBalance)
         {
-          const std::string & key = itBalance->getMetaboliteKey();
-          speciesNum = 0;
+          std::unordered_map< std::string, size_t >::const_iterator found = RowIndex.find(itBalance->getMetaboliteKey());
 
-          for (pRow = pCol, itMetab = CDataVector< CMetab >::const_iterator(mMetabolitesX.begin()) + mNumMetabolitesODE;
-               pRow < pRowEnd;
-               pRow += numCols, ++itMetab, ++speciesNum)
-            if (itMetab->getKey() == key)
-              {
-                *pRow = itBalance->getMultiplicity();
-                mReactionsPerSpecies[&*itMetab].insert(std::make_pair(&*itStep, *pRow));
-                break;
-              }
+          if (found != RowIndex.end())
+            {
+              pRow = pCol + found->second * numCols;
+              *pRow = itBalance->getMultiplicity();
+              mReactionsPerSpecies[RowSpecies[found->second]].insert(std::make_pair(&*itStep, *pRow));
+            }
         }
     }
 
@@ -3156,13 +3167,298 @@ std::string CModel::suitableForStochasticSimulation() const
 
 void CModel::buildLinkZero()
 {
-  mL.build(mStoi);
+  // The QR factorization is the most expensive part of the structural analysis.
+  // We reuse the link matrix of the previous compile whenever it is still valid.
+  if (isLinkZeroValid())
+    {
+      mL = mLinkZero;
+    }
+  else
+    {
+      mL.build(mStoi);
+      mLinkZero = mL;
+    }
+
+  // Remember the structure the link matrix is valid for. Only the non zero
+  // stoichiometries are kept since the matrix is usually very sparse.
+  mLinkZeroColumns.resize(mStoi.numCols() + 1);
+  mLinkZeroEntries.clear();
+
+  size_t i, j;
+
+  for (j = 0; j < mStoi.numCols(); ++j)
+    {
+      mLinkZeroColumns[j] = mLinkZeroEntries.size();
+
+      for (i = 0; i < mStoi.numRows(); ++i)
+        if (mStoi(i, j) != 0.0)
+          mLinkZeroEntries.push_back(std::make_pair(i, mStoi(i, j)));
+    }
+
+  mLinkZeroColumns[j] = mLinkZeroEntries.size();
+
+  mLinkZeroSpecies.resize(mNumMetabolitesReaction);
+  mLinkZeroReactions.resize(mSteps.size());
+
+  CDataVector< CMetab >::const_iterator itMetab = CDataVector< CMetab >::const_iterator(mMetabolitesX.begin()) + mNumMetabolitesODE;
+  std::vector< const CMetab * >::iterator itSpecies = mLinkZeroSpecies.begin();
+  std::vector< const CMetab * >::iterator endSpecies = mLinkZeroSpecies.end();
+
+  for (; itSpecies != endSpecies; ++itSpecies, ++itMetab)
+    *itSpecies = &*itMetab;
+
+  CDataVector< CReaction >::const_iterator itStep = mSteps.begin();
+  std::vector< const CReaction * >::iterator itReaction = mLinkZeroReactions.begin();
+  std::vector< const CReaction * >::iterator endReaction = mLinkZeroReactions.end();
+
+  for (; itReaction != endReaction; ++itReaction, ++itStep)
+    *itReaction = &*itStep;
+
   mNumMetabolitesReactionIndependent = mL.getNumIndependent();
   mL.doRowPivot(mStoi);
 
   return;
 }
 
+bool CModel::isLinkZeroValid() const
+{
+  size_t NumRows = mStoi.numRows();
+  size_t NumCols = mStoi.numCols();
+  size_t NumOldCols = mLinkZeroReactions.size();
+
+  if (mLinkZeroSpecies.size() != NumRows ||
+      mLinkZeroColumns.size() != NumOldCols + 1 ||
+      mLinkZero.getRowPivots().size() != NumRows ||
+      NumOldCols > NumCols)
+    return false;
+
+  // The species determined by reactions must be identical.
+  CDataVector< CMetab >::const_iterator itMetab = CDataVector< CMetab >::const_iterator(mMetabolitesX.begin()) + mNumMetabolitesODE;
+  std::vector< const CMetab * >::const_iterator itSpecies = mLinkZeroSpecies.begin();
+  std::vector< const CMetab * >::const_iterator endSpecies = mLinkZeroSpecies.end();
+
+  for (; itSpecies != endSpecies; ++itSpecies, ++itMetab)
+    if (*itSpecies != &*itMetab)
+      return false;
+
+  // The previously existing reactions must be unchanged.
+  CDataVector< CReaction >::const_iterator itStep = mSteps.begin();
+  std::vector< const CReaction * >::const_iterator itReaction = mLinkZeroReactions.begin();
+  std::vector< const CReaction * >::const_iterator endReaction = mLinkZeroReactions.end();
+
+  for (; itReaction != endReaction; ++itReaction, ++itStep)
+    if (*itReaction != &*itStep)
+      return false;
+
+  size_t i, j, k;
+
+  for (j = 0; j < NumOldCols; ++j)
+    {
+      std::vector< std::pair< size_t, C_FLOAT64 > >::const_iterator itEntry = mLinkZeroEntries.begin() + mLinkZeroColumns[j];
+      std::vector< std::pair< size_t, C_FLOAT64 > >::const_iterator endEntry = mLinkZeroEntries.begin() + mLinkZeroColumns[j + 1];
+
+      for (i = 0; i < NumRows; ++i)
+        {
+          C_FLOAT64 Value = 0.0;
+
+          if (itEntry != endEntry && itEntry->first == i)
+            {
+              Value = itEntry->second;
+              ++itEntry;
+            }
+
+          if (mStoi(i, j) != Value)
+            return false;
+        }
+    }
+
+  // Appended reactions keep the link matrix valid if they respect all conservation
+  // relations, i.e., N_dependent = L0 * N_independent holds for the new columns.
+  // Under this condition the rank of the stoichiometry matrix does not change.
+  const CVector< size_t > & Pivots = mLinkZero.getRowPivots();
+  size_t NumIndependent = mLinkZero.getNumIndependent();
+  size_t NumDependent = NumRows - NumIndependent;
+
+  for (j = NumOldCols; j < NumCols; ++j)
+    for (k = 0; k < NumDependent; ++k)
+      {
+        C_FLOAT64 Residual = mStoi(Pivots[NumIndependent + k], j);
+        C_FLOAT64 Scale = fabs(Residual);
+
+        for (i = 0; i < NumIndependent; ++i)
+          {
+            C_FLOAT64 Term = mLinkZero(k, i) * mStoi(Pivots[i], j);
+            Residual -= Term;
+            Scale += fabs(Term);
+          }
+
+        if (fabs(Residual) > 1000.0 * std::numeric_limits< C_FLOAT64 >::epsilon() * Scale)
+          return false;
+      }
+
+  return true;
+}
+
+bool CModel::saveStructuralAnalysis(std::ostream & os) const
+{
+  if (mLinkZeroColumns.size() != mLinkZeroReactions.size() + 1)
+    return false;
+
+  unsigned C_INT64 Size[3] = {mLinkZeroSpecies.size(), mLinkZeroReactions.size(), mLinkZeroEntries.size()};
+  os.write((const char *) Size, sizeof(Size));
+
+  // The rows and columns are identified by the common names of the species and
+  // reactions relative to the model.
+  std::vector< std::string > Names;
+  std::string::size_type Prefix = getCN().size() + 1;
+
+  std::vector< const CMetab * >::const_iterator itSpecies = mLinkZeroSpecies.begin();
+  std::vector< const CMetab * >::const_iterator endSpecies = mLinkZeroSpecies.end();
+
+  for (; itSpecies != endSpecies; ++itSpecies)
+    Names.push_back((*itSpecies)->getCN().substr(Prefix));
+
+  std::vector< const CReaction * >::const_iterator itReaction = mLinkZeroReactions.begin();
+  std::vector< const CReaction * >::const_iterator endReaction = mLinkZeroReactions.end();
+
+  for (; itReaction != endReaction; ++itReaction)
+    Names.push_back((*itReaction)->getCN().substr(Prefix));
+
+  std::vector< std::string >::const_iterator itName = Names.begin();
+  std::vector< std::string >::const_iterator endName = Names.end();
+
+  for (; itName != endName; ++itName)
+    {
+      unsigned C_INT32 Length = (unsigned C_INT32) itName->size();
+      os.write((const char *) &Length, sizeof(Length));
+      os.write(itName->c_str(), Length);
+    }
+
+  // The sparse stoichiometry matrix is written as column starts, row indexes, and values.
+  std::vector< size_t >::const_iterator itColumn = mLinkZeroColumns.begin();
+  std::vector< size_t >::const_iterator endColumn = mLinkZeroColumns.end();
+
+  for (; itColumn != endColumn; ++itColumn)
+    {
+      unsigned C_INT64 Start = *itColumn;
+      os.write((const char *) &Start, sizeof(Start));
+    }
+
+  std::vector< std::pair< size_t, C_FLOAT64 > >::const_iterator itEntry = mLinkZeroEntries.begin();
+  std::vector< std::pair< size_t, C_FLOAT64 > >::const_iterator endEntry = mLinkZeroEntries.end();
+
+  for (; itEntry != endEntry; ++itEntry)
+    {
+      unsigned C_INT64 Row = itEntry->first;
+      os.write((const char *) &Row, sizeof(Row));
+      os.write((const char *) &itEntry->second, sizeof(C_FLOAT64));
+    }
+
+  return mLinkZero.save(os);
+}
+
+bool CModel::loadStructuralAnalysis(std::istream & is)
+{
+  unsigned C_INT64 Size[3] = {0, 0, 0};
+  is.read((char *) Size, sizeof(Size));
+
+  if (is.fail())
+    return false;
+
+  // The snapshot must fit the current model and the stream must provide the
+  // data before we allocate memory for it. Each name takes at least its length,
+  // each column its start, and each entry its row and value.
+  unsigned C_INT64 Remaining = remainingBytes(is);
+
+  if (Size[0] > mMetabolites.size() ||
+      Size[1] > mSteps.size() ||
+      (Size[0] + Size[1]) * sizeof(unsigned C_INT32) + (Size[1] + 1) * sizeof(unsigned C_INT64) > Remaining ||
+      Size[2] > Size[0] * Size[1] ||
+      Size[2] > (Remaining - (Size[0] + Size[1]) * sizeof(unsigned C_INT32) - (Size[1] + 1) * sizeof(unsigned C_INT64)) / (sizeof(unsigned C_INT64) + sizeof(C_FLOAT64)))
+    return false;
+
+  std::vector< const CMetab * > Species;
+  std::vector< const CReaction * > Reactions;
+
+  for (unsigned C_INT64 i = 0; i < Size[0] + Size[1]; ++i)
+    {
+      unsigned C_INT32 Length = 0;
+      is.read((char *) &Length, sizeof(Length));
+
+      if (is.fail() || Length > remainingBytes(is))
+        return false;
+
+      std::string Name(Length, '\0');
+
+      if (Length > 0)
+        is.read(&Name[0], Length);
+
+      const CDataObject * pObject = CObjectInterface::DataObject(getObject(CCommonName(Name)));
+
+      if (i < Size[0])
+        Species.push_back(dynamic_cast< const CMetab * >(pObject));
+      else
+        Reactions.push_back(dynamic_cast< const CReaction * >(pObject));
+
+      // All species and reactions must still exist.
+      if (pObject == NULL ||
+          (i < Size[0] ? Species.back() == NULL : Reactions.back() == NULL))
+        return false;
+    }
+
+  // The column starts must be ascending and the rows within a column strictly ascending.
+  std::vector< size_t > Columns(Size[1] + 1);
+  std::vector< std::pair< size_t, C_FLOAT64 > > Entries(Size[2]);
+  size_t j, k;
+
+  for (j = 0; j <= Size[1]; ++j)
+    {
+      unsigned C_INT64 Start = 0;
+      is.read((char *) &Start, sizeof(Start));
+
+      if (is.fail() ||
+          Start > Size[2] ||
+          (j > 0 && Start < Columns[j - 1]) ||
+          (j == 0 && Start != 0) ||
+          (j == Size[1] && Start != Size[2]))
+        return false;
+
+      Columns[j] = Start;
+    }
+
+  for (j = 0; j < Size[1]; ++j)
+    for (k = Columns[j]; k < Columns[j + 1]; ++k)
+      {
+        unsigned C_INT64 Row = 0;
+        is.read((char *) &Row, sizeof(Row));
+        is.read((char *) &Entries[k].second, sizeof(C_FLOAT64));
+
+        if (is.fail() ||
+            Row >= Size[0] ||
+            (k > Columns[j] && Row <= Entries[k - 1].first))
+          return false;
+
+        Entries[k].first = Row;
+      }
+
+  CLinkMatrix LinkZero;
+
+  if (is.fail() ||
+      !LinkZero.load(is) ||
+      LinkZero.getRowPivots().size() != Size[0])
+    return false;
+
+  // The loaded data is used as if it were the result of the previous compile, i.e.,
+  // isLinkZeroValid decides whether it applies.
+  mLinkZeroColumns.swap(Columns);
+  mLinkZeroEntries.swap(Entries);
+  mLinkZeroSpecies.swap(Species);
+  mLinkZeroReactions.swap(Reactions);
+  mLinkZero = LinkZero;
+
+  return true;
+}
+
 const bool & CModel::isAutonomous() const
 {return mIsAutonomous;}
 
@@ -204,6 +204,23 @@ public:
    */
   bool forceCompile(CProcessReport* pProcessReport);
 
+  /**
+   * Write the result of the last structural analysis, i.e., the stoichiometry
+   * matrix with its species and reactions and the link matrix, in binary form
+   * @param std::ostream & os
+   * @return bool success
+   */
+  bool saveStructuralAnalysis(std::ostream & os) const;
+
+  /**
+   * Read the result of a structural analysis written with saveStructuralAnalysis.
+   * The next compile skips the factorization of the stoichiometry matrix if the
+   * loaded link matrix is valid for it.
+   * @param std::istream & is
+   * @return bool success
+   */
+  bool loadStructuralAnalysis(std::istream & is);
+
   bool buildDependencyGraphs();
 
   /**
@@ -1126,6 +1143,13 @@ public:
 
 private:
 
+  /**
+   * Compile the model. The link matrix of the previous compile is reused if it
+   * is still valid (see isLinkZeroValid()). All other parts, i.e., the
+   * stoichiometry, the state template, the dependency graphs, and the math
+   * container, are always rebuilt completely.
+   * @return CIssue issue
+   */
   CIssue compile();
 
   /**
@@ -1135,6 +1159,20 @@ private:
    */
   bool handleUnusedMetabolites();
 
+  /**
+   * Check whether the link matrix of the previous compile is valid for the current
+   * stoichiometry matrix. This is the case if the species determined by reactions are
+   * unchanged, the previously existing reactions are unchanged, and all appended
+   * reactions respect the conservation relations.
+   *
+   * Note, for appended reactions the row pivots of the previous factorization are
+   * kept, i.e., the choice of independent species depends on the order in which
+   * reactions were added. For an unchanged stoichiometry matrix the result is
+   * identical to a new factorization.
+   * @return bool isValid
+   */
+  bool isLinkZeroValid() const;
+
   /**
    * Initialize the contained CDataObjects
    */
@@ -1355,6 +1393,34 @@ private:
    */
   CLinkMatrixView mLView;
 
+  /**
+   * The start of each column in mLinkZeroEntries followed by the total number of
+   * entries. Together they form the sparse stoichiometry matrix (before pivoting)
+   * for which mLinkZero is valid.
+   */
+  std::vector< size_t > mLinkZeroColumns;
+
+  /**
+   * The row index and value of the non zero stoichiometries ordered by column and row
+   */
+  std::vector< std::pair< size_t, C_FLOAT64 > > mLinkZeroEntries;
+
+  /**
+   * The species corresponding to the rows of the sparse stoichiometry matrix
+   */
+  std::vector< const CMetab * > mLinkZeroSpecies;
+
+  /**
+   * The reactions corresponding to the columns of the sparse stoichiometry matrix
+   */
+  std::vector< const CReaction * > mLinkZeroReactions;
+
+  /**
+   * The link matrix including its row pivots of the last structural analysis.
+   * Note, mL loses its pivots at the end of the compile.
+   */
+  CLinkMatrix mLinkZero;
+
   /**
    *  The Avogadro number used for this model.
    */
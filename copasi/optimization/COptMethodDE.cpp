@@ -42,6 +42,7 @@ COptMethodDE::COptMethodDE(const CDataContainer * pParent,
   addParameter("Seed", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0, eUserInterfaceFlag::editable);
   addParameter("Mutation Variance", CCopasiParameter::Type::DOUBLE, (C_FLOAT64) 0.1, eUserInterfaceFlag::editable);
   addParameter("Stop after # Stalled Generations", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0, eUserInterfaceFlag::editable);
+  addParameter("Early Termination of Simulations", CCopasiParameter::Type::BOOL, false, eUserInterfaceFlag::editable);
 
   initObjects();
 }
@@ -87,7 +88,11 @@ bool COptMethodDE::replicate()
 
   bool Continue = true;
 
-  for (i = mPopulationSize; i < 2 * mPopulationSize && Continue; i++)
+  // A trial only replaces its parent if it is better, i.e., trials worse than
+  // all parents need not be simulated completely.
+  updateObjectiveBound();
+
+  for (i = mPopulationSize; i < 2 * mPopulationSize; i++)
     {
       mpPermutation->shuffle(3);
 
@@ -122,11 +127,10 @@ bool COptMethodDE::replicate()
           // account of the value.
           *mContainerVariables[j] = mut;
         }
-
-      Continue &= evaluate(*mIndividuals[i]);
-      mValues[i] = mEvaluationValue;
     }
 
+  Continue &= evaluatePopulation(mPopulationSize, 2 * mPopulationSize);
+
   //CROSSOVER MUTATED GENERATION WITH THE CURRENT ONE
   for (i = 2 * mPopulationSize; i < 3 * mPopulationSize && Continue; i++)
     {
@@ -161,11 +165,14 @@ bool COptMethodDE::replicate()
 
           *mContainerVariables[j] = mut;
         }
-
-      Continue &= evaluate(*mIndividuals[i]);
-      mValues[i] = mEvaluationValue;
     }
 
+  if (Continue)
+    Continue &= evaluatePopulation(2 * mPopulationSize, 3 * mPopulationSize);
+
+  // Replacements of parents which are not trials must be evaluated exactly.
+  mpOptProblem->setObjectiveBound(std::numeric_limits< C_FLOAT64 >::infinity());
+
   //SELECT NEXT GENERATION
   for (i = 2 * mPopulationSize; i < 3 * mPopulationSize && Continue; i++)
     {
@@ -255,7 +262,7 @@ bool COptMethodDE::creation(size_t first, size_t last)
 
   bool Continue = true;
 
-  for (i = first; i < Last && Continue; i++)
+  for (i = first; i < Last; i++)
     {
       // We do not want to loose the best individual;
       if (mBestIndex != i)
@@ -305,12 +312,11 @@ bool COptMethodDE::creation(size_t first, size_t last)
             // account of the value.
             *mContainerVariables[j] = mut;
           }
-
-      // calculate its fitness
-      Continue &= evaluate(*mIndividuals[i]);
-      mValues[i] = mEvaluationValue;
     }
 
+  // calculate their fitness
+  Continue &= evaluatePopulation(first, Last);
+
   return Continue;
 }
 
@@ -407,12 +407,12 @@ bool COptMethodEP::creation()
           // Set the variance for this parameter.
           (*mVariance[i])[j] = fabs(mut) * 0.5;
         }
-
-      // calculate its fitness
-      Continue = evaluate(*mIndividuals[i]);
-      mValues[i] = mEvaluationValue;
     }
 
+  // calculate their fitness
+  if (mPopulationSize > 1)
+    Continue = evaluatePopulation(1, mPopulationSize);
+
   return Continue;
 }
 
@@ -498,7 +498,7 @@ bool COptMethodEP::replicate()
   bool Continue = true;
 
   // iterate over parents
-  for (i = 0; i < mPopulationSize && Continue; i++)
+  for (i = 0; i < mPopulationSize; i++)
     {
       // replicate them
       for (j = 0; j < mVariableSize; j++)
@@ -510,13 +510,16 @@ bool COptMethodEP::replicate()
       mValues[mPopulationSize + i] = mValues[i];
 
       // possibly mutate the offspring
-      Continue = mutate(mPopulationSize + i);
+      mutate(mPopulationSize + i);
     }
 
+  // calculate the fitness of the offspring
+  Continue = evaluatePopulation(mPopulationSize, 2 * mPopulationSize);
+
   return Continue;
 }
 
-bool COptMethodEP::mutate(size_t i)
+void COptMethodEP::mutate(size_t i)
 {
   size_t j;
   C_FLOAT64 v1;
@@ -563,12 +566,6 @@ bool COptMethodEP::mutate(size_t i)
       // account of the value.
       *mContainerVariables[j] = mut;
     }
-
-  // calculate its fitness
-  bool Continue = evaluate(Individual);
-  mValues[i] = mEvaluationValue;
-
-  return Continue;
 }
 
 unsigned C_INT32 COptMethodEP::getMaxLogVerbosity() const
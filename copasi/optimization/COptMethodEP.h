@@ -59,11 +59,10 @@ private:
   void initObjects();
 
   /**
-   * Mutate one individual
-   * @param CVector< C_FLOAT64 > & individual
-   * @return bool success
+   * Mutate one individual. The individual is not evaluated.
+   * @param size_t i
    */
-  bool mutate(size_t i);
+  void mutate(size_t i);
 
   /**
    * Swap individuals from and to
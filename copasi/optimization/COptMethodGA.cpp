@@ -60,6 +60,7 @@ COptMethodGA::COptMethodGA(const CDataContainer * pParent,
   addParameter("Seed", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0, eUserInterfaceFlag::editable);
   addParameter("Mutation Variance", CCopasiParameter::Type::DOUBLE, (C_FLOAT64) 0.1, eUserInterfaceFlag::editable);
   addParameter("Stop after # Stalled Generations", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0, eUserInterfaceFlag::editable);
+  addMigrationParameters();
 
   initObjects();
 }
@@ -225,12 +226,11 @@ bool COptMethodGA::replicate()
     *mIndividuals[2 * mPopulationSize - 1] = *mIndividuals[mPopulationSize - 1];
 
   // mutate the offspring
-  for (i = mPopulationSize; i < 2 * mPopulationSize && Continue; i++)
-    {
-      mutate(*mIndividuals[i]);
-      Continue &= evaluate(*mIndividuals[i]);
-      mValues[i] = mEvaluationValue;
-    }
+  for (i = mPopulationSize; i < 2 * mPopulationSize; i++)
+    mutate(*mIndividuals[i]);
+
+  // calculate the fitness of the offspring
+  Continue &= evaluatePopulation(mPopulationSize, 2 * mPopulationSize);
 
   return Continue;
 }
@@ -348,7 +348,7 @@ bool COptMethodGA::creation(size_t first,
 
   bool Continue = true;
 
-  for (i = first; i < Last && Continue; i++)
+  for (i = first; i < Last; i++)
     {
       for (j = 0; j < mVariableSize; j++)
         {
@@ -397,11 +397,11 @@ bool COptMethodGA::creation(size_t first,
           *mContainerVariables[j] = mut;
         }
 
-      // calculate its fitness
-      Continue &= evaluate(*mIndividuals[i]);
-      mValues[i] = mEvaluationValue;
     }
 
+  // calculate their fitness
+  Continue &= evaluatePopulation(first, Last);
+
   return Continue;
 }
 
@@ -611,6 +611,18 @@ bool COptMethodGA::optimise()
       // select the most fit
       Continue &= select();
 
+      // exchange individuals with the other islands
+      std::vector< size_t > Immigrants = migrate();
+      std::vector< size_t >::const_iterator itImmigrant = Immigrants.begin();
+      std::vector< size_t >::const_iterator endImmigrant = Immigrants.end();
+
+      for (; itImmigrant != endImmigrant && Continue; ++itImmigrant)
+        {
+          setContainerVariables(*mIndividuals[*itImmigrant]);
+          Continue &= evaluate(*mIndividuals[*itImmigrant]);
+          mValues[*itImmigrant] = mEvaluationValue;
+        }
+
       // get the index of the fittest
       mBestIndex = fittest();
 
@@ -209,15 +209,15 @@ bool COptMethodGASR::replicate()
     *mIndividuals[2 * mPopulationSize - 1] = *mIndividuals[mPopulationSize - 1];
 
   // mutate the offspring
-  for (i = mPopulationSize; i < 2 * mPopulationSize && Continue; i++)
-    {
-      mutate(*mIndividuals[i]);
-      Continue = evaluate(*mIndividuals[i]);
-      mValues[i] = mEvaluationValue;
+  for (i = mPopulationSize; i < 2 * mPopulationSize; i++)
+    mutate(*mIndividuals[i]);
 
-      /* Calculate the phi value of the individual for SR*/
-      mPhi[i] = phi(i);
-    }
+  // calculate the fitness of the offspring
+  Continue = evaluatePopulation(mPopulationSize, 2 * mPopulationSize, mPhi.array() + mPopulationSize);
+
+  /* Calculate the phi value of the individuals for SR*/
+  for (i = mPopulationSize; i < 2 * mPopulationSize; i++)
+    mPhi[i] = phi(i, mPhi[i]);
 
   return Continue;
 }
@@ -270,6 +270,25 @@ bool COptMethodGASR::select()
 
 // evaluate the distance of parameters and constraints to boundaries
 C_FLOAT64 COptMethodGASR::phi(size_t indivNum)
+{
+  C_FLOAT64 constraintViolation = 0.0;
+  C_FLOAT64 phiCalc;
+
+  std::vector< COptItem * >::const_iterator it = mpOptContraints->begin();
+  std::vector< COptItem * >::const_iterator end = mpOptContraints->end();
+
+  for (; it != end; ++it)
+    {
+      phiCalc = (*it)->getConstraintViolation();
+
+      if (phiCalc > 0.0)
+        constraintViolation += phiCalc * phiCalc;
+    }
+
+  return phi(indivNum, constraintViolation);
+}
+
+C_FLOAT64 COptMethodGASR::phi(size_t indivNum, const C_FLOAT64 & constraintViolation)
 {
   C_FLOAT64 phiVal = 0.0;
   C_FLOAT64 phiCalc;
@@ -278,9 +297,10 @@ C_FLOAT64 COptMethodGASR::phi(size_t indivNum)
   std::vector< COptItem * >::const_iterator end = mpOptItem->end();
   C_FLOAT64 * pValue = mIndividuals[indivNum]->array();
 
+  // The individual need not be the current point of the container.
   for (; it != end; ++it, pValue++)
     {
-      switch ((*it)->checkConstraint())
+      switch ((*it)->checkConstraint(*pValue))
         {
           case - 1:
             phiCalc = *(*it)->getLowerBoundValue() - *pValue;
@@ -294,18 +314,7 @@ C_FLOAT64 COptMethodGASR::phi(size_t indivNum)
         }
     }
 
-  it = mpOptContraints->begin();
-  end = mpOptContraints->end();
-
-  for (; it != end; ++it)
-    {
-      phiCalc = (*it)->getConstraintViolation();
-
-      if (phiCalc > 0.0)
-        phiVal += phiCalc * phiCalc;
-    }
-
-  return phiVal;
+  return phiVal + constraintViolation;
 }
 
 // check the best individual at this generation
@@ -339,7 +348,7 @@ bool COptMethodGASR::creation(size_t first,
 
   bool Continue = true;
 
-  for (i = first; i < Last && Continue; i++)
+  for (i = first; i < Last; i++)
     {
       for (j = 0; j < mVariableSize; j++)
         {
@@ -376,14 +385,15 @@ bool COptMethodGASR::creation(size_t first,
           *mContainerVariables[j] = mut;
         }
 
-      // calculate its fitness
-      Continue = evaluate(*mIndividuals[i]);
-      mValues[i] = mEvaluationValue;
-
-      /* Calculate the phi value of the individual for SR*/
-      mPhi[i] = phi(i);
     }
 
+  // calculate their fitness
+  Continue = evaluatePopulation(first, Last, mPhi.array() + first);
+
+  /* Calculate the phi value of the individuals for SR*/
+  for (i = first; i < Last; i++)
+    mPhi[i] = phi(i, mPhi[i]);
+
   return Continue;
 }
 
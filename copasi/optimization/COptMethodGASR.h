@@ -161,6 +161,15 @@ private:
    */
   C_FLOAT64 phi(size_t indvNum);
 
+  /**
+   * For Stochastic Ranking, evaluate the distance of parameters to boundaries
+   * for an individual with known sum of squared functional constraint violations
+   * @param size_t indvNum
+   * @param const C_FLOAT64 & constraintViolation
+   * @return C_FLOAT64 phiVal
+   */
+  C_FLOAT64 phi(size_t indvNum, const C_FLOAT64 & constraintViolation);
+
   // Attributes
 private:
 
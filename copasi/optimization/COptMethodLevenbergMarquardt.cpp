@@ -39,6 +39,7 @@ define(1.57079633)
 
 #include "parameterFitting/CFitProblem.h"
 #include "copasi/core/CDataObjectReference.h"
+#include "math/CMathContainer.h"
 
 #include "lapack/lapackwrap.h"
 #include "lapack/blaswrap.h"
@@ -69,7 +70,10 @@ COptMethodLevenbergMarquardt::COptMethodLevenbergMarquardt(const CDataContainer
 	mStopAfterStalledIterations(0),
 	mContinue(true),
 	mHaveResiduals(false),
-	mResidualJacobianT()
+	mResidualJacobianT(),
+	mWorkers(false),
+	mKeepWorkers(false),
+	mWorkersCreated(false)
 {
 	addParameter("Iteration Limit", CCopasiParameter::Type::UINT, (unsigned C_INT32) 2000);
 	addParameter("Tolerance", CCopasiParameter::Type::DOUBLE, (C_FLOAT64) 1.e-006);
@@ -101,7 +105,10 @@ COptMethodLevenbergMarquardt::COptMethodLevenbergMarquardt(const COptMethodLeven
 	mStopAfterStalledIterations(0),
 	mContinue(true),
 	mHaveResiduals(false),
-	mResidualJacobianT()
+	mResidualJacobianT(),
+	mWorkers(false),
+	mKeepWorkers(false),
+	mWorkersCreated(false)
 {
 	initObjects();
 }
@@ -109,6 +116,18 @@ COptMethodLevenbergMarquardt::COptMethodLevenbergMarquardt(const COptMethodLeven
 COptMethodLevenbergMarquardt::~COptMethodLevenbergMarquardt()
 {
 	cleanup();
+	destroyWorkers();
+}
+
+void COptMethodLevenbergMarquardt::setKeepWorkers(const bool & keepWorkers)
+{
+	mKeepWorkers = keepWorkers;
+
+	if (!mKeepWorkers)
+	{
+		destroyWorkers();
+		mWorkersCreated = false;
+	}
 }
 
 void COptMethodLevenbergMarquardt::initObjects()
@@ -459,6 +478,9 @@ bool COptMethodLevenbergMarquardt::optimise()
 
 bool COptMethodLevenbergMarquardt::cleanup()
 {
+	if (!mKeepWorkers)
+		destroyWorkers();
+
 	return true;
 }
 
@@ -522,6 +544,13 @@ bool COptMethodLevenbergMarquardt::initialize()
 		mHaveResiduals = true;
 		pFitProblem->setResidualsRequired(true);
 		mResidualJacobianT.resize(mVariableSize, pFitProblem->getResiduals().size());
+
+		// Copying the containers is expensive, i.e., kept workers are created only once.
+		if (!mKeepWorkers || !mWorkersCreated)
+		{
+			createWorkers(pFitProblem);
+			mWorkersCreated = mKeepWorkers;
+		}
 	}
 	else
 		mHaveResiduals = false;
@@ -594,32 +623,35 @@ void COptMethodLevenbergMarquardt::hessian()
 		C_FLOAT64 Delta;
 		C_FLOAT64 x;
 
-		for (i = 0; i < mVariableSize && mContinue; i++)
-		{
-			//REVIEW:START
-			if ((x = mCurrent[i]) != 0.0)
+		if (mWorkers.isParallel())
+			parallelResidualJacobian(CurrentResiduals);
+		else
+			for (i = 0; i < mVariableSize && mContinue; i++)
 			{
-				Delta = 1.0 / (x * mModulation);
-				*mContainerVariables[i] = atanC((x * mod1), i);
-			}
+				//REVIEW:START
+				if ((x = mCurrent[i]) != 0.0)
+				{
+					Delta = 1.0 / (x * mModulation);
+					*mContainerVariables[i] = atanC((x * mod1), i);
+				}
 
-			else
-			{
-				Delta = 1.0 / mModulation;
-				*mContainerVariables[i] = atanC((mModulation), i);
-				//REVIEW:END
-			}
+				else
+				{
+					Delta = 1.0 / mModulation;
+					*mContainerVariables[i] = atanC((mModulation), i);
+					//REVIEW:END
+				}
 
-			// evaluate another column of the Jacobian
-			evaluate();
-			pCurrentResiduals = CurrentResiduals.array();
-			pResiduals = Residuals.array();
+				// evaluate another column of the Jacobian
+				evaluate();
+				pCurrentResiduals = CurrentResiduals.array();
+				pResiduals = Residuals.array();
 
-			for (; pCurrentResiduals != pEnd; pCurrentResiduals++, pResiduals++, pJacobianT++)
-				*pJacobianT = (*pResiduals - *pCurrentResiduals) * Delta;
+				for (; pCurrentResiduals != pEnd; pCurrentResiduals++, pResiduals++, pJacobianT++)
+					*pJacobianT = (*pResiduals - *pCurrentResiduals) * Delta;
 
-			*mContainerVariables[i] = atanC(x, i);
-		}
+				*mContainerVariables[i] = atanC(x, i);
+			}
 
 #ifdef XXXX
 		// calculate the gradient
@@ -725,6 +757,120 @@ void COptMethodLevenbergMarquardt::hessian()
 			mHessian[i][j] = mHessian[j][i];
 }
 
+void COptMethodLevenbergMarquardt::createWorkers(const CFitProblem * pFitProblem)
+{
+	destroyWorkers();
+
+	// Each worker requires its own copy of the container and the problem, which is
+	// only worth the effort if there are multiple columns to evaluate.
+	mWorkers.init(mpContainer != NULL && mVariableSize > 1);
+
+	if (!mWorkers.isParallel()) return;
+
+	sWorker * pWorker = mWorkers.beginThread();
+	sWorker * pWorkerEnd = mWorkers.endThread();
+
+	for (; pWorker != pWorkerEnd; ++pWorker)
+	{
+		pWorker->pContainer = new CMathContainer(*mpContainer);
+		pWorker->pProblem = pFitProblem->createWorker(pWorker->pContainer);
+
+		if (pWorker->pProblem == NULL ||
+			pWorker->pProblem->getResiduals().size() != mResidualJacobianT.numCols())
+		{
+			// Fall back to the serial calculation.
+			destroyWorkers();
+			return;
+		}
+	}
+}
+
+void COptMethodLevenbergMarquardt::destroyWorkers()
+{
+	sWorker * pWorker = mWorkers.beginThread();
+	sWorker * pWorkerEnd = mWorkers.endThread();
+
+	for (; pWorker != pWorkerEnd; ++pWorker)
+	{
+		// The problem refers to the container and must be destroyed first.
+		pdelete(pWorker->pProblem);
+		pdelete(pWorker->pContainer);
+	}
+
+	mWorkers.init(false);
+}
+
+void COptMethodLevenbergMarquardt::parallelResidualJacobian(const CVector< C_FLOAT64 > & currentResiduals)
+{
+	C_FLOAT64 mod1 = 1.0 + mModulation;
+
+	// The parameter transformation is not reentrant, i.e., we determine the
+	// container values of the current and perturbed parameters beforehand.
+	CVector< C_FLOAT64 > Values(mVariableSize);
+	CVector< C_FLOAT64 > Perturbed(mVariableSize);
+	CVector< C_FLOAT64 > Delta(mVariableSize);
+
+	size_t i;
+	C_FLOAT64 x;
+
+	for (i = 0; i < mVariableSize; i++)
+	{
+		Values[i] = atanC((x = mCurrent[i]), i);
+
+		if (x != 0.0)
+		{
+			Delta[i] = 1.0 / (x * mModulation);
+			Perturbed[i] = atanC((x * mod1), i);
+		}
+		else
+		{
+			Delta[i] = 1.0 / mModulation;
+			Perturbed[i] = atanC((mModulation), i);
+		}
+	}
+
+	size_t ResidualSize = currentResiduals.size();
+	C_INT32 Size = (C_INT32) mVariableSize;
+	C_INT32 Column;
+	bool Continue = true;
+
+	// Each column is written in place into the row of the transposed Jacobian
+	// owned by the evaluating thread.
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic) reduction(&& : Continue)
+#endif // USE_OMP
+
+	for (Column = 0; Column < Size; Column++)
+	{
+		CFitProblem * pProblem = mWorkers.active().pProblem;
+
+		C_FLOAT64 ** ppVariable = pProblem->getContainerVariables().array();
+		C_FLOAT64 ** ppVariableEnd = ppVariable + mVariableSize;
+		const C_FLOAT64 * pValue = Values.array();
+
+		for (; ppVariable != ppVariableEnd; ++ppVariable, ++pValue)
+			**ppVariable = *pValue;
+
+		*pProblem->getContainerVariables()[Column] = Perturbed[Column];
+
+		Continue = pProblem->calculate() && Continue;
+
+		const C_FLOAT64 * pResiduals = pProblem->getResiduals().array();
+		const C_FLOAT64 * pCurrentResiduals = currentResiduals.array();
+		const C_FLOAT64 * pEnd = pCurrentResiduals + ResidualSize;
+		C_FLOAT64 * pJacobianT = mResidualJacobianT[Column];
+		const C_FLOAT64 & ColumnDelta = Delta[Column];
+
+		for (; pCurrentResiduals != pEnd; pCurrentResiduals++, pResiduals++, pJacobianT++)
+			*pJacobianT = (*pResiduals - *pCurrentResiduals) * ColumnDelta;
+	}
+
+	mContinue &= Continue;
+
+	// Account for the evaluations performed by the workers.
+	mpOptProblem->incrementEvaluations(mVariableSize);
+}
+
 unsigned C_INT32 COptMethodLevenbergMarquardt::getMaxLogVerbosity() const
 {
 	return 1;
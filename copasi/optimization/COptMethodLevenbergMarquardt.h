@@ -27,9 +27,11 @@
 #include <vector>
 
 #include "copasi/core/CMatrix.h"
+#include "copasi/core/CContext.h"
 #include "optimization/COptMethod.h"
 
 class CRandom;
+class CFitProblem;
 
 class COptMethodLevenbergMarquardt : public COptMethod
 {
@@ -71,6 +73,15 @@ public:
    */
   virtual unsigned C_INT32 getMaxLogVerbosity() const;
 
+  /**
+   * Keep the workers for the parallel calculation of the Jacobian between runs,
+   * e.g., for repeated local searches on the same problem. The workers are
+   * created by the first run and destroyed when keeping is disabled or the
+   * method is destroyed.
+   * @param const bool & keepWorkers
+   */
+  void setKeepWorkers(const bool & keepWorkers);
+
 private:
   /**
    * Default Constructor
@@ -110,6 +121,25 @@ private:
    */
   void hessian();
 
+  /**
+   * Create a worker for each thread if the problem supports workers,
+   * otherwise the Jacobian of the residuals is calculated serially.
+   * @param const CFitProblem * pFitProblem
+   */
+  void createWorkers(const CFitProblem * pFitProblem);
+
+  /**
+   * Destroy the workers
+   */
+  void destroyWorkers();
+
+  /**
+   * Calculate the transposed Jacobian of the residuals by evaluating the
+   * columns concurrently on the workers.
+   * @param const CVector< C_FLOAT64 > & currentResiduals
+   */
+  void parallelResidualJacobian(const CVector< C_FLOAT64 > & currentResiduals);
+
   void tanC();
   void getBoundarys();
   C_FLOAT64 atanC(C_FLOAT64, int i);
@@ -225,7 +255,35 @@ private:
    */
   CMatrix< C_FLOAT64 > mResidualJacobianT;
 
-  
+  /**
+   * A worker evaluates the residuals for a perturbed parameter on its own
+   * copy of the math container.
+   */
+  struct sWorker
+  {
+    sWorker():
+      pContainer(NULL),
+      pProblem(NULL)
+    {}
+
+    CMathContainer * pContainer;
+    CFitProblem * pProblem;
+  };
+
+  /**
+   * The workers of the threads evaluating the columns of the Jacobian
+   */
+  CContext< sWorker > mWorkers;
+
+  /**
+   * Indicates whether the workers are kept between runs
+   */
+  bool mKeepWorkers;
+
+  /**
+   * Indicates whether the kept workers have been created
+   */
+  bool mWorkersCreated;
 };
 
 #endif  // COPASI_COptMethodLevenbergMarquardt
@@ -97,13 +97,11 @@ const C_FLOAT64 & COptMethodPS::evaluate()
 }
 
 // move an individual
-bool COptMethodPS::move(const size_t & index)
+void COptMethodPS::move(const size_t & index)
 {
   const C_FLOAT64 w = 1 / (2 * log(2.0));
   const C_FLOAT64 c = 0.5 + log(2.0);
 
-  bool Improved = false;
-
   C_FLOAT64 * pIndividual = mIndividuals[index]->array();
   C_FLOAT64 * pEnd = pIndividual + mVariableSize;
   C_FLOAT64 * pVelocity = mVelocities[index];
@@ -155,21 +153,24 @@ bool COptMethodPS::move(const size_t & index)
       // account of the value.
       **ppContainerVariable = *pIndividual;
     }
+}
 
-  // calculate its fitness
-  mValues[index] = evaluate();
+// update the best values with the fitness of an individual
+bool COptMethodPS::update(const size_t & index)
+{
+  bool Improved = false;
 
   // Check if we improved individually
-  if (mEvaluationValue < mBestValues[index])
+  if (mValues[index] < mBestValues[index])
     {
       Improved = true;
 
       // Save the individually best value;
-      mBestValues[index] = mEvaluationValue;
+      mBestValues[index] = mValues[index];
       memcpy(mBestPositions[index], mIndividuals[index]->array(), sizeof(C_FLOAT64) * mVariableSize);
 
       // Check if we improved globally
-      if (mEvaluationValue < mBestValues[mBestIndex])
+      if (mValues[index] < mBestValues[mBestIndex])
         {
           // and store that value
           mBestIndex = index;
@@ -184,7 +185,7 @@ bool COptMethodPS::move(const size_t & index)
 }
 
 // initialise an individual
-bool COptMethodPS::create(const size_t & index)
+void COptMethodPS::create(const size_t & index)
 {
   C_FLOAT64 * pIndividual = mIndividuals[index]->array();
   C_FLOAT64 * pEnd = pIndividual + mVariableSize;
@@ -296,20 +297,8 @@ bool COptMethodPS::create(const size_t & index)
       **ppContainerVariable = *pIndividual;
     }
 
-  // calculate its fitness
-  mBestValues[index] = mValues[index] = evaluate();
-
-  if (mBestValues[index] < mBestValues[mBestIndex])
-    {
-      // and store that value
-      mBestIndex = index;
-      mContinue &= mpOptProblem->setSolution(mBestValues[index], *mIndividuals[index]);
-
-      // We found a new best value lets report it.
-      mpParentTask->output(COutputInterface::DURING);
-    }
-
-  return mContinue;
+  // The best position is the current one once the individual is evaluated.
+  mBestValues[index] = std::numeric_limits< C_FLOAT64 >::infinity();
 }
 
 void COptMethodPS::initObjects()
@@ -556,9 +545,42 @@ bool COptMethodPS::optimise()
   // We found a new best value lets report it.
   mpParentTask->output(COutputInterface::DURING);
 
+  // The particles are moved and evaluated one at a time unless the problem
+  // calculates batches concurrently. Evaluating a batch requires to update the
+  // swarm synchronously, which changes the course of the optimization.
+  bool Synchronous = mpOptProblem->isBatchParallel();
+
   // the others are random
-  for (i = 1; i < mPopulationSize && mContinue; i++)
-    create(i);
+  for (i = 1; i < mPopulationSize && (Synchronous || mContinue); i++)
+    {
+      create(i);
+
+      if (Synchronous)
+        continue;
+
+      // calculate its fitness
+      mBestValues[i] = mValues[i] = evaluate();
+
+      if (mBestValues[i] < mBestValues[mBestIndex])
+        {
+          // and store that value
+          mBestIndex = i;
+          mContinue &= mpOptProblem->setSolution(mBestValues[i], *mIndividuals[i]);
+
+          // We found a new best value lets report it.
+          mpParentTask->output(COutputInterface::DURING);
+        }
+    }
+
+  if (Synchronous)
+    {
+      // calculate their fitness
+      if (mContinue)
+        mContinue &= evaluatePopulation(1, mPopulationSize);
+
+      for (i = 1; i < mPopulationSize; i++)
+        update(i);
+    }
 
   // create the informant list
   buildInformants();
@@ -576,8 +598,26 @@ bool COptMethodPS::optimise()
       Improved = false;
       size_t oldIndex = mBestIndex;
 
-      for (i = 0; i < mPopulationSize && mContinue; i++)
-        Improved |= move(i);
+      if (Synchronous)
+        {
+          // All individuals are moved before they are evaluated as a batch.
+          for (i = 0; i < mPopulationSize; i++)
+            move(i);
+
+          mContinue &= evaluatePopulation(0, mPopulationSize);
+
+          for (i = 0; i < mPopulationSize; i++)
+            Improved |= update(i);
+        }
+      else
+        {
+          for (i = 0; i < mPopulationSize && mContinue; i++)
+            {
+              move(i);
+              mValues[i] = evaluate();
+              Improved |= update(i);
+            }
+        }
 
       if (!Improved)
         {
@@ -102,18 +102,24 @@ private:
   const C_FLOAT64 & evaluate();
 
   /**
-   * Move the indexed individual in the swarm
+   * Move the indexed individual in the swarm. The individual is not evaluated.
    * @param const size_t & index
-   * @return bool continue
    */
-  bool move(const size_t & index);
+  void move(const size_t & index);
 
   /**
-   * Create the indexed individual in the swarm
+   * Update the individually and globally best values and positions with the
+   * value of the indexed individual
    * @param const size_t & index
-   * @return bool continue
+   * @return bool improved
    */
-  bool create(const size_t & index);
+  bool update(const size_t & index);
+
+  /**
+   * Create the indexed individual in the swarm. The individual is not evaluated.
+   * @param const size_t & index
+   */
+  void create(const size_t & index);
 
   /**
    * create the informant for each individual
@@ -52,6 +52,7 @@ COptMethodSRES::COptMethodSRES(const CDataContainer * pParent,
   addParameter("Seed", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0, eUserInterfaceFlag::editable);
   addParameter("Pf", CCopasiParameter::Type::DOUBLE, (C_FLOAT64) 0.475);  //*****ADDED for SR
   addParameter("Stop after # Stalled Generations", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0, eUserInterfaceFlag::editable);
+  addMigrationParameters();
 
   initObjects();
 }
@@ -161,15 +162,13 @@ bool COptMethodSRES::mutate()
   std::vector< CVector < C_FLOAT64 > * >::iterator itVariance = mVariance.begin() + mPopulationSize;
 
   C_FLOAT64 * pVariable, * pVariableEnd, * pVariance, * pMaxVariance;
-  C_FLOAT64 * pPhi = mPhi.array() + mPopulationSize;
-  C_FLOAT64 * pValue = mValues.array() + mPopulationSize;
 
   bool Continue = true;
   size_t i, j;
   C_FLOAT64 v1;
 
   // Mutate each new individual
-  for (i = mPopulationSize; it != end && Continue; ++it, ++itVariance, ++i)
+  for (i = mPopulationSize; it != end; ++it, ++itVariance, ++i)
     {
       pVariable = (*it)->array();
       pVariableEnd = pVariable + mVariableSize;
@@ -215,13 +214,14 @@ bool COptMethodSRES::mutate()
           // account of the value.
           *mContainerVariables[j] = (mut);
         }
-
-      // calculate its fitness
-      Continue = evaluate(**it);
-      *pValue++ = mEvaluationValue;
-      *pPhi++ = phi(i);
     }
 
+  // calculate the fitness of the new individuals
+  Continue = evaluatePopulation(mPopulationSize, mIndividuals.size(), mPhi.array() + mPopulationSize);
+
+  for (i = mPopulationSize; i < mIndividuals.size(); i++)
+    mPhi[i] = phi(i, mPhi[i]);
+
   return Continue;
 }
 
@@ -484,11 +484,15 @@ bool COptMethodSRES::creation(size_t first)
           // Set the variance for this parameter.
           *pVariance = std::min(*OptItem.getUpperBoundValue() - mut, mut - *OptItem.getLowerBoundValue()) / sqrt(double(mVariableSize));
         }
+    }
 
-      // calculate its fitness
-      Continue = evaluate(**it);
-      *pValue++ = mEvaluationValue;
-      *pPhi++ = phi(i);
+  // calculate their fitness
+  if (first < mPopulationSize)
+    {
+      Continue = evaluatePopulation(first, mPopulationSize, mPhi.array() + first);
+
+      for (i = first; i < mPopulationSize; i++)
+        mPhi[i] = phi(i, mPhi[i]);
     }
 
   return Continue;
@@ -586,6 +590,25 @@ bool COptMethodSRES::cleanup()
 
 // evaluate the distance of parameters and constraints to boundaries
 C_FLOAT64 COptMethodSRES::phi(size_t indivNum)
+{
+  C_FLOAT64 constraintViolation = 0.0;
+  C_FLOAT64 phiCalc;
+
+  std::vector< COptItem * >::const_iterator it = mpOptContraints->begin();
+  std::vector< COptItem * >::const_iterator end = mpOptContraints->end();
+
+  for (; it != end; ++it)
+    {
+      phiCalc = (*it)->getConstraintViolation();
+
+      if (phiCalc > 0.0)
+        constraintViolation += phiCalc * phiCalc;
+    }
+
+  return phi(indivNum, constraintViolation);
+}
+
+C_FLOAT64 COptMethodSRES::phi(size_t indivNum, const C_FLOAT64 & constraintViolation)
 {
   C_FLOAT64 phiVal = 0.0;
   C_FLOAT64 phiCalc;
@@ -594,9 +617,10 @@ C_FLOAT64 COptMethodSRES::phi(size_t indivNum)
   std::vector< COptItem * >::const_iterator end = mpOptItem->end();
   C_FLOAT64 * pValue = mIndividuals[indivNum]->array();
 
+  // The individual need not be the current point of the container.
   for (; it != end; ++it, pValue++)
     {
-      switch ((*it)->checkConstraint())
+      switch ((*it)->checkConstraint(*pValue))
         {
           case - 1:
             phiCalc = *(*it)->getLowerBoundValue() - *pValue;
@@ -610,18 +634,7 @@ C_FLOAT64 COptMethodSRES::phi(size_t indivNum)
         }
     }
 
-  it = mpOptContraints->begin();
-  end = mpOptContraints->end();
-
-  for (; it != end; ++it)
-    {
-      phiCalc = (*it)->getConstraintViolation();
-
-      if (phiCalc > 0.0)
-        phiVal += phiCalc * phiCalc;
-    }
-
-  return phiVal;
+  return phiVal + constraintViolation;
 }
 
 bool COptMethodSRES::optimise()
@@ -728,6 +741,19 @@ bool COptMethodSRES::optimise()
       // select the most fit
       select();
 
+      // exchange individuals with the other islands
+      std::vector< size_t > Immigrants = migrate();
+      std::vector< size_t >::const_iterator itImmigrant = Immigrants.begin();
+      std::vector< size_t >::const_iterator endImmigrant = Immigrants.end();
+
+      for (; itImmigrant != endImmigrant && Continue; ++itImmigrant)
+        {
+          setContainerVariables(*mIndividuals[*itImmigrant]);
+          Continue &= evaluate(*mIndividuals[*itImmigrant]);
+          mValues[*itImmigrant] = mEvaluationValue;
+          mPhi[*itImmigrant] = phi(*itImmigrant);
+        }
+
       // get the index of the fittest
       BestIndex = fittest();
 
@@ -12,6 +12,7 @@
 // to using COPASI_DEBUG, which would make this output on for any debug version
 #undef DEBUG_OPT
 
+#include <algorithm>
 #include <limits>
 #include <string>
 #include <cmath>
@@ -24,10 +25,12 @@
 #include "COptMethodSS.h"
 #include "COptProblem.h"
 #include "parameterFitting/CFitProblem.h"
+#include "COptMethodLevenbergMarquardt.h"
 #include "COptItem.h"
 #include "COptTask.h"
 
 #include "randomGenerator/CRandom.h"
+#include "math/CMathContainer.h"
 #include "utilities/CProcessReport.h"
 #include "utilities/CSort.h"
 #include "copasi/core/CDataObjectReference.h"
@@ -44,12 +47,15 @@ COptMethodSS::COptMethodSS(const CDataContainer * pParent,
   mBestValue(std::numeric_limits< C_FLOAT64 >::max()),
   mBestIndex(C_INVALID_INDEX),
   mpOptProblemLocal(NULL),
-  mpLocalMinimizer(NULL)
+  mpLocalMinimizer(NULL),
+  mParallelLocalSearches(false),
+  mLocalSearches(false)
 {
   addParameter("Number of Iterations", CCopasiParameter::Type::UINT, (unsigned C_INT32) 200);
   addParameter("Random Number Generator", CCopasiParameter::Type::UINT, (unsigned C_INT32) CRandom::mt19937, eUserInterfaceFlag::editable);
   addParameter("Seed", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0, eUserInterfaceFlag::editable);
   addParameter("Stop after # Stalled Generations", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0, eUserInterfaceFlag::editable);
+  addParameter("Parallel Local Searches", CCopasiParameter::Type::BOOL, false, eUserInterfaceFlag::editable);
 
   initObjects();
 }
@@ -65,7 +71,9 @@ COptMethodSS::COptMethodSS(const COptMethodSS & src,
   mBestValue(std::numeric_limits< C_FLOAT64 >::max()),
   mBestIndex(C_INVALID_INDEX),
   mpOptProblemLocal(NULL),
-  mpLocalMinimizer(NULL)
+  mpLocalMinimizer(NULL),
+  mParallelLocalSearches(false),
+  mLocalSearches(false)
 {
   // remove eventual existing parameters from the release version.
   initObjects();
@@ -126,30 +134,7 @@ bool COptMethodSS::initialize()
 
   CFitProblem * pFitProblem = dynamic_cast< CFitProblem * >(mpOptProblem);
 
-  if (pFitProblem != NULL)
-    {
-      // this is a least squares problem (param estimation)
-      // let's use our favorite lsq method
-      mpLocalMinimizer = static_cast< COptMethod * >(CCopasiMethod::createMethod(getObjectParent(),
-                         CTaskEnum::Method::LevenbergMarquardt,
-                         getType()));
-      // the intermediate local minimizations use a rather relaxed tolerance
-      mpLocalMinimizer->setValue("Tolerance", (C_FLOAT64) 1.e-003);
-      // TODO: not sure if we should let this one go that long...
-      mpLocalMinimizer->setValue("Iteration Limit", (C_INT32) 2000);
-    }
-  else
-    {
-      // this is a generic optimisation problem
-      // let's use Hooke and Jeeves
-      mpLocalMinimizer = static_cast< COptMethod * >(CCopasiMethod::createMethod(getObjectParent(),
-                         CTaskEnum::Method::HookeJeeves,
-                         getType()));
-      // with a rather relaxed tolerance (1e-3) for intermediate minimizations
-      mpLocalMinimizer->setValue("Tolerance", (C_FLOAT64) 1.e-003);
-      mpLocalMinimizer->setValue("Iteration Limit", (C_INT32) 50);
-      mpLocalMinimizer->setValue("Rho", (C_FLOAT64) 0.2);
-    }
+  mpLocalMinimizer = createLocalMinimizer();
 
   // local minimization problem (starts as a copy of the current problem)
   if (pFitProblem != NULL)
@@ -175,6 +160,22 @@ bool COptMethodSS::initialize()
   // do not randomize the initial values
   mpOptProblemLocal->setRandomizeStartValues(false);
   mpLocalMinimizer->setProblem(mpOptProblemLocal);
+  mpLocalMinimizer->setMathContainer(mpContainer);
+
+  // The local minimizer runs many times on the same problem, i.e., its workers
+  // are created once per run and not for each local search.
+  COptMethodLevenbergMarquardt * pLevenbergMarquardt = dynamic_cast< COptMethodLevenbergMarquardt * >(mpLocalMinimizer);
+
+  if (pLevenbergMarquardt != NULL)
+    pLevenbergMarquardt->setKeepWorkers(true);
+
+  mParallelLocalSearches = false;
+
+  if (getParameter("Parallel Local Searches"))
+    mParallelLocalSearches = getValue< bool >("Parallel Local Searches");
+
+  if (mParallelLocalSearches)
+    createParallelLocalSearches(pFitProblem);
 
   // create matrix for the RefSet (population)
   mIndividuals.resize(mPopulationSize);
@@ -215,12 +216,14 @@ bool COptMethodSS::initialize()
       mPoolSize = 2 * mGenerations / mLocalFreq;
     }
 
-  mPool.resize(mPoolSize);
+  // The pool must be able to hold the initial and final positions of all
+  // local searches, of which there are up to one per thread in each round.
+  mPool.resize(std::max(mPoolSize, (size_t)(2 * mGenerations / mLocalFreq) * mLocalSearches.size()));
 
-  for (i = 0; i < mPoolSize; i++)
+  for (i = 0; i < mPool.size(); i++)
     mPool[i] = new CVector< C_FLOAT64 >(mVariableSize);
 
-  mPoolVal.resize(mPoolSize);
+  mPoolVal.resize(mPool.size());
   mPoolVal = std::numeric_limits<C_FLOAT64>::infinity();
 
   // best is infinity, so anything will improve it
@@ -257,6 +260,8 @@ bool COptMethodSS::cleanup()
 
   pdelete(mpLocalMinimizer);
 
+  destroyParallelLocalSearches();
+
   for (i = 0; i < mChild.size(); i++)
     pdelete(mChild[i]);
 
@@ -273,41 +278,137 @@ bool COptMethodSS::cleanup()
 // solution has initial guess on entry, and solution on exit
 // fval has value of objective function on exit
 bool COptMethodSS::localmin(CVector< C_FLOAT64 > & solution, C_FLOAT64 & fval)
+{
+  sLocalSearch LocalSearch;
+  LocalSearch.pProblem = mpOptProblemLocal;
+  LocalSearch.pMinimizer = mpLocalMinimizer;
+
+  bool Running = localmin(LocalSearch, solution, fval);
+
+  // add the function evaluations taken in local to the global problem
+  mpOptProblem->incrementEvaluations(LocalSearch.Evaluations);
+
+  return Running;
+}
+
+// static
+bool COptMethodSS::localmin(sLocalSearch & localSearch, CVector< C_FLOAT64 > & solution, C_FLOAT64 & fval)
 {
   bool Running = true;
-  unsigned C_INT32 i;
+  size_t i, imax = solution.size();
 
-  mpOptProblemLocal->reset();
+  localSearch.pProblem->reset();
 
   // first we set up the problem
   // (optmethod and optproblem already setup in initialization)
   // let's get the list of parameters
-  std::vector<COptItem *> optitem = mpOptProblemLocal->getOptItemList();
+  const std::vector<COptItem *> & optitem = localSearch.pProblem->getOptItemList();
 
   // and set them to the values passed in solution
-  for (i = 0; i < mVariableSize; i++)
+  for (i = 0; i < imax; i++)
     {
       optitem[i]->setStartValue(solution[i]);
     }
 
   // reset the function counter of the local minimizer
-  mpOptProblemLocal->resetEvaluations();
+  localSearch.pProblem->resetEvaluations();
 
   // run it
-  Running &= mpLocalMinimizer->optimise();
-  // add the function evaluations taken in local to the global problem
-  mpOptProblem->incrementEvaluations(mpOptProblemLocal->getFunctionEvaluations());
+  Running &= localSearch.pMinimizer->optimise();
+  // count the function evaluations taken
+  localSearch.Evaluations += localSearch.pProblem->getFunctionEvaluations();
   // pass the results on to the calling parameters
-  fval = mpOptProblemLocal->getSolutionValue();
+  fval = localSearch.pProblem->getSolutionValue();
 
-  for (i = 0; i < mVariableSize; i++)
+  for (i = 0; i < imax; i++)
     {
-      solution[i] = mpOptProblemLocal->getSolutionVariables()[i];
+      solution[i] = localSearch.pProblem->getSolutionVariables()[i];
     }
 
   return Running;
 }
 
+COptMethod * COptMethodSS::createLocalMinimizer() const
+{
+  COptMethod * pMinimizer = NULL;
+
+  if (dynamic_cast< CFitProblem * >(mpOptProblem) != NULL)
+    {
+      // this is a least squares problem (param estimation)
+      // let's use our favorite lsq method
+      pMinimizer = static_cast< COptMethod * >(CCopasiMethod::createMethod(getObjectParent(),
+                   CTaskEnum::Method::LevenbergMarquardt,
+                   getType()));
+      // the intermediate local minimizations use a rather relaxed tolerance
+      pMinimizer->setValue("Tolerance", (C_FLOAT64) 1.e-003);
+      // TODO: not sure if we should let this one go that long...
+      pMinimizer->setValue("Iteration Limit", (C_INT32) 2000);
+    }
+  else
+    {
+      // this is a generic optimisation problem
+      // let's use Hooke and Jeeves
+      pMinimizer = static_cast< COptMethod * >(CCopasiMethod::createMethod(getObjectParent(),
+                   CTaskEnum::Method::HookeJeeves,
+                   getType()));
+      // with a rather relaxed tolerance (1e-3) for intermediate minimizations
+      pMinimizer->setValue("Tolerance", (C_FLOAT64) 1.e-003);
+      pMinimizer->setValue("Iteration Limit", (C_INT32) 50);
+      pMinimizer->setValue("Rho", (C_FLOAT64) 0.2);
+    }
+
+  return pMinimizer;
+}
+
+void COptMethodSS::createParallelLocalSearches(const CFitProblem * pFitProblem)
+{
+  destroyParallelLocalSearches();
+
+  // Only fitting problems provide workers which can be evaluated concurrently.
+  mLocalSearches.init(pFitProblem != NULL && mpContainer != NULL);
+
+  if (!mLocalSearches.isParallel()) return;
+
+  sLocalSearch * pLocalSearch = mLocalSearches.beginThread();
+  sLocalSearch * pLocalSearchEnd = mLocalSearches.endThread();
+
+  for (; pLocalSearch != pLocalSearchEnd; ++pLocalSearch)
+    {
+      pLocalSearch->pContainer = new CMathContainer(*mpContainer);
+      pLocalSearch->pProblem = pFitProblem->createWorker(pLocalSearch->pContainer);
+
+      if (pLocalSearch->pProblem == NULL)
+        {
+          // Fall back to serial local searches.
+          destroyParallelLocalSearches();
+          return;
+        }
+
+      pLocalSearch->pProblem->setCalculateStatistics(false);
+      pLocalSearch->pProblem->setRandomizeStartValues(false);
+
+      pLocalSearch->pMinimizer = createLocalMinimizer();
+      pLocalSearch->pMinimizer->setMathContainer(pLocalSearch->pContainer);
+      pLocalSearch->pMinimizer->setProblem(pLocalSearch->pProblem);
+    }
+}
+
+void COptMethodSS::destroyParallelLocalSearches()
+{
+  sLocalSearch * pLocalSearch = mLocalSearches.beginThread();
+  sLocalSearch * pLocalSearchEnd = mLocalSearches.endThread();
+
+  for (; pLocalSearch != pLocalSearchEnd; ++pLocalSearch)
+    {
+      pdelete(pLocalSearch->pMinimizer);
+      // The problem refers to the container and must be destroyed first.
+      pdelete(pLocalSearch->pProblem);
+      pdelete(pLocalSearch->pContainer);
+    }
+
+  mLocalSearches.init(false);
+}
+
 // evaluate the fitness of one individual
 bool COptMethodSS::evaluate(const CVector< C_FLOAT64 > & /* individual */)
 {
@@ -1047,6 +1148,91 @@ bool COptMethodSS::childLocalMin(void)
   return Running;
 }
 
+bool COptMethodSS::parallelChildLocalMin(void)
+{
+  C_INT32 i;
+  size_t j;
+
+  // the candidates are the children which improved on their parents
+  // ordered by value and index
+  std::vector< std::pair< C_FLOAT64, C_INT32 > > Candidates;
+
+  for (i = 0; i < (C_INT32)mPopulationSize; i++)
+    {
+      if ((mStuck[i] == 0) && (mChildVal[i] < std::numeric_limits<C_FLOAT64>::infinity()))
+        Candidates.push_back(std::make_pair(mChildVal[i], i));
+    }
+
+  std::sort(Candidates.begin(), Candidates.end());
+
+  // select up to one child per thread, skipping children close to the
+  // initial or final position of a previous local search. The selection
+  // does not depend on the timing of the threads, i.e., the result is
+  // deterministic for a given number of threads.
+  std::vector< C_INT32 > Selected;
+  size_t MaxSelected = std::min(mLocalSearches.size(), (mPool.size() - mLocalStored) / 2);
+
+  std::vector< std::pair< C_FLOAT64, C_INT32 > >::const_iterator it = Candidates.begin();
+  std::vector< std::pair< C_FLOAT64, C_INT32 > >::const_iterator end = Candidates.end();
+
+  for (; it != end && Selected.size() < MaxSelected; ++it)
+    {
+      for (j = 0; j < mLocalStored; ++j)
+        if (closerChild(it->second, (C_INT32) j, mCloseValue))
+          break;
+
+      // it is too close, try the next one
+      if (j < mLocalStored) continue;
+
+      // store the initial position
+      *(mPool[mLocalStored]) = *(mChild[it->second]);
+      mPoolVal[mLocalStored] = mChildVal[it->second];
+      mLocalStored++;
+
+      Selected.push_back(it->second);
+    }
+
+  // no child in this iteration? exit now
+  if (Selected.empty()) return true;
+
+  sLocalSearch * pLocalSearch = mLocalSearches.beginThread();
+  sLocalSearch * pLocalSearchEnd = mLocalSearches.endThread();
+
+  for (; pLocalSearch != pLocalSearchEnd; ++pLocalSearch)
+    pLocalSearch->Evaluations = 0;
+
+  C_INT32 Size = (C_INT32) Selected.size();
+  bool Running = true;
+
+  // do local minimization on each selected child, the results are written in
+  // place into the children
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic) reduction(&& : Running)
+#endif // USE_OMP
+
+  for (i = 0; i < Size; i++)
+    {
+      Running = localmin(mLocalSearches.active(), *(mChild[Selected[i]]), mChildVal[Selected[i]]) && Running;
+    }
+
+  // store the results in the order of the selection
+  for (i = 0; i < Size; i++)
+    {
+      *(mPool[mLocalStored]) = *(mChild[Selected[i]]);
+      mPoolVal[mLocalStored] = mChildVal[Selected[i]];
+      mLocalStored++;
+    }
+
+  // add the function evaluations taken in local to the global problem
+  for (pLocalSearch = mLocalSearches.beginThread(); pLocalSearch != pLocalSearchEnd; ++pLocalSearch)
+    mpOptProblem->incrementEvaluations(pLocalSearch->Evaluations);
+
+  // clear the local optimisation counter
+  mLocalIter = 1;
+
+  return Running;
+}
+
 bool COptMethodSS::optimise()
 {
   bool Running = true;
@@ -1087,7 +1273,7 @@ bool COptMethodSS::optimise()
 
   // mPool is now going to be used to keep track of initial and final
   // points of local minimizations (to avoid running them more than once)
-  mPoolSize = 2 * mGenerations / mLocalFreq;
+  mPoolSize = 2 * mGenerations / mLocalFreq * mLocalSearches.size();
   // reset the number of stored minimizations
   mLocalStored = 0;
   // reset the counter for local minimisation
@@ -1145,7 +1331,10 @@ bool COptMethodSS::optimise()
       if (mLocalIter >= mLocalFreq && mChildrenGenerated)
         {
           // carry out a local search
-          Running &= childLocalMin();
+          if (mLocalSearches.isParallel())
+            Running &= parallelChildLocalMin();
+          else
+            Running &= childLocalMin();
         }
       else
         {
@@ -17,10 +17,12 @@
 #include <limits>
 
 #include "copasi/core/CVector.h"
+#include "copasi/core/CContext.h"
 #include "optimization/COptPopulationMethod.h"
 #include "optimization/COptProblem.h"
 
 class CRandom;
+class CFitProblem;
 
 class COptMethodSS : public COptPopulationMethod
 {
@@ -139,6 +141,26 @@ private:
    */
   bool evaluate(const CVector< C_FLOAT64 > & individual);
 
+  /**
+   * A local search consists of a problem and the minimizer working on it.
+   * The local searches of the threads own their problem, minimizer and
+   * math container.
+   */
+  struct sLocalSearch
+  {
+    sLocalSearch():
+      pContainer(NULL),
+      pProblem(NULL),
+      pMinimizer(NULL),
+      Evaluations(0)
+    {}
+
+    CMathContainer * pContainer;
+    COptProblem * pProblem;
+    COptMethod * pMinimizer;
+    unsigned C_INT32 Evaluations;
+  };
+
   /**
    * Find a local minimum
    * @param CVector< C_FLOAT64 > & solution
@@ -147,12 +169,46 @@ private:
    */
   bool localmin(CVector< C_FLOAT64 > & solution, C_FLOAT64 & fval);
 
+  /**
+   * Find a local minimum using the given local search. The function
+   * evaluations are added to the counter of the local search.
+   * @param sLocalSearch & localSearch
+   * @param CVector< C_FLOAT64 > & solution
+   * @param C_FLOAT64 & fval
+   * @return bool continue
+   */
+  static bool localmin(sLocalSearch & localSearch, CVector< C_FLOAT64 > & solution, C_FLOAT64 & fval);
+
   /**
    * minimize the best child if within criteria
    * @return bool continue
    */
   bool childLocalMin(void);
 
+  /**
+   * Minimize the best children within criteria concurrently, one per thread
+   * @return bool continue
+   */
+  bool parallelChildLocalMin(void);
+
+  /**
+   * Create the minimizer used for local searches
+   * @return COptMethod * pMinimizer
+   */
+  COptMethod * createLocalMinimizer() const;
+
+  /**
+   * Create a local search for each thread if the problem supports workers.
+   * Otherwise local searches are carried out serially.
+   * @param const CFitProblem * pFitProblem
+   */
+  void createParallelLocalSearches(const CFitProblem * pFitProblem);
+
+  /**
+   * Destroy the local searches of the threads
+   */
+  void destroyParallelLocalSearches();
+
   /**
    * Initialise the population
    * @return bool continue
@@ -290,6 +346,16 @@ private:
    * a pointer to an opt method used for local minimization
    */
   COptMethod * mpLocalMinimizer;
+
+  /**
+   * Indicates whether local searches of several children run concurrently
+   */
+  bool mParallelLocalSearches;
+
+  /**
+   * The local searches of the threads
+   */
+  CContext< sLocalSearch > mLocalSearches;
 };
 
 #endif  // COPASI_COptMethodSS
@@ -8,11 +8,18 @@
 // of Manchester.
 // All rights reserved.
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
 #include "copasi/copasi.h"
 
 #include "optimization/COptPopulationMethod.h"
+#include "optimization/COptProblem.h"
 #include "randomGenerator/CRandom.h"
 #include "utilities/CProcessReport.h"
+#include "utilities/CDirEntry.h"
+#include "commandline/CLocaleString.h"
 #include "copasi/core/CDataObject.h"
 #include "copasi/core/CDataObjectReference.h"
 
@@ -28,6 +35,17 @@ COptPopulationMethod::COptPopulationMethod(const CDataContainer * pParent,
   , mIndividuals()
   , mValues()
   , mpRandom(NULL)
+  , mEarlyTermination(false)
+  , mIslandDirectory()
+  , mIslandIndex(0)
+  , mNumIslands(1)
+  , mMigrationInterval(0)
+  , mMigrationTopology(MigrationTopology::Ring)
+  , mMigrants(0)
+  , mImmigrationGenerations()
+  , mBatch()
+  , mBatchValues()
+  , mBatchViolations()
 {
   initObjects();
 }
@@ -43,6 +61,17 @@ COptPopulationMethod::COptPopulationMethod(const COptPopulationMethod & src,
   , mIndividuals()
   , mValues()
   , mpRandom(NULL)
+  , mEarlyTermination(false)
+  , mIslandDirectory()
+  , mIslandIndex(0)
+  , mNumIslands(1)
+  , mMigrationInterval(0)
+  , mMigrationTopology(MigrationTopology::Ring)
+  , mMigrants(0)
+  , mImmigrationGenerations()
+  , mBatch()
+  , mBatchValues()
+  , mBatchViolations()
 {
   initObjects();
 }
@@ -89,12 +118,62 @@ COptPopulationMethod::initialize()
   else
     mPopulationSize = 0;
 
+  mEarlyTermination = false;
+
+  if (getParameter("Early Termination of Simulations") != NULL)
+    mEarlyTermination = getValue< bool >("Early Termination of Simulations");
+
+  mIslandDirectory.clear();
+  mIslandIndex = 0;
+  mNumIslands = 1;
+  mMigrationInterval = 0;
+  mMigrationTopology = MigrationTopology::Ring;
+  mMigrants = 0;
+  mImmigrationGenerations.clear();
+
+  if (getParameter("Island Directory") != NULL)
+    {
+      mIslandDirectory = getValue< std::string >("Island Directory");
+      mIslandIndex = getValue< unsigned C_INT32 >("Island Index");
+      mNumIslands = getValue< unsigned C_INT32 >("Number of Islands");
+      mMigrationInterval = getValue< unsigned C_INT32 >("Migration Interval");
+      mMigrationTopology = (MigrationTopology) getValue< unsigned C_INT32 >("Migration Topology");
+      mMigrants = getValue< unsigned C_INT32 >("Number of Migrants");
+
+      // The migration is disabled unless all settings are sensible.
+      if (mNumIslands < 2 || mMigrationInterval == 0 || mMigrants == 0 ||
+          mIslandIndex >= mNumIslands)
+        {
+          mIslandDirectory.clear();
+        }
+      else if (!CDirEntry::isDir(mIslandDirectory) ||
+               !CDirEntry::isWritable(mIslandDirectory))
+        {
+          CCopasiMessage(CCopasiMessage::ERROR, MCOptimization + 10, mIslandDirectory.c_str());
+          return false;
+        }
+      else
+        {
+          // Remove the emigrants of all islands of a previous run since they must
+          // not be accepted as migrants. Islands of the current run which started
+          // earlier publish their emigrants again at their next migration.
+          for (size_t i = 0; i < mNumIslands; ++i)
+            CDirEntry::remove(islandFile(i));
+        }
+    }
+
   pdelete(mpRandom);
 
   if (getParameter("Random Number Generator") != NULL && getParameter("Seed") != NULL)
     {
+      unsigned C_INT32 Seed = getValue< unsigned C_INT32 >("Seed");
+
+      // Islands with an explicit seed must still explore different regions.
+      if (Seed != 0 && !mIslandDirectory.empty())
+        Seed += mIslandIndex;
+
       mpRandom = CRandom::createGenerator((CRandom::Type) getValue< unsigned C_INT32 >("Random Number Generator"),
-                                          getValue< unsigned C_INT32 >("Seed"));
+                                          Seed);
     }
   else
     {
@@ -120,6 +199,266 @@ COptPopulationMethod::cleanup()
   return true;
 }
 
+void COptPopulationMethod::addMigrationParameters()
+{
+  addParameter("Island Directory", CCopasiParameter::Type::STRING, std::string(""), eUserInterfaceFlag::editable);
+  addParameter("Island Index", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0, eUserInterfaceFlag::editable);
+  addParameter("Number of Islands", CCopasiParameter::Type::UINT, (unsigned C_INT32) 1, eUserInterfaceFlag::editable);
+  addParameter("Migration Interval", CCopasiParameter::Type::UINT, (unsigned C_INT32) 10, eUserInterfaceFlag::editable);
+  // 0: ring, 1: fully connected
+  addParameter("Migration Topology", CCopasiParameter::Type::UINT, (unsigned C_INT32) MigrationTopology::Ring, eUserInterfaceFlag::editable);
+  addParameter("Number of Migrants", CCopasiParameter::Type::UINT, (unsigned C_INT32) 2, eUserInterfaceFlag::editable);
+}
+
+std::vector< size_t > COptPopulationMethod::migrate()
+{
+  if (mIslandDirectory.empty() ||
+      mCurrentGeneration % mMigrationInterval != 0)
+    return std::vector< size_t >();
+
+  emigrate();
+
+  return immigrate();
+}
+
+void COptPopulationMethod::setContainerVariables(const CVector< C_FLOAT64 > & individual)
+{
+  const C_FLOAT64 * pValue = individual.array();
+  C_FLOAT64 ** ppVariable = mContainerVariables.array();
+  C_FLOAT64 ** ppVariableEnd = ppVariable + mContainerVariables.size();
+
+  for (; ppVariable != ppVariableEnd; ++ppVariable, ++pValue)
+    **ppVariable = *pValue;
+}
+
+void COptPopulationMethod::updateObjectiveBound()
+{
+  if (!mEarlyTermination || mPopulationSize == 0)
+    return;
+
+  C_FLOAT64 Bound = - std::numeric_limits< C_FLOAT64 >::infinity();
+  const C_FLOAT64 * pValue = mValues.array();
+  const C_FLOAT64 * pValueEnd = pValue + std::min< size_t >(mPopulationSize, mValues.size());
+
+  for (; pValue != pValueEnd; ++pValue)
+    {
+      if (std::isnan(*pValue))
+        {
+          Bound = std::numeric_limits< C_FLOAT64 >::infinity();
+          break;
+        }
+
+      Bound = std::max(Bound, *pValue);
+    }
+
+  mpOptProblem->setObjectiveBound(Bound);
+}
+
+bool COptPopulationMethod::evaluatePopulation(const size_t & first,
+    const size_t & last,
+    C_FLOAT64 * pConstraintViolations)
+{
+  if (first >= last)
+    return true;
+
+  mBatch.assign(mIndividuals.begin() + first, mIndividuals.begin() + last);
+
+  bool Continue = mpOptProblem->calculateBatch(mBatch, mBatchValues, mBatchViolations);
+
+  C_FLOAT64 * pValue = mValues.array() + first;
+  const C_FLOAT64 * pBatchValue = mBatchValues.array();
+  const C_FLOAT64 * pBatchViolation = mBatchViolations.array();
+  const C_FLOAT64 * pBatchViolationEnd = pBatchViolation + mBatchViolations.size();
+
+  for (; pBatchViolation != pBatchViolationEnd; ++pValue, ++pBatchValue, ++pBatchViolation)
+    {
+      if (pConstraintViolations != NULL)
+        {
+          *pValue = *pBatchValue;
+          *pConstraintViolations++ = *pBatchViolation;
+        }
+      else if (*pBatchViolation > 0.0)
+        *pValue = std::numeric_limits< C_FLOAT64 >::infinity();
+      else
+        *pValue = *pBatchValue;
+    }
+
+  return Continue;
+}
+
+std::string COptPopulationMethod::islandFile(const size_t & island) const
+{
+  std::ostringstream FileName;
+  FileName << mIslandDirectory << CDirEntry::Separator << "island_" << island << ".txt";
+
+  return FileName.str();
+}
+
+bool COptPopulationMethod::emigrate() const
+{
+  size_t Size = std::min< size_t >(mPopulationSize, mIndividuals.size());
+  std::vector< std::pair< C_FLOAT64, size_t > > Ranking;
+
+  for (size_t i = 0; i < Size; ++i)
+    if (!std::isnan(mValues[i]) &&
+        mValues[i] < std::numeric_limits< C_FLOAT64 >::infinity())
+      Ranking.push_back(std::make_pair(mValues[i], i));
+
+  Size = std::min< size_t >(mMigrants, Ranking.size());
+  std::partial_sort(Ranking.begin(), Ranking.begin() + Size, Ranking.end());
+
+  std::string FileName = islandFile(mIslandIndex);
+  std::string TmpName = FileName + ".tmp";
+
+  {
+    std::ofstream os(CLocaleString::fromUtf8(TmpName).c_str());
+
+    if (os.fail())
+      return false;
+
+    os.precision(17);
+    os << "island " << mIslandIndex << " generation " << mCurrentGeneration << " variables " << mVariableSize << std::endl;
+
+    std::vector< std::pair< C_FLOAT64, size_t > >::const_iterator it = Ranking.begin();
+    std::vector< std::pair< C_FLOAT64, size_t > >::const_iterator end = it + Size;
+
+    for (; it != end; ++it)
+      {
+        os << it->first;
+
+        const C_FLOAT64 * pValue = mIndividuals[it->second]->array();
+        const C_FLOAT64 * pValueEnd = pValue + mVariableSize;
+
+        for (; pValue != pValueEnd; ++pValue)
+          os << " " << *pValue;
+
+        os << std::endl;
+      }
+
+    if (os.fail())
+      return false;
+  }
+
+  // Readers must never see a partially written file.
+  return CDirEntry::move(TmpName, FileName);
+}
+
+std::vector< size_t > COptPopulationMethod::immigrate()
+{
+  std::vector< size_t > Immigrants;
+  std::vector< std::pair< C_FLOAT64, CVector< C_FLOAT64 > > > Candidates;
+
+  std::vector< size_t > Neighbors;
+
+  switch (mMigrationTopology)
+    {
+      case MigrationTopology::FullyConnected:
+        for (size_t i = 0; i < mNumIslands; ++i)
+          if (i != mIslandIndex)
+            Neighbors.push_back(i);
+
+        break;
+
+      case MigrationTopology::Ring:
+      default:
+        Neighbors.push_back((mIslandIndex + mNumIslands - 1) % mNumIslands);
+        break;
+    }
+
+  std::vector< size_t >::const_iterator itNeighbor = Neighbors.begin();
+  std::vector< size_t >::const_iterator endNeighbor = Neighbors.end();
+
+  for (; itNeighbor != endNeighbor; ++itNeighbor)
+    {
+      std::ifstream is(CLocaleString::fromUtf8(islandFile(*itNeighbor)).c_str());
+
+      if (is.fail())
+        continue;
+
+      std::string Island, Generation, Variables;
+      size_t Index, VariableSize;
+      unsigned C_INT32 CurrentGeneration;
+
+      is >> Island >> Index >> Generation >> CurrentGeneration >> Variables >> VariableSize;
+
+      if (is.fail() || Index != *itNeighbor || VariableSize != mVariableSize)
+        continue;
+
+      // Only accept individuals which were not already received.
+      std::map< size_t, unsigned C_INT32 >::iterator found = mImmigrationGenerations.find(Index);
+
+      if (found != mImmigrationGenerations.end() && found->second >= CurrentGeneration)
+        continue;
+
+      mImmigrationGenerations[Index] = CurrentGeneration;
+
+      C_FLOAT64 Value;
+      CVector< C_FLOAT64 > Individual(mVariableSize);
+
+      while (is >> Value)
+        {
+          C_FLOAT64 * pValue = Individual.array();
+          C_FLOAT64 * pValueEnd = pValue + mVariableSize;
+
+          for (; pValue != pValueEnd && is >> *pValue; ++pValue) {}
+
+          if (pValue != pValueEnd)
+            break;
+
+          Candidates.push_back(std::make_pair(Value, Individual));
+        }
+    }
+
+  if (Candidates.empty())
+    return Immigrants;
+
+  // Rank the own individuals from worst to best.
+  size_t Size = std::min< size_t >(mPopulationSize, mIndividuals.size());
+  std::vector< std::pair< C_FLOAT64, size_t > > Ranking;
+
+  for (size_t i = 0; i < Size; ++i)
+    Ranking.push_back(std::make_pair(std::isnan(mValues[i]) ? std::numeric_limits< C_FLOAT64 >::infinity() : mValues[i], i));
+
+  std::sort(Ranking.begin(), Ranking.end(), std::greater< std::pair< C_FLOAT64, size_t > >());
+
+  std::sort(Candidates.begin(), Candidates.end(),
+            [](const std::pair< C_FLOAT64, CVector< C_FLOAT64 > > & a,
+               const std::pair< C_FLOAT64, CVector< C_FLOAT64 > > & b)
+  {
+    return a.first < b.first;
+  });
+
+  std::vector< std::pair< C_FLOAT64, CVector< C_FLOAT64 > > >::const_iterator itCandidate = Candidates.begin();
+  std::vector< std::pair< C_FLOAT64, CVector< C_FLOAT64 > > >::const_iterator endCandidate = Candidates.end();
+  std::vector< std::pair< C_FLOAT64, size_t > >::const_iterator itWorst = Ranking.begin();
+
+  // We never replace more than half of the population to preserve diversity.
+  size_t MaxImmigrants = std::min< size_t >(mMigrants, Size / 2);
+
+  for (; itCandidate != endCandidate && Immigrants.size() < MaxImmigrants; ++itCandidate)
+    {
+      if (itCandidate->first >= itWorst->first)
+        break;
+
+      // Skip individuals which are already part of the population, e.g., our
+      // own emigrants returning in a ring of two islands.
+      bool Known = false;
+
+      for (size_t i = 0; i < Size && !Known; ++i)
+        Known = std::equal(itCandidate->second.array(), itCandidate->second.array() + mVariableSize, mIndividuals[i]->array());
+
+      if (Known)
+        continue;
+
+      *mIndividuals[itWorst->second] = itCandidate->second;
+      mValues[itWorst->second] = itCandidate->first;
+      Immigrants.push_back(itWorst->second);
+      ++itWorst;
+    }
+
+  return Immigrants;
+}
+
 C_INT32 COptPopulationMethod::getPopulationSize()
 {
   return mPopulationSize;
@@ -11,6 +11,8 @@
 #ifndef COPASI_COptPopulationMethod_H
 #define COPASI_COptPopulationMethod_H
 
+#include <map>
+
 #include <copasi/optimization/COptMethod.h>
 #include "copasi/core/CVector.h"
 
@@ -90,6 +92,89 @@ public:
   */
   friend std::ostream &operator<<(std::ostream &os, const COptPopulationMethod & o);
 
+protected:
+  /**
+   * The topologies for the migration between islands
+   */
+  enum struct MigrationTopology
+  {
+    Ring = 0,
+    FullyConnected = 1
+  };
+
+  /**
+   * Add the parameters controlling the migration between islands. Independent
+   * processes optimizing the same problem form an island model if they share
+   * the island directory. Each island periodically writes its best individuals
+   * to the directory and reads those of its neighbors.
+   */
+  void addMigrationParameters();
+
+  /**
+   * Exchange individuals with the neighboring islands if the migration is
+   * enabled and the current generation is a migration generation. The best
+   * individuals of the first mPopulationSize are published and immigrants
+   * replace the worst of them. The values of the immigrants are the ones
+   * reported by their island, i.e., the caller must evaluate them.
+   * @return std::vector< size_t > immigrants (indexes of the replaced individuals)
+   */
+  std::vector< size_t > migrate();
+
+  /**
+   * Set the values of the container variables to the given individual
+   * @param const CVector< C_FLOAT64 > & individual
+   */
+  void setContainerVariables(const CVector< C_FLOAT64 > & individual);
+
+  /**
+   * Set the objective bound of the problem to the worst value of the first
+   * mPopulationSize individuals if early termination of simulations is
+   * enabled. The value of a candidate exceeding this bound is only a lower
+   * bound of its true value. A method may therefore only set the bound if such
+   * a candidate is discarded whatever its true value is, e.g., a trial of
+   * differential evolution which only replaces its parent if it is better.
+   * This does not hold for selections in which candidates compete with each
+   * other, such as the tournaments of the genetic algorithm or the stochastic
+   * ranking of SRES.
+   */
+  void updateObjectiveBound();
+
+  /**
+   * Evaluate the individuals in the range [first, last) as one batch and store
+   * their objective values in mValues. If no constraint violations are
+   * requested individuals violating the functional constraints are assigned
+   * the value infinity.
+   * @param const size_t & first
+   * @param const size_t & last
+   * @param C_FLOAT64 * pConstraintViolations (default: NULL)
+   * @return bool continue
+   */
+  bool evaluatePopulation(const size_t & first,
+                          const size_t & last,
+                          C_FLOAT64 * pConstraintViolations = NULL);
+
+private:
+  /**
+   * Retrieve the name of the file holding the emigrants of the island
+   * @param const size_t & island
+   * @return std::string fileName
+   */
+  std::string islandFile(const size_t & island) const;
+
+  /**
+   * Write the best individuals to the file of this island. The file is
+   * replaced atomically so that readers never see partial content.
+   * @return bool success
+   */
+  bool emigrate() const;
+
+  /**
+   * Read the individuals published by the neighboring islands since the last
+   * migration and replace the worst individuals by better immigrants.
+   * @return std::vector< size_t > immigrants (indexes of the replaced individuals)
+   */
+  std::vector< size_t > immigrate();
+
 protected:
   /**
    * size of the population / swarm size
@@ -130,6 +215,62 @@ protected:
    * a pointer to the random number generator.
    */
   CRandom * mpRandom;
+
+  /**
+   * Indicates whether simulations of candidates exceeding the objective bound
+   * are terminated early
+   */
+  bool mEarlyTermination;
+
+  /**
+   * The directory shared by the islands (empty if the migration is disabled)
+   */
+  std::string mIslandDirectory;
+
+  /**
+   * The index of this island
+   */
+  unsigned C_INT32 mIslandIndex;
+
+  /**
+   * The number of islands
+   */
+  unsigned C_INT32 mNumIslands;
+
+  /**
+   * The number of generations between migrations
+   */
+  unsigned C_INT32 mMigrationInterval;
+
+  /**
+   * The topology determining the neighbors of an island
+   */
+  MigrationTopology mMigrationTopology;
+
+  /**
+   * The maximal number of individuals exchanged in each migration
+   */
+  unsigned C_INT32 mMigrants;
+
+  /**
+   * The generation of the last immigration from each neighboring island
+   */
+  std::map< size_t, unsigned C_INT32 > mImmigrationGenerations;
+
+  /**
+   * The individuals of the current batch evaluation
+   */
+  std::vector< CVector< C_FLOAT64 > * > mBatch;
+
+  /**
+   * The objective values of the current batch evaluation
+   */
+  CVector< C_FLOAT64 > mBatchValues;
+
+  /**
+   * The functional constraint violations of the current batch evaluation
+   */
+  CVector< C_FLOAT64 > mBatchViolations;
 };
 
 #endif // COPASI_COptPopulationMethod_H
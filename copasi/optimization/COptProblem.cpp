@@ -87,6 +87,11 @@ COptProblem::COptProblem(const CTaskEnum::Task & type,
   mpParmMaximize(NULL),
   mpParmRandomizeStartValues(NULL),
   mpParmCalculateStatistics(NULL),
+  mpParmCacheSize(NULL),
+  mpParmWarmStart(NULL),
+  mpParmTraceFile(NULL),
+  mpParmTraceBufferSize(NULL),
+  mpParmTraceRingBuffer(NULL),
   mpGrpItems(NULL),
   mpGrpConstraints(NULL),
   mpOptItems(NULL),
@@ -101,18 +106,27 @@ COptProblem::COptProblem(const CTaskEnum::Task & type,
   mSolutionVariables(),
   mOriginalVariables(),
   mContainerVariables(),
+  mFixedOptItem(C_INVALID_INDEX),
+  mFreeOptItems(),
+  mFreeContainerVariables(),
   mSolutionValue(0),
   mCounter(0),
   mFailedCounterException(0),
   mFailedCounterNaN(0),
   mConstraintCounter(0),
+  mTerminatedCounter(0),
+  mObjectiveBound(std::numeric_limits< C_FLOAT64 >::infinity()),
   mFailedConstraintCounter(0),
   mCPUTime(CCopasiTimer::Type::PROCESS, this),
   mhSolutionValue(C_INVALID_INDEX),
   mhCounter(C_INVALID_INDEX),
   mStoreResults(false),
   mHaveStatistics(false),
-  mGradient(0)
+  mGradient(0),
+  mValueCache(),
+  mWarmStarts(),
+  mTrace(),
+  mpTrace(NULL)
 {
   initializeParameter();
   initObjects();
@@ -128,6 +142,11 @@ COptProblem::COptProblem(const COptProblem& src,
   mpParmMaximize(NULL),
   mpParmRandomizeStartValues(NULL),
   mpParmCalculateStatistics(NULL),
+  mpParmCacheSize(NULL),
+  mpParmWarmStart(NULL),
+  mpParmTraceFile(NULL),
+  mpParmTraceBufferSize(NULL),
+  mpParmTraceRingBuffer(NULL),
   mpGrpItems(NULL),
   mpGrpConstraints(NULL),
   mpOptItems(NULL),
@@ -142,18 +161,27 @@ COptProblem::COptProblem(const COptProblem& src,
   mSolutionVariables(src.mSolutionVariables),
   mOriginalVariables(src.mOriginalVariables),
   mContainerVariables(src.mContainerVariables),
+  mFixedOptItem(C_INVALID_INDEX),
+  mFreeOptItems(),
+  mFreeContainerVariables(),
   mSolutionValue(src.mSolutionValue),
   mCounter(0),
   mFailedCounterException(0),
   mFailedCounterNaN(0),
   mConstraintCounter(0),
+  mTerminatedCounter(0),
+  mObjectiveBound(std::numeric_limits< C_FLOAT64 >::infinity()),
   mFailedConstraintCounter(0),
   mCPUTime(CCopasiTimer::Type::PROCESS, this),
   mhSolutionValue(C_INVALID_INDEX),
   mhCounter(C_INVALID_INDEX),
   mStoreResults(src.mStoreResults),
   mHaveStatistics(src.mHaveStatistics),
-  mGradient(src.mGradient)
+  mGradient(src.mGradient),
+  mValueCache(),
+  mWarmStarts(),
+  mTrace(),
+  mpTrace(NULL)
 {
   initializeParameter();
   initObjects();
@@ -170,6 +198,11 @@ void COptProblem::initializeParameter()
   mpParmMaximize = assertParameter("Maximize", CCopasiParameter::Type::BOOL, false);
   mpParmRandomizeStartValues = assertParameter("Randomize Start Values", CCopasiParameter::Type::BOOL, false);
   mpParmCalculateStatistics = assertParameter("Calculate Statistics", CCopasiParameter::Type::BOOL, true);
+  mpParmCacheSize = assertParameter("Objective Value Cache Size", CCopasiParameter::Type::UINT, (unsigned C_INT32) 0);
+  mpParmWarmStart = assertParameter("Warm Start Steady State", CCopasiParameter::Type::BOOL, false);
+  mpParmTraceFile = assertParameter("Evaluation Trace File", CCopasiParameter::Type::FILE, std::string(""));
+  mpParmTraceBufferSize = assertParameter("Evaluation Trace Buffer Size", CCopasiParameter::Type::UINT, (unsigned C_INT32) 4096);
+  mpParmTraceRingBuffer = assertParameter("Evaluation Trace Ring Buffer", CCopasiParameter::Type::BOOL, false);
 
   mpGrpItems = assertGroup("OptimizationItemList");
   mpGrpConstraints = assertGroup("OptimizationConstraintList");
@@ -349,6 +382,21 @@ bool COptProblem::initialize()
   mFailedCounterNaN = 0;
   mConstraintCounter = 0;
   mFailedConstraintCounter = 0;
+  mTerminatedCounter = 0;
+  mObjectiveBound = std::numeric_limits< C_FLOAT64 >::infinity();
+
+  releaseOptItem();
+
+  // Functional constraints depend on the state of the container after the
+  // evaluation, i.e., we must not skip it.
+  if (mpParmCacheSize != NULL &&
+      mpConstraintItems != NULL &&
+      mpConstraintItems->empty())
+    mValueCache.setSize(*mpParmCacheSize);
+  else
+    mValueCache.setSize(0);
+
+  mWarmStarts.clear();
 
   mSolutionValue = mWorstValue;
 
@@ -407,6 +455,26 @@ bool COptProblem::initialize()
     }
 
   changedObjects.erase(NULL);
+
+  // Only the problem of a task records the trace. Workers are pointed to it when created.
+  mTrace.close();
+  mpTrace = NULL;
+
+  if (pTask != NULL &&
+      mpParmTraceFile != NULL &&
+      !mpParmTraceFile->empty())
+    {
+      std::vector< std::string > Names;
+
+      for (it = mpOptItems->begin(), end = mpOptItems->end(); it != end; ++it)
+        Names.push_back((*it)->getObjectCN());
+
+      if (mTrace.open(*mpParmTraceFile, Names, *mpParmTraceBufferSize, *mpParmTraceRingBuffer))
+        mpTrace = &mTrace;
+      else
+        CCopasiMessage(CCopasiMessage::WARNING, MCOptimization + 11, mpParmTraceFile->c_str());
+    }
+
   mpContainer->getInitialDependencies().getUpdateSequence(mInitialRefreshSequence, CCore::SimulationContext::UpdateMoieties, changedObjects, mpContainer->getInitialStateObjects());
 
   it = mpConstraintItems->begin();
@@ -489,6 +557,10 @@ bool COptProblem::restore(const bool & updateModel)
         }
     }
 
+  // Write the remaining records of the evaluation trace.
+  mTrace.close();
+  mpTrace = NULL;
+
   if ((mFailedCounterException + mFailedCounterNaN) * 20 > mCounter) // > 5% failure rate
     CCopasiMessage(CCopasiMessage::WARNING, MCOptimization + 8, mFailedCounterException + mFailedCounterNaN, mCounter);
 
@@ -545,6 +617,17 @@ bool COptProblem::calculate()
   if (mpSubtask == NULL)
     return false;
 
+  CCopasiTimeVariable Start = mpTrace != NULL ? CCopasiTimeVariable::getCurrentWallTime() : CCopasiTimeVariable();
+
+  if (findCachedValue())
+    {
+      traceEvaluation(Start, COptTrace::cached);
+
+      if (mpCallBack) return mpCallBack->progressItem(mhCounter);
+
+      return true;
+    }
+
   if (mStoreResults &&
       mpSubtask->getType() == CTaskEnum::Task::timeCourse)
     {
@@ -559,7 +642,10 @@ bool COptProblem::calculate()
       mpContainer->applyUpdateSequence(mInitialRefreshSequence);
       // Update all initial values which depend on the optimization items.
 
-      success = mpSubtask->process(true);
+      if (mpSubtask->getType() == CTaskEnum::Task::steadyState)
+        success = processSteadyState(static_cast< CSteadyStateTask * >(mpSubtask), COptWarmStartStore::Slot(0, 0));
+      else
+        success = mpSubtask->process(true);
 
       mpContainer->applyUpdateSequence(mUpdateObjectiveFunction);
 
@@ -588,26 +674,142 @@ bool COptProblem::calculate()
       pdelete(pOutputHandler);
     }
 
+  COptTrace::Status Status = COptTrace::success;
+
   if (!success)
     {
       mFailedCounterException++;
       mCalculateValue = std::numeric_limits< C_FLOAT64 >::infinity();
+      Status = COptTrace::exception;
     }
 
   if (isnan(mCalculateValue))
     {
       mFailedCounterNaN++;
       mCalculateValue = std::numeric_limits< C_FLOAT64 >::infinity();
+      Status = COptTrace::notANumber;
     }
 
+  // Failed evaluations are not cached since they may succeed when repeated.
+  if (Status == COptTrace::success)
+    cacheValue();
+
+  traceEvaluation(Start, Status);
+
   if (mpCallBack) return mpCallBack->progressItem(mhCounter);
 
   return true;
 }
 
+bool COptProblem::findCachedValue(CVector< C_FLOAT64 > * pData)
+{
+  // A cached value does not restore the state of the container, which is
+  // needed to check the functional constraints.
+  if (mStoreResults || !mpConstraintItems->empty()) return false;
+
+  return mValueCache.find(mContainerVariables, mCalculateValue, pData);
+}
+
+void COptProblem::cacheValue(const CVector< C_FLOAT64 > * pData)
+{
+  if (mStoreResults || !mpConstraintItems->empty()) return;
+
+  mValueCache.insert(mContainerVariables, mCalculateValue, pData);
+}
+
+void COptProblem::traceEvaluation(const CCopasiTimeVariable & start, const COptTrace::Status & status)
+{
+  if (mpTrace == NULL) return;
+
+  mpTrace->record(start, mContainerVariables, mCalculateValue, status);
+}
+
+bool COptProblem::processSteadyState(CSteadyStateTask * pTask, const COptWarmStartStore::Slot & slot)
+{
+  if (mpParmWarmStart == NULL || !*mpParmWarmStart)
+    return pTask->process(true);
+
+  const CVectorCore< C_FLOAT64 > * pGuess = mWarmStarts.find(slot, mContainerVariables);
+
+  bool success = (pGuess != NULL) ? pTask->processWithGuess(*pGuess) : pTask->process(true);
+
+  if (success &&
+      (pTask->getResult() == CSteadyStateMethod::found ||
+       pTask->getResult() == CSteadyStateMethod::foundEquilibrium))
+    mWarmStarts.insert(slot, mContainerVariables, pTask->getState());
+
+  return success;
+}
+
+// virtual
+bool COptProblem::isBatchParallel()
+{
+  return false;
+}
+
+bool COptProblem::calculateBatch(const std::vector< CVector< C_FLOAT64 > * > & points,
+                                 CVector< C_FLOAT64 > & values,
+                                 CVector< C_FLOAT64 > & constraintViolations)
+{
+  bool Continue = true;
+
+  size_t i, imax = points.size();
+
+  values.resize(imax);
+  values = std::numeric_limits< C_FLOAT64 >::infinity();
+  constraintViolations.resize(imax);
+  constraintViolations = 0.0;
+
+  for (i = 0; i < imax && Continue; i++)
+    Continue &= calculatePoint(*points[i], values[i], constraintViolations[i]);
+
+  return Continue;
+}
+
+bool COptProblem::calculatePoint(const CVector< C_FLOAT64 > & point,
+                                 C_FLOAT64 & value,
+                                 C_FLOAT64 & constraintViolation)
+{
+  CVectorCore< C_FLOAT64 * > & Variables = getContainerVariables();
+
+  C_FLOAT64 ** ppVariable = Variables.array();
+  C_FLOAT64 ** ppVariableEnd = ppVariable + std::min(Variables.size(), point.size());
+  const C_FLOAT64 * pValue = point.array();
+
+  for (; ppVariable != ppVariableEnd; ++ppVariable, ++pValue)
+    **ppVariable = *pValue;
+
+  bool Continue = calculate();
+
+  value = mCalculateValue;
+  constraintViolation = 0.0;
+
+  if (!checkFunctionalConstraints())
+    {
+      std::vector< COptItem * >::const_iterator it = mpConstraintItems->begin();
+      std::vector< COptItem * >::const_iterator end = mpConstraintItems->end();
+
+      for (; it != end; ++it)
+        {
+          C_FLOAT64 Violation = (*it)->getConstraintViolation();
+
+          if (Violation > 0.0)
+            constraintViolation += Violation * Violation;
+        }
+
+      // The violation must be positive even if the violations are not quantified.
+      constraintViolation = std::max(constraintViolation, std::numeric_limits< C_FLOAT64 >::min());
+    }
+
+  return Continue;
+}
+
 bool COptProblem::calculateStatistics(const C_FLOAT64 & factor,
                                       const C_FLOAT64 & resolution)
 {
+  // The statistics require complete evaluations.
+  mObjectiveBound = std::numeric_limits< C_FLOAT64 >::infinity();
+
   // Set the current values to the solution values.
   size_t imax = mSolutionVariables.size();
 
@@ -698,7 +900,22 @@ bool COptProblem::setSolution(const C_FLOAT64 & value,
   mSolutionValue = *mpParmMaximize ? -value : value;
 
   // The initialization call from SRES and GASR have NULL as variables
-  if (variables.size() != 0)
+  if (variables.size() != 0 &&
+      mFixedOptItem != C_INVALID_INDEX &&
+      variables.size() + 1 == mContainerVariables.size())
+    {
+      // The variables do not include the fixed item.
+      mSolutionVariables.resize(mContainerVariables.size());
+
+      const C_FLOAT64 * pVariable = variables.array();
+      C_FLOAT64 * pSolution = mSolutionVariables.array();
+      C_FLOAT64 * pSolutionEnd = pSolution + mSolutionVariables.size();
+      size_t i = 0;
+
+      for (; pSolution != pSolutionEnd; ++pSolution, ++i)
+        *pSolution = (i == mFixedOptItem) ? *mContainerVariables[i] : *pVariable++;
+    }
+  else if (variables.size() != 0)
     mSolutionVariables = variables;
 
   bool Continue = true;
@@ -742,13 +959,51 @@ bool COptProblem::swapOptItem(const size_t & iFrom,
 {return mpGrpItems->swap(iFrom, iTo);}
 
 const std::vector< COptItem * > & COptProblem::getOptItemList() const
-{return *mpOptItems;}
+{return (mFixedOptItem != C_INVALID_INDEX) ? mFreeOptItems : *mpOptItems;}
 
 const std::vector< COptItem * > & COptProblem::getConstraintList() const
 {return *mpConstraintItems;}
 
 CVectorCore< C_FLOAT64 * > & COptProblem::getContainerVariables() const
-{return mContainerVariables;}
+{return (mFixedOptItem != C_INVALID_INDEX) ? mFreeContainerVariables : mContainerVariables;}
+
+bool COptProblem::fixOptItem(const size_t & index, const C_FLOAT64 & value)
+{
+  if (mpOptItems == NULL ||
+      index >= mContainerVariables.size() ||
+      mContainerVariables.size() != mpOptItems->size())
+    return false;
+
+  if (index != mFixedOptItem)
+    {
+      mFixedOptItem = index;
+
+      mFreeOptItems = *mpOptItems;
+      mFreeOptItems.erase(mFreeOptItems.begin() + index);
+
+      mFreeContainerVariables.resize(mContainerVariables.size() - 1);
+      C_FLOAT64 ** ppFree = mFreeContainerVariables.array();
+      size_t i, imax = mContainerVariables.size();
+
+      for (i = 0; i < imax; ++i)
+        if (i != index)
+          *ppFree++ = mContainerVariables[i];
+    }
+
+  *mContainerVariables[index] = value;
+
+  return true;
+}
+
+void COptProblem::releaseOptItem()
+{
+  mFixedOptItem = C_INVALID_INDEX;
+  mFreeOptItems.clear();
+  mFreeContainerVariables.resize(0);
+}
+
+const size_t & COptProblem::getFixedOptItem() const
+{return mFixedOptItem;}
 
 bool COptProblem::setObjectiveFunction(const std::string & infix)
 {
@@ -876,6 +1131,21 @@ const unsigned C_INT32 & COptProblem::getFailedEvaluationsExc() const
 const unsigned C_INT32 & COptProblem::getFailedEvaluationsNaN() const
 {return mFailedCounterNaN;}
 
+const unsigned C_INT32 & COptProblem::getCacheHits() const
+{return mValueCache.getHits();}
+
+const unsigned C_INT32 & COptProblem::getCacheMisses() const
+{return mValueCache.getMisses();}
+
+void COptProblem::setObjectiveBound(const C_FLOAT64 & bound)
+{mObjectiveBound = bound;}
+
+const C_FLOAT64 & COptProblem::getObjectiveBound() const
+{return mObjectiveBound;}
+
+const unsigned C_INT32 & COptProblem::getTerminatedEvaluations() const
+{return mTerminatedCounter;}
+
 const C_FLOAT64 & COptProblem::getExecutionTime() const
 {
   return mCPUTime.getElapsedTimeSeconds();
@@ -902,6 +1172,16 @@ void COptProblem::printResult(std::ostream * ostream) const
      << CCopasiTimeVariable::LL2String(CPUTime.getSeconds(), 1) << "."
      << CCopasiTimeVariable::LL2String(CPUTime.getMilliSeconds(true), 3) << std::endl;
   os << "    Evaluations/Second [1/s]:\t" << mCounter / (C_FLOAT64)(CPUTime.getMilliSeconds() / 1e3) << std::endl;
+
+  if (mValueCache.getSize() > 0)
+    {
+      os << "    Cache Hits:\t" << mValueCache.getHits() << std::endl;
+      os << "    Cache Misses:\t" << mValueCache.getMisses() << std::endl;
+    }
+
+  if (mTerminatedCounter > 0)
+    os << "    Terminated Evaluations:\t" << mTerminatedCounter << std::endl;
+
   os << std::endl;
 
   std::vector< COptItem * >::const_iterator itItem =
@@ -41,6 +41,10 @@
 
 #include "function/CExpression.h"
 
+#include "optimization/COptTrace.h"
+#include "optimization/COptValueCache.h"
+#include "optimization/COptWarmStartStore.h"
+
 class CSteadyStateTask;
 class CTrajectoryTask;
 class COptItem;
@@ -118,6 +122,28 @@ public:
    */
   virtual bool calculate();
 
+  /**
+   * Calculate the objective values of a batch of points, e.g., the offspring
+   * of a generation. For each point the free container variables are set, the
+   * objective value is calculated, and the functional constraints are checked.
+   * The default implementation evaluates the points one after another. Derived
+   * problems may evaluate them in a different order or concurrently as long as
+   * the results do not change.
+   * @param const std::vector< CVector< C_FLOAT64 > * > & points
+   * @param CVector< C_FLOAT64 > & values
+   * @param CVector< C_FLOAT64 > & constraintViolations (positive if a functional constraint is violated)
+   * @result bool continue
+   */
+  virtual bool calculateBatch(const std::vector< CVector< C_FLOAT64 > * > & points,
+                              CVector< C_FLOAT64 > & values,
+                              CVector< C_FLOAT64 > & constraintViolations);
+
+  /**
+   * Check whether batches of points are calculated concurrently
+   * @result bool isBatchParallel
+   */
+  virtual bool isBatchParallel();
+
   /**
    * Reset counters and objective value.
    */
@@ -175,6 +201,29 @@ public:
    */
   CVectorCore< C_FLOAT64 * > & getContainerVariables() const;
 
+  /**
+   * Fix the optimization item with the given index at the given value. The
+   * fixed item is hidden from the optimization methods, i.e., the lists of
+   * optimization items and container variables only contain the free items.
+   * The solution variables always contain all items. Fixing an item is reset
+   * by initialize() and must therefore be done afterwards.
+   * @param const size_t & index
+   * @param const C_FLOAT64 & value
+   * @return bool success
+   */
+  bool fixOptItem(const size_t & index, const C_FLOAT64 & value);
+
+  /**
+   * Release a fixed optimization item
+   */
+  void releaseOptItem();
+
+  /**
+   * Retrieve the index of the fixed optimization item
+   * @return const size_t & index (C_INVALID_INDEX if no item is fixed)
+   */
+  const size_t & getFixedOptItem() const;
+
   /**
    * Retrieve the result of a calculation
    */
@@ -342,6 +391,40 @@ public:
    */
   const unsigned C_INT32 & getFailedEvaluationsNaN() const;
 
+  /**
+   * Retrieve the number of evaluations answered by the objective value cache
+   * @return const unsigned C_INT32 & cacheHits
+   */
+  const unsigned C_INT32 & getCacheHits() const;
+
+  /**
+   * Retrieve the number of evaluations not found in the objective value cache
+   * @return const unsigned C_INT32 & cacheMisses
+   */
+  const unsigned C_INT32 & getCacheMisses() const;
+
+  /**
+   * Set the bound above which an evaluation may be terminated early. A
+   * terminated evaluation reports the worst value, i.e., it is never preferred
+   * to a completely evaluated point. Methods must only set a bound if they
+   * discard such points anyway. Use infinity to disable early termination.
+   * @param const C_FLOAT64 & bound
+   */
+  void setObjectiveBound(const C_FLOAT64 & bound);
+
+  /**
+   * Retrieve the bound above which an evaluation may be terminated early
+   * @return const C_FLOAT64 & bound
+   */
+  const C_FLOAT64 & getObjectiveBound() const;
+
+  /**
+   * Retrieve the number of evaluations terminated early since the objective
+   * value exceeded the bound
+   * @return const unsigned C_INT32 & terminatedEvaluations
+   */
+  const unsigned C_INT32 & getTerminatedEvaluations() const;
+
   /**
    * Retrieve the objective function.
    * @return const C_FLOAT64 & executionTime
@@ -395,6 +478,54 @@ private:
   static C_FLOAT64 MissingValue;
 
 protected:
+  /**
+   * Look up the objective value of the current variables in the cache. Results
+   * which need to be stored are never taken from the cache. Since a cache hit
+   * does not update the container the cache is disabled for problems with
+   * functional constraints.
+   * @param CVector< C_FLOAT64 > * pData (default: NULL)
+   * @return bool found
+   */
+  bool findCachedValue(CVector< C_FLOAT64 > * pData = NULL);
+
+  /**
+   * Store the objective value of the current variables in the cache. Only
+   * successful evaluations must be stored.
+   * @param const CVector< C_FLOAT64 > * pData (default: NULL)
+   */
+  void cacheValue(const CVector< C_FLOAT64 > * pData = NULL);
+
+  /**
+   * Process the steady state task. If warm starts are enabled (off by default)
+   * the task starts from the steady state found for the closest previously
+   * evaluated point. For models with more than one steady state this may lead
+   * to a different steady state than starting from the initial state.
+   * @param CSteadyStateTask * pTask
+   * @param const COptWarmStartStore::Slot & slot
+   * @return bool success
+   */
+  bool processSteadyState(CSteadyStateTask * pTask, const COptWarmStartStore::Slot & slot);
+
+  /**
+   * Record the evaluation of the current variables in the evaluation trace
+   * if tracing is enabled.
+   * @param const CCopasiTimeVariable & start
+   * @param const COptTrace::Status & status
+   */
+  void traceEvaluation(const CCopasiTimeVariable & start, const COptTrace::Status & status);
+
+  /**
+   * Calculate the objective value of a single point of a batch and the sum of
+   * the squared violations of the functional constraints.
+   * @param const CVector< C_FLOAT64 > & point
+   * @param C_FLOAT64 & value
+   * @param C_FLOAT64 & constraintViolation
+   * @result bool continue
+   */
+  bool calculatePoint(const CVector< C_FLOAT64 > & point,
+                      C_FLOAT64 & value,
+                      C_FLOAT64 & constraintViolation);
+
   /**
    * A static value containing Infinity.
    */
@@ -431,6 +562,31 @@ protected:
    */
   bool * mpParmCalculateStatistics;
 
+  /**
+   * A pointer to the value of the CCopasiParameter holding Objective Value Cache Size
+   */
+  unsigned C_INT32 * mpParmCacheSize;
+
+  /**
+   * A pointer to the value of the CCopasiParameter holding Warm Start Steady State
+   */
+  bool * mpParmWarmStart;
+
+  /**
+   * A pointer to the value of the CCopasiParameter holding Evaluation Trace File
+   */
+  std::string * mpParmTraceFile;
+
+  /**
+   * A pointer to the value of the CCopasiParameter holding Evaluation Trace Buffer Size
+   */
+  unsigned C_INT32 * mpParmTraceBufferSize;
+
+  /**
+   * A pointer to the value of the CCopasiParameter holding Evaluation Trace Ring Buffer
+   */
+  bool * mpParmTraceRingBuffer;
+
   /**
    * A pointer to the value of the CCopasiParameterGroup holding the OptimizationItems
    */
@@ -504,6 +660,21 @@ protected:
    */
   mutable CVector< C_FLOAT64 * > mContainerVariables;
 
+  /**
+   * The index of the fixed optimization item
+   */
+  size_t mFixedOptItem;
+
+  /**
+   * The list of optimization items which are not fixed
+   */
+  std::vector< COptItem * > mFreeOptItems;
+
+  /**
+   * A vector of pointer to the container variables which are not fixed
+   */
+  mutable CVector< C_FLOAT64 * > mFreeContainerVariables;
+
   /**
    * A vector of solution results
    */
@@ -529,6 +700,16 @@ protected:
    */
   unsigned C_INT32 mConstraintCounter;
 
+  /**
+   * Counter of evaluations terminated early
+   */
+  unsigned C_INT32 mTerminatedCounter;
+
+  /**
+   * The bound above which an evaluation may be terminated early
+   */
+  C_FLOAT64 mObjectiveBound;
+
   /**
    * Counter of failed constraint checks
    */
@@ -565,6 +746,27 @@ protected:
    * The gradient vector for the parameters
    */
   CVector< C_FLOAT64 > mGradient;
+
+  /**
+   * The cache of the objective values of already evaluated points
+   */
+  COptValueCache mValueCache;
+
+  /**
+   * The steady states of the most recently evaluated points
+   */
+  COptWarmStartStore mWarmStarts;
+
+  /**
+   * The evaluation trace owned by the problem
+   */
+  COptTrace mTrace;
+
+  /**
+   * A pointer to the evaluation trace in use. Workers record into the trace
+   * of the problem they are created from.
+   */
+  COptTrace * mpTrace;
 };
 
 #endif  // the end
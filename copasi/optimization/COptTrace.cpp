@@ -0,0 +1,175 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "copasi/copasi.h"
+
+#include "optimization/COptTrace.h"
+#include "commandline/CLocaleString.h"
+#include "copasi/core/CContext.h"
+
+COptTrace::COptTrace():
+  mFile(),
+  mStart(),
+  mVariableCount(0),
+  mRecordSize(0),
+  mCapacity(0),
+  mRingBuffer(false),
+  mBuffer(),
+  mFirst(0),
+  mSize(0),
+  mRecordCount(0)
+{}
+
+COptTrace::~COptTrace()
+{
+  close();
+}
+
+bool COptTrace::open(const std::string & fileName,
+                     const std::vector< std::string > & variableNames,
+                     const size_t & bufferSize,
+                     const bool & ringBuffer)
+{
+  close();
+
+  mFile.open(CLocaleString::fromUtf8(fileName).c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (mFile.fail())
+    return false;
+
+  mStart = CCopasiTimeVariable::getCurrentWallTime();
+  mVariableCount = variableNames.size();
+  mRecordSize = 2 * sizeof(unsigned C_INT32) + 3 * sizeof(C_INT64) + (mVariableCount + 1) * sizeof(C_FLOAT64);
+  mCapacity = std::max< size_t >(bufferSize, 1);
+  mRingBuffer = ringBuffer;
+  mBuffer.resize(mCapacity * mRecordSize);
+  mFirst = 0;
+  mSize = 0;
+  mRecordCount = 0;
+
+  unsigned C_INT32 Version = 1;
+  unsigned C_INT32 ByteOrder = 0x01020304;
+  unsigned C_INT32 Count = (unsigned C_INT32) mVariableCount;
+
+  mFile.write("COPASIOT", 8);
+  mFile.write((const char *) &Version, sizeof(Version));
+  mFile.write((const char *) &ByteOrder, sizeof(ByteOrder));
+  mFile.write((const char *) &Count, sizeof(Count));
+
+  std::vector< std::string >::const_iterator it = variableNames.begin();
+  std::vector< std::string >::const_iterator end = variableNames.end();
+
+  for (; it != end; ++it)
+    {
+      unsigned C_INT32 Length = (unsigned C_INT32) it->size();
+      mFile.write((const char *) &Length, sizeof(Length));
+      mFile.write(it->c_str(), Length);
+    }
+
+  return !mFile.fail();
+}
+
+void COptTrace::close()
+{
+  if (!mFile.is_open())
+    return;
+
+  flush();
+  mFile.close();
+
+  mBuffer.clear();
+  mCapacity = 0;
+}
+
+bool COptTrace::isOpen() const
+{
+  return mFile.is_open();
+}
+
+void COptTrace::record(const CCopasiTimeVariable & start,
+                       const CVectorCore< C_FLOAT64 * > & variables,
+                       const C_FLOAT64 & value,
+                       const Status & status)
+{
+  if (mCapacity == 0)
+    return;
+
+  C_INT64 Now = CCopasiTimeVariable::getCurrentWallTime().getMicroSeconds();
+
+  C_INT64 Start = start.getMicroSeconds() - mStart.getMicroSeconds();
+  C_INT64 Duration = Now - start.getMicroSeconds();
+  unsigned C_INT32 StatusCode = status;
+  unsigned C_INT32 Thread = (unsigned C_INT32) CContext< size_t >::localIndex();
+
+#ifdef USE_OMP
+#pragma omp critical (COptTrace)
+#endif // USE_OMP
+  {
+    if (mSize == mCapacity)
+      {
+        if (mRingBuffer)
+          {
+            // Overwrite the oldest record.
+            mFirst = (mFirst + 1) % mCapacity;
+            mSize--;
+          }
+        else
+          flush();
+      }
+
+    char * pRecord = mBuffer.data() + ((mFirst + mSize) % mCapacity) * mRecordSize;
+
+    memcpy(pRecord, &mRecordCount, sizeof(C_INT64));
+    pRecord += sizeof(C_INT64);
+    memcpy(pRecord, &Start, sizeof(C_INT64));
+    pRecord += sizeof(C_INT64);
+    memcpy(pRecord, &Duration, sizeof(C_INT64));
+    pRecord += sizeof(C_INT64);
+    memcpy(pRecord, &value, sizeof(C_FLOAT64));
+    pRecord += sizeof(C_FLOAT64);
+    memcpy(pRecord, &StatusCode, sizeof(unsigned C_INT32));
+    pRecord += sizeof(unsigned C_INT32);
+    memcpy(pRecord, &Thread, sizeof(unsigned C_INT32));
+    pRecord += sizeof(unsigned C_INT32);
+
+    // Variables not matching the header are recorded as NaN.
+    C_FLOAT64 * const * ppVariable = variables.array();
+
+    for (size_t i = 0; i < mVariableCount; ++i, pRecord += sizeof(C_FLOAT64))
+      {
+        C_FLOAT64 Value = i < variables.size() ? *ppVariable[i] : std::numeric_limits< C_FLOAT64 >::quiet_NaN();
+        memcpy(pRecord, &Value, sizeof(C_FLOAT64));
+      }
+
+    mSize++;
+    mRecordCount++;
+  }
+}
+
+const unsigned C_INT64 & COptTrace::getRecordCount() const
+{
+  return mRecordCount;
+}
+
+void COptTrace::flush()
+{
+  if (mSize == 0)
+    return;
+
+  // The buffered records may wrap around the end of the buffer.
+  size_t Head = std::min(mSize, mCapacity - mFirst);
+
+  mFile.write(mBuffer.data() + mFirst * mRecordSize, Head * mRecordSize);
+
+  if (Head < mSize)
+    mFile.write(mBuffer.data(), (mSize - Head) * mRecordSize);
+
+  mFirst = 0;
+  mSize = 0;
+}
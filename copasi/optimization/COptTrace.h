@@ -0,0 +1,161 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_COptTrace
+#define COPASI_COptTrace
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "copasi/core/CVector.h"
+#include "utilities/CopasiTime.h"
+
+/**
+ * The class COptTrace records every evaluation of the objective function of
+ * an optimization problem in a binary file. The records are collected in a
+ * buffer of fixed size which is written when it is full. In ring buffer mode
+ * only the most recent records are kept and written when the trace is closed.
+ *
+ * The file starts with a header:
+ *   char[8] magic "COPASIOT"
+ *   uint32 version (1)
+ *   uint32 byte order mark 0x01020304 in the byte order of the writer
+ *   uint32 number of variables n
+ *   n times: uint32 length followed by the common name of the variable
+ * Each record is:
+ *   uint64 sequence number of the evaluation
+ *   int64 start time in microseconds since the trace was opened
+ *   int64 duration in microseconds
+ *   double objective value
+ *   uint32 status
+ *   uint32 thread
+ *   n times: double value of the variable
+ */
+class COptTrace
+{
+public:
+  /**
+   * The outcome of an evaluation
+   */
+  enum Status
+  {
+    success = 0,
+    cached,
+    exception,
+    notANumber,
+    terminated
+  };
+
+  /**
+   * Constructor
+   */
+  COptTrace();
+
+  /**
+   * Destructor. The trace is closed.
+   */
+  ~COptTrace();
+
+  /**
+   * Open the trace file and write the header
+   * @param const std::string & fileName
+   * @param const std::vector< std::string > & variableNames
+   * @param const size_t & bufferSize number of records kept in memory
+   * @param const bool & ringBuffer
+   * @return bool success
+   */
+  bool open(const std::string & fileName,
+            const std::vector< std::string > & variableNames,
+            const size_t & bufferSize,
+            const bool & ringBuffer);
+
+  /**
+   * Write all buffered records and close the trace file.
+   */
+  void close();
+
+  /**
+   * Check whether the trace is open
+   * @return bool isOpen
+   */
+  bool isOpen() const;
+
+  /**
+   * Record an evaluation. This method may be called concurrently.
+   * @param const CCopasiTimeVariable & start
+   * @param const CVectorCore< C_FLOAT64 * > & variables
+   * @param const C_FLOAT64 & value
+   * @param const Status & status
+   */
+  void record(const CCopasiTimeVariable & start,
+              const CVectorCore< C_FLOAT64 * > & variables,
+              const C_FLOAT64 & value,
+              const Status & status);
+
+  /**
+   * Retrieve the number of recorded evaluations
+   * @return const unsigned C_INT64 & count
+   */
+  const unsigned C_INT64 & getRecordCount() const;
+
+private:
+  /**
+   * Write the buffered records in chronological order and empty the buffer.
+   */
+  void flush();
+
+  /**
+   * The trace file
+   */
+  std::ofstream mFile;
+
+  /**
+   * The time the trace was opened
+   */
+  CCopasiTimeVariable mStart;
+
+  /**
+   * The number of variables of each record
+   */
+  size_t mVariableCount;
+
+  /**
+   * The size of a record in bytes
+   */
+  size_t mRecordSize;
+
+  /**
+   * The maximal number of buffered records
+   */
+  size_t mCapacity;
+
+  /**
+   * Indicates whether only the most recent records are kept
+   */
+  bool mRingBuffer;
+
+  /**
+   * The buffered records
+   */
+  std::vector< char > mBuffer;
+
+  /**
+   * The index of the oldest buffered record
+   */
+  size_t mFirst;
+
+  /**
+   * The number of buffered records
+   */
+  size_t mSize;
+
+  /**
+   * The number of recorded evaluations
+   */
+  unsigned C_INT64 mRecordCount;
+};
+
+#endif // COPASI_COptTrace
@@ -0,0 +1,159 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include <cmath>
+#include <limits>
+
+#include "copasi/copasi.h"
+
+#include "optimization/COptValueCache.h"
+
+size_t COptValueCache::KeyHash::operator()(const Key & key) const
+{
+  size_t Hash = key.size();
+
+  Key::const_iterator it = key.begin();
+  Key::const_iterator end = key.end();
+
+  for (; it != end; ++it)
+    Hash ^= std::hash< C_INT64 >()(*it) + 0x9e3779b9 + (Hash << 6) + (Hash >> 2);
+
+  return Hash;
+}
+
+COptValueCache::COptValueCache():
+  mEntries(),
+  mIndex(),
+  mSize(0),
+  mHits(0),
+  mMisses(0),
+  mKey()
+{}
+
+COptValueCache::~COptValueCache()
+{}
+
+void COptValueCache::setSize(const size_t & size)
+{
+  mSize = size;
+  clear();
+}
+
+const size_t & COptValueCache::getSize() const
+{
+  return mSize;
+}
+
+void COptValueCache::clear()
+{
+  mEntries.clear();
+  mIndex.clear();
+  mHits = 0;
+  mMisses = 0;
+}
+
+bool COptValueCache::find(const CVectorCore< C_FLOAT64 * > & variables,
+                          C_FLOAT64 & value,
+                          CVector< C_FLOAT64 > * pData)
+{
+  if (mSize == 0)
+    return false;
+
+  createKey(variables, mKey);
+
+  std::unordered_map< Key, std::list< Entry >::iterator, KeyHash >::const_iterator found = mIndex.find(mKey);
+
+  if (found == mIndex.end())
+    {
+      mMisses++;
+      return false;
+    }
+
+  mHits++;
+
+  // Mark the entry as most recently used.
+  mEntries.splice(mEntries.begin(), mEntries, found->second);
+
+  value = found->second->value;
+
+  if (pData != NULL)
+    *pData = found->second->data;
+
+  return true;
+}
+
+void COptValueCache::insert(const CVectorCore< C_FLOAT64 * > & variables,
+                            const C_FLOAT64 & value,
+                            const CVector< C_FLOAT64 > * pData)
+{
+  if (mSize == 0)
+    return;
+
+  createKey(variables, mKey);
+
+  if (mIndex.find(mKey) != mIndex.end())
+    return;
+
+  // Reuse the least recently used entry if the cache is full.
+  if (mEntries.size() >= mSize)
+    {
+      mIndex.erase(mEntries.back().key);
+      mEntries.splice(mEntries.begin(), mEntries, --mEntries.end());
+    }
+  else
+    {
+      mEntries.push_front(Entry());
+    }
+
+  Entry & New = mEntries.front();
+  New.key = mKey;
+  New.value = value;
+
+  if (pData != NULL)
+    New.data = *pData;
+  else
+    New.data.resize(0);
+
+  mIndex[New.key] = mEntries.begin();
+}
+
+const unsigned C_INT32 & COptValueCache::getHits() const
+{
+  return mHits;
+}
+
+const unsigned C_INT32 & COptValueCache::getMisses() const
+{
+  return mMisses;
+}
+
+// static
+void COptValueCache::createKey(const CVectorCore< C_FLOAT64 * > & variables, Key & key)
+{
+  key.resize(2 * variables.size());
+
+  C_FLOAT64 * const * ppVariable = variables.array();
+  C_FLOAT64 * const * ppVariableEnd = ppVariable + variables.size();
+  Key::iterator itKey = key.begin();
+
+  for (; ppVariable != ppVariableEnd; ++ppVariable)
+    {
+      const C_FLOAT64 & Value = **ppVariable;
+
+      if (std::isfinite(Value))
+        {
+          int Exponent;
+          C_FLOAT64 Mantissa = frexp(Value, &Exponent);
+
+          *itKey++ = Exponent;
+          *itKey++ = (C_INT64) floor(ldexp(Mantissa, 40) + 0.5);
+        }
+      else
+        {
+          *itKey++ = std::numeric_limits< C_INT64 >::max();
+          *itKey++ = std::isnan(Value) ? 0 : (Value > 0 ? 1 : -1);
+        }
+    }
+}
@@ -0,0 +1,141 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_COptValueCache
+#define COPASI_COptValueCache
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "copasi/core/CVector.h"
+
+/**
+ * The class COptValueCache is a bounded least recently used cache of the
+ * objective values of an optimization problem. The key is the vector of
+ * variable values quantized to a relative resolution of 2^-40, i.e., points
+ * which only differ by round off errors share an entry. Besides the value an
+ * entry may hold additional data, e.g., the residuals of a fit problem.
+ */
+class COptValueCache
+{
+public:
+  /**
+   * Constructor
+   */
+  COptValueCache();
+
+  /**
+   * Destructor
+   */
+  ~COptValueCache();
+
+  /**
+   * Set the maximal number of entries. A size of 0 disables the cache.
+   * All entries and the counters are cleared.
+   * @param const size_t & size
+   */
+  void setSize(const size_t & size);
+
+  /**
+   * Retrieve the maximal number of entries
+   * @return const size_t & size
+   */
+  const size_t & getSize() const;
+
+  /**
+   * Remove all entries and reset the counters
+   */
+  void clear();
+
+  /**
+   * Find the entry for the current values of the variables. On success the
+   * entry becomes the most recently used.
+   * @param const CVectorCore< C_FLOAT64 * > & variables
+   * @param C_FLOAT64 & value
+   * @param CVector< C_FLOAT64 > * pData (default: NULL)
+   * @return bool found
+   */
+  bool find(const CVectorCore< C_FLOAT64 * > & variables,
+            C_FLOAT64 & value,
+            CVector< C_FLOAT64 > * pData = NULL);
+
+  /**
+   * Insert an entry for the current values of the variables. The least
+   * recently used entry is removed if the cache is full.
+   * @param const CVectorCore< C_FLOAT64 * > & variables
+   * @param const C_FLOAT64 & value
+   * @param const CVector< C_FLOAT64 > * pData (default: NULL)
+   */
+  void insert(const CVectorCore< C_FLOAT64 * > & variables,
+              const C_FLOAT64 & value,
+              const CVector< C_FLOAT64 > * pData = NULL);
+
+  /**
+   * Retrieve the number of successful lookups
+   * @return const unsigned C_INT32 & hits
+   */
+  const unsigned C_INT32 & getHits() const;
+
+  /**
+   * Retrieve the number of failed lookups
+   * @return const unsigned C_INT32 & misses
+   */
+  const unsigned C_INT32 & getMisses() const;
+
+private:
+  typedef std::vector< C_INT64 > Key;
+
+  struct KeyHash
+  {
+    size_t operator()(const Key & key) const;
+  };
+
+  struct Entry
+  {
+    Key key;
+    C_FLOAT64 value;
+    CVector< C_FLOAT64 > data;
+  };
+
+  /**
+   * Create the quantized key for the current values of the variables
+   * @param const CVectorCore< C_FLOAT64 * > & variables
+   * @param Key & key
+   */
+  static void createKey(const CVectorCore< C_FLOAT64 * > & variables, Key & key);
+
+  /**
+   * The entries ordered from most to least recently used
+   */
+  std::list< Entry > mEntries;
+
+  /**
+   * The index of the entries
+   */
+  std::unordered_map< Key, std::list< Entry >::iterator, KeyHash > mIndex;
+
+  /**
+   * The maximal number of entries
+   */
+  size_t mSize;
+
+  /**
+   * The number of successful lookups
+   */
+  unsigned C_INT32 mHits;
+
+  /**
+   * The number of failed lookups
+   */
+  unsigned C_INT32 mMisses;
+
+  /**
+   * The key of the last lookup
+   */
+  Key mKey;
+};
+
+#endif // COPASI_COptValueCache
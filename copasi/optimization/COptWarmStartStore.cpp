@@ -0,0 +1,99 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "copasi/copasi.h"
+
+#include "optimization/COptWarmStartStore.h"
+
+COptWarmStartStore::COptWarmStartStore(const size_t & capacity):
+  mCapacity(capacity),
+  mEntries()
+{}
+
+COptWarmStartStore::~COptWarmStartStore()
+{}
+
+void COptWarmStartStore::clear()
+{
+  mEntries.clear();
+}
+
+const CVectorCore< C_FLOAT64 > * COptWarmStartStore::find(const Slot & slot,
+    const CVectorCore< C_FLOAT64 * > & variables) const
+{
+  std::map< Slot, std::deque< Entry > >::const_iterator found = mEntries.find(slot);
+
+  if (found == mEntries.end())
+    return NULL;
+
+  const CVectorCore< C_FLOAT64 > * pState = NULL;
+  C_FLOAT64 MinDistance = std::numeric_limits< C_FLOAT64 >::infinity();
+
+  std::deque< Entry >::const_iterator it = found->second.begin();
+  std::deque< Entry >::const_iterator end = found->second.end();
+
+  for (; it != end; ++it)
+    {
+      if (it->point.size() != variables.size())
+        continue;
+
+      // We use the relative distance since the variables may differ by orders of magnitude.
+      C_FLOAT64 Distance = 0.0;
+      const C_FLOAT64 * pPoint = it->point.array();
+      C_FLOAT64 * const * ppVariable = variables.array();
+      C_FLOAT64 * const * ppVariableEnd = ppVariable + variables.size();
+
+      for (; ppVariable != ppVariableEnd; ++ppVariable, ++pPoint)
+        {
+          C_FLOAT64 Scale = std::max(fabs(**ppVariable), fabs(*pPoint));
+
+          if (Scale > 0.0)
+            {
+              C_FLOAT64 Difference = (**ppVariable - *pPoint) / Scale;
+              Distance += Difference * Difference;
+            }
+        }
+
+      if (Distance < MinDistance)
+        {
+          MinDistance = Distance;
+          pState = &it->state;
+        }
+    }
+
+  return pState;
+}
+
+void COptWarmStartStore::insert(const Slot & slot,
+                                const CVectorCore< C_FLOAT64 * > & variables,
+                                const CVectorCore< C_FLOAT64 > & state)
+{
+  if (mCapacity == 0)
+    return;
+
+  std::deque< Entry > & Entries = mEntries[slot];
+
+  // Remove the oldest entry if the slot is full.
+  if (Entries.size() >= mCapacity)
+    Entries.pop_back();
+
+  Entries.push_front(Entry());
+
+  Entry & New = Entries.front();
+  New.point.resize(variables.size());
+
+  C_FLOAT64 * pPoint = New.point.array();
+  C_FLOAT64 * const * ppVariable = variables.array();
+  C_FLOAT64 * const * ppVariableEnd = ppVariable + variables.size();
+
+  for (; ppVariable != ppVariableEnd; ++ppVariable, ++pPoint)
+    *pPoint = **ppVariable;
+
+  New.state = state;
+}
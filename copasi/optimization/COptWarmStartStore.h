@@ -0,0 +1,88 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_COptWarmStartStore
+#define COPASI_COptWarmStartStore
+
+#include <deque>
+#include <map>
+#include <utility>
+
+#include "copasi/core/CVector.h"
+
+/**
+ * The class COptWarmStartStore keeps the steady states found for the most
+ * recently evaluated points of an optimization problem. A slot identifies a
+ * steady state calculation within a single evaluation, e.g., an experiment and
+ * its data row. For each slot at most a fixed number of states is kept and
+ * the state of the point closest to the current one is used as the starting
+ * guess of the next calculation.
+ *
+ * Note, for models with more than one steady state a calculation started from
+ * a stored state may converge to a different steady state than a calculation
+ * started from the initial state, i.e., results may differ. Warm starts are
+ * therefore only used if explicitly enabled for the problem.
+ */
+class COptWarmStartStore
+{
+public:
+  typedef std::pair< size_t, size_t > Slot;
+
+  /**
+   * Constructor
+   * @param const size_t & capacity (default: 8)
+   */
+  COptWarmStartStore(const size_t & capacity = 8);
+
+  /**
+   * Destructor
+   */
+  ~COptWarmStartStore();
+
+  /**
+   * Remove all stored states
+   */
+  void clear();
+
+  /**
+   * Find the state stored for the point closest to the current values of the
+   * variables.
+   * @param const Slot & slot
+   * @param const CVectorCore< C_FLOAT64 * > & variables
+   * @return const CVectorCore< C_FLOAT64 > * pState (NULL if none is stored)
+   */
+  const CVectorCore< C_FLOAT64 > * find(const Slot & slot,
+                                        const CVectorCore< C_FLOAT64 * > & variables) const;
+
+  /**
+   * Store the state for the current values of the variables. The oldest state
+   * of the slot is removed if the capacity is exceeded.
+   * @param const Slot & slot
+   * @param const CVectorCore< C_FLOAT64 * > & variables
+   * @param const CVectorCore< C_FLOAT64 > & state
+   */
+  void insert(const Slot & slot,
+              const CVectorCore< C_FLOAT64 * > & variables,
+              const CVectorCore< C_FLOAT64 > & state);
+
+private:
+  struct Entry
+  {
+    CVector< C_FLOAT64 > point;
+    CVector< C_FLOAT64 > state;
+  };
+
+  /**
+   * The maximal number of states per slot
+   */
+  size_t mCapacity;
+
+  /**
+   * The stored states of each slot, most recent first
+   */
+  std::map< Slot, std::deque< Entry > > mEntries;
+};
+
+#endif // COPASI_COptWarmStartStore
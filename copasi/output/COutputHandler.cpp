@@ -3,6 +3,8 @@
 // of Connecticut School of Medicine.
 // All rights reserved.
 
+#include <limits>
+
 #include "copasi.h"
 
 #include "COutputHandler.h"
@@ -19,7 +21,10 @@ COutputHandler::COutputHandler():
   mInterfaces(),
   mpMaster(NULL),
   mUpdateSequence(),
-  mpContainer(NULL)
+  mInterfaceUpdates(),
+  mScheduled(false),
+  mpContainer(NULL),
+  mpContainerTime(NULL)
 {}
 
 COutputHandler::COutputHandler(const COutputHandler & src):
@@ -27,7 +32,10 @@ COutputHandler::COutputHandler(const COutputHandler & src):
   mInterfaces(src.mInterfaces),
   mpMaster(src.mpMaster),
   mUpdateSequence(src.mUpdateSequence),
-  mpContainer(NULL)
+  mInterfaceUpdates(),
+  mScheduled(false),
+  mpContainer(NULL),
+  mpContainerTime(NULL)
 {}
 
 COutputHandler::~COutputHandler() {};
@@ -49,8 +57,12 @@ bool COutputHandler::compile(CObjectInterface::ContainerList listOfContainer)
 
   assert(mpContainer != NULL);
 
+  mpContainerTime = mpContainer->getState(false).array() + mpContainer->getCountFixedEventTargets();
+
   bool success = true;
   mObjects.clear();
+  mInterfaceUpdates.clear();
+  mScheduled = false;
 
   std::set< COutputInterface *>::iterator it = mInterfaces.begin();
   std::set< COutputInterface *>::iterator end = mInterfaces.end();
@@ -72,6 +84,12 @@ bool COutputHandler::compile(CObjectInterface::ContainerList listOfContainer)
 
       for (itObj = Objects.begin(), endObj = Objects.end(); itObj != endObj; ++itObj)
         mObjects.insert(*itObj);
+
+      InterfaceUpdate & Update = mInterfaceUpdates[*it];
+      Update.NextTime = -std::numeric_limits< C_FLOAT64 >::infinity();
+      Update.Due = true;
+
+      mScheduled |= ((*it)->getOutputInterval() > 0.0);
     }
 
   if (mpMaster == NULL)
@@ -82,20 +100,46 @@ bool COutputHandler::compile(CObjectInterface::ContainerList listOfContainer)
 
 void COutputHandler::output(const Activity & activity)
 {
-  if (mpMaster == NULL)
-    applyUpdateSequence();
-
   std::set< COutputInterface *>::iterator it = mInterfaces.begin();
   std::set< COutputInterface *>::iterator end = mInterfaces.end();
 
+  // Output intervals only apply to the steps of a task.
+  if (activity != DURING || !mScheduled)
+    {
+      if (mpMaster == NULL)
+        applyUpdateSequence();
+
+      for (; it != end; ++it)
+        (*it)->output(activity);
+
+      return;
+    }
+
+  if (updateDueInterfaces() == 0)
+    return;
+
+  std::map< COutputInterface *, InterfaceUpdate >::const_iterator found;
+
   for (; it != end; ++it)
-    (*it)->output(activity);
+    {
+      found = mInterfaceUpdates.find(*it);
+
+      if (found == mInterfaceUpdates.end() || found->second.Due)
+        (*it)->output(activity);
+    }
 
   return;
 }
 
 void COutputHandler::separate(const Activity & activity)
 {
+  // Each run starts with an output to all interfaces.
+  std::map< COutputInterface *, InterfaceUpdate >::iterator itUpdate = mInterfaceUpdates.begin();
+  std::map< COutputInterface *, InterfaceUpdate >::iterator endUpdate = mInterfaceUpdates.end();
+
+  for (; itUpdate != endUpdate; ++itUpdate)
+    itUpdate->second.NextTime = -std::numeric_limits< C_FLOAT64 >::infinity();
+
   std::set< COutputInterface *>::iterator it = mInterfaces.begin();
   std::set< COutputInterface *>::iterator end = mInterfaces.end();
 
@@ -177,6 +221,17 @@ bool COutputHandler::compileUpdateSequence(const CObjectInterface::ContainerList
   mpContainer->getTransientDependencies().getUpdateSequence(mUpdateSequence, CCore::SimulationContext::Default, mpContainer->getStateObjects(), mObjects,
       mpContainer->getSimulationUpToDateObjects());
 
+  // Interfaces which are not output at every step only compute what they need.
+  if (mScheduled)
+    {
+      std::map< COutputInterface *, InterfaceUpdate >::iterator itUpdate = mInterfaceUpdates.begin();
+      std::map< COutputInterface *, InterfaceUpdate >::iterator endUpdate = mInterfaceUpdates.end();
+
+      for (; itUpdate != endUpdate; ++itUpdate)
+        mpContainer->getTransientDependencies().getUpdateSequence(itUpdate->second.UpdateSequence, CCore::SimulationContext::Default, mpContainer->getStateObjects(), itUpdate->first->getObjects(),
+            mpContainer->getSimulationUpToDateObjects());
+    }
+
   CObjectInterface::ObjectSet::const_iterator it = mObjects.begin();
   CObjectInterface::ObjectSet::const_iterator end = mObjects.end();
 
@@ -188,14 +243,59 @@ bool COutputHandler::compileUpdateSequence(const CObjectInterface::ContainerList
   return true;
 }
 
+size_t COutputHandler::updateDueInterfaces()
+{
+  size_t DueCount = 0;
+
+  std::map< COutputInterface *, InterfaceUpdate >::iterator it = mInterfaceUpdates.begin();
+  std::map< COutputInterface *, InterfaceUpdate >::iterator end = mInterfaceUpdates.end();
+
+  for (; it != end; ++it)
+    {
+      const C_FLOAT64 & Interval = it->first->getOutputInterval();
+      InterfaceUpdate & Update = it->second;
+
+      // An interface is also due if the time was reset, e.g., by a scan without separators.
+      Update.Due = (Interval <= 0.0 ||
+                    *mpContainerTime >= Update.NextTime ||
+                    *mpContainerTime < Update.NextTime - Interval);
+
+      if (Update.Due)
+        {
+          Update.NextTime = *mpContainerTime + Interval;
+          DueCount++;
+        }
+    }
+
+  // Only the master updates the objects.
+  if (mpMaster != NULL || DueCount == 0)
+    return DueCount;
+
+  if (DueCount == mInterfaceUpdates.size())
+    {
+      applyUpdateSequence();
+      return DueCount;
+    }
+
+  CMathContainer * pContainer = const_cast< CMathContainer * >(mpContainer);
+
+  for (it = mInterfaceUpdates.begin(); it != end; ++it)
+    if (it->second.Due)
+      pContainer->applyUpdateSequence(it->second.UpdateSequence);
+
+  return DueCount;
+}
+
 COutputInterface::COutputInterface() :
-  mObjects()
+  mObjects(),
+  mOutputInterval(0.0)
 {
 
 }
 
 COutputInterface::COutputInterface(const COutputInterface & src) :
-  mObjects(src.mObjects)
+  mObjects(src.mObjects),
+  mOutputInterval(src.mOutputInterval)
 {
 
 }
@@ -234,3 +334,13 @@ const CObjectInterface::ObjectSet & COutputInterface::getObjects() const
 {
   return mObjects;
 }
+
+void COutputInterface::setOutputInterval(const C_FLOAT64 & outputInterval)
+{
+  mOutputInterval = outputInterval;
+}
+
+const C_FLOAT64 & COutputInterface::getOutputInterval() const
+{
+  return mOutputInterval;
+}
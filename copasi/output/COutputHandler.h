@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <set>
+#include <map>
 
 #include "copasi/core/CObjectInterface.h"
 #include "copasi/math/CMathUpdateSequence.h"
@@ -87,12 +88,31 @@ public:
    */
   virtual const CObjectInterface::ObjectSet & getObjects() const;
 
+  /**
+   * Set the minimal interval of simulated time between two outputs during a
+   * task. The interface receives output for every step if the interval is not
+   * positive, which is the default.
+   * @param const C_FLOAT64 & outputInterval
+   */
+  void setOutputInterval(const C_FLOAT64 & outputInterval);
+
+  /**
+   * Retrieve the minimal interval of simulated time between two outputs
+   * @return const C_FLOAT64 & outputInterval
+   */
+  const C_FLOAT64 & getOutputInterval() const;
+
   // Attributes
 protected:
   /**
    * All the objects which are output.
    */
   CObjectInterface::ObjectSet mObjects;
+
+  /**
+   * The minimal interval of simulated time between two outputs
+   */
+  C_FLOAT64 mOutputInterval;
 };
 
 /**
@@ -183,6 +203,24 @@ protected:
    */
   bool compileUpdateSequence(const CObjectInterface::ContainerList & listOfContainer);
 
+  /**
+   * Determine for each interface whether it is due for output at the current
+   * time. The update sequences of the due interfaces are applied if this is
+   * the master handler.
+   * @return size_t dueCount
+   */
+  size_t updateDueInterfaces();
+
+  /**
+   * The update sequence and the output schedule of an interface
+   */
+  struct InterfaceUpdate
+  {
+    CCore::CUpdateSequence UpdateSequence;
+    C_FLOAT64 NextTime;
+    bool Due;
+  };
+
   // Attributes
 protected:
   /**
@@ -201,9 +239,25 @@ protected:
    */
   CCore::CUpdateSequence mUpdateSequence;
 
+  /**
+   * The update sequences and output schedules of the individual interfaces.
+   * These are only used if at least one interface has an output interval.
+   */
+  std::map< COutputInterface *, InterfaceUpdate > mInterfaceUpdates;
+
+  /**
+   * Indicates whether at least one interface has an output interval
+   */
+  bool mScheduled;
+
   /**
    * A pointer to the math container
    */
   const CMathContainer * mpContainer;
+
+  /**
+   * A pointer to the simulated time of the container
+   */
+  const C_FLOAT64 * mpContainerTime;
 };
 #endif
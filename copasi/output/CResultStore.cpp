@@ -0,0 +1,239 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include <algorithm>
+
+#include "copasi/copasi.h"
+
+#include "CResultStore.h"
+
+#include "copasi/core/CDataObject.h"
+#include "copasi/math/CMathObject.h"
+#include "copasi/utilities/CCopasiMessage.h"
+#include "copasi/commandline/CLocaleString.h"
+
+CResultStore::CResultStore():
+  COutputInterface(),
+  mFileName(),
+  mNames(),
+  mChunkSteps(1024),
+  mValues(),
+  mFile(),
+  mBuffer(),
+  mBufferedSteps(0),
+  mRuns(),
+  mChunks()
+{}
+
+CResultStore::CResultStore(const CResultStore & src):
+  COutputInterface(src),
+  mFileName(src.mFileName),
+  mNames(src.mNames),
+  mChunkSteps(src.mChunkSteps),
+  mValues(),
+  mFile(),
+  mBuffer(),
+  mBufferedSteps(0),
+  mRuns(),
+  mChunks()
+{}
+
+CResultStore::~CResultStore()
+{
+  close();
+}
+
+void CResultStore::setFileName(const std::string & fileName)
+{
+  mFileName = fileName;
+}
+
+const std::string & CResultStore::getFileName() const
+{
+  return mFileName;
+}
+
+void CResultStore::addObject(const CRegisteredCommonName & cn)
+{
+  mNames.push_back(cn);
+}
+
+void CResultStore::clearObjects()
+{
+  mNames.clear();
+}
+
+void CResultStore::setChunkSteps(const size_t & chunkSteps)
+{
+  mChunkSteps = std::max< size_t >(chunkSteps, 1);
+}
+
+// virtual
+bool CResultStore::compile(CObjectInterface::ContainerList listOfContainer)
+{
+  close();
+
+  mObjects.clear();
+  mValues.clear();
+
+  std::vector< std::string > Names;
+  std::vector< CRegisteredCommonName >::const_iterator it = mNames.begin();
+  std::vector< CRegisteredCommonName >::const_iterator end = mNames.end();
+
+  for (; it != end; ++it)
+    {
+      CObjectInterface * pObject = CObjectInterface::GetObjectFromCN(listOfContainer, *it);
+      const CDataObject * pDataObject = dynamic_cast< const CDataObject * >(pObject);
+
+      if (pObject == NULL ||
+          pObject->getValuePointer() == NULL ||
+          (dynamic_cast< const CMathObject * >(pObject) == NULL &&
+           (pDataObject == NULL || !pDataObject->hasFlag(CDataObject::ValueDbl))))
+        {
+          CCopasiMessage(CCopasiMessage::WARNING, MCCopasiTask + 6, it->c_str());
+          continue;
+        }
+
+      mObjects.insert(pObject);
+      mValues.push_back((const C_FLOAT64 *) pObject->getValuePointer());
+      Names.push_back(*it);
+    }
+
+  mFile.open(CLocaleString::fromUtf8(mFileName).c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (mFile.fail())
+    {
+      CCopasiMessage(CCopasiMessage::ERROR, MCDirEntry + 3, mFileName.c_str());
+      return false;
+    }
+
+  mBuffer.resize(mValues.size(), mChunkSteps);
+  mBufferedSteps = 0;
+  mRuns.assign(1, 0);
+  mChunks.clear();
+
+  unsigned C_INT32 Version = 1;
+  unsigned C_INT32 ByteOrder = 0x01020304;
+  unsigned C_INT64 IndexOffset = 0;
+  unsigned C_INT32 Count = (unsigned C_INT32) mValues.size();
+  unsigned C_INT32 ChunkSteps = (unsigned C_INT32) mChunkSteps;
+
+  mFile.write("COPASIRS", 8);
+  mFile.write((const char *) &Version, sizeof(Version));
+  mFile.write((const char *) &ByteOrder, sizeof(ByteOrder));
+  mFile.write((const char *) &IndexOffset, sizeof(IndexOffset));
+  mFile.write((const char *) &Count, sizeof(Count));
+  mFile.write((const char *) &ChunkSteps, sizeof(ChunkSteps));
+
+  std::vector< std::string >::const_iterator itName = Names.begin();
+  std::vector< std::string >::const_iterator endName = Names.end();
+
+  for (; itName != endName; ++itName)
+    {
+      unsigned C_INT32 Length = (unsigned C_INT32) itName->size();
+      mFile.write((const char *) &Length, sizeof(Length));
+      mFile.write(itName->c_str(), Length);
+    }
+
+  // The chunks are aligned so that they can be mapped as arrays of doubles.
+  static const char Padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  mFile.write(Padding, (8 - mFile.tellp() % 8) % 8);
+
+  return !mFile.fail();
+}
+
+// virtual
+void CResultStore::output(const COutputInterface::Activity & activity)
+{
+  if (activity != DURING || !mFile.is_open())
+    return;
+
+  std::vector< const C_FLOAT64 * >::const_iterator it = mValues.begin();
+  std::vector< const C_FLOAT64 * >::const_iterator end = mValues.end();
+  C_FLOAT64 * pValue = mBuffer.array() + mBufferedSteps;
+
+  for (; it != end; ++it, pValue += mBuffer.numCols())
+    *pValue = **it;
+
+  mBufferedSteps++;
+  mRuns.back()++;
+
+  if (mBufferedSteps == mBuffer.numCols())
+    writeChunk();
+}
+
+// virtual
+void CResultStore::separate(const COutputInterface::Activity & /* activity */)
+{
+  if (!mFile.is_open())
+    return;
+
+  writeChunk();
+
+  // Consecutive separators do not create empty runs.
+  if (mRuns.back() > 0)
+    mRuns.push_back(0);
+}
+
+// virtual
+void CResultStore::finish()
+{
+  if (!mFile.is_open())
+    return;
+
+  writeChunk();
+
+  if (mRuns.back() == 0)
+    mRuns.pop_back();
+
+  unsigned C_INT64 IndexOffset = mFile.tellp();
+  unsigned C_INT64 Count = mChunks.size();
+
+  mFile.write((const char *) &Count, sizeof(Count));
+
+  if (Count > 0)
+    mFile.write((const char *) mChunks.data(), Count * sizeof(Chunk));
+
+  Count = mRuns.size();
+  mFile.write((const char *) &Count, sizeof(Count));
+
+  if (Count > 0)
+    mFile.write((const char *) mRuns.data(), Count * sizeof(unsigned C_INT64));
+
+  // Mark the file as complete.
+  mFile.seekp(16);
+  mFile.write((const char *) &IndexOffset, sizeof(IndexOffset));
+
+  mFile.close();
+}
+
+// virtual
+void CResultStore::close()
+{
+  finish();
+}
+
+void CResultStore::writeChunk()
+{
+  if (mBufferedSteps == 0)
+    return;
+
+  Chunk New;
+  New.run = mRuns.size() - 1;
+  New.first = mRuns.back() - mBufferedSteps;
+  New.steps = mBufferedSteps;
+  New.offset = mFile.tellp();
+
+  mChunks.push_back(New);
+
+  // Each dataset is written contiguously.
+  const C_FLOAT64 * pRow = mBuffer.array();
+  const C_FLOAT64 * pRowEnd = pRow + mBuffer.size();
+
+  for (; pRow != pRowEnd; pRow += mBuffer.numCols())
+    mFile.write((const char *) pRow, mBufferedSteps * sizeof(C_FLOAT64));
+
+  mBufferedSteps = 0;
+}
@@ -0,0 +1,182 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_CResultStore
+#define COPASI_CResultStore
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "copasi/core/CMatrix.h"
+#include "copasi/core/CRegisteredCommonName.h"
+#include "copasi/output/COutputHandler.h"
+
+/**
+ * The class CResultStore is an output interface which writes the values of a
+ * list of objects to an indexed binary file. Each object is a dataset. The
+ * output between two separators, e.g., a single time course of a scan or
+ * repeat, is a run. The steps of a run are written in chunks and within a
+ * chunk the values of each dataset are contiguous. The index at the end of the
+ * file allows random access to any run with CResultStoreReader or by mapping
+ * the needed chunks into memory.
+ *
+ * The file layout (native byte order, all offsets are multiples of 8):
+ *   char[8] magic "COPASIRS"
+ *   uint32 version (1)
+ *   uint32 byte order mark 0x01020304 in the byte order of the writer
+ *   uint64 offset of the index (0 if the file was not finished)
+ *   uint32 number of datasets n
+ *   uint32 maximal number of steps per chunk
+ *   n times: uint32 length followed by the common name of the dataset
+ *   padding to a multiple of 8
+ *   chunks: n times the values of the dataset for the steps of the chunk
+ *   index:
+ *     uint64 number of chunks, for each chunk:
+ *       uint64 run, uint64 first step, uint64 number of steps, uint64 offset
+ *     uint64 number of runs, for each run: uint64 number of steps
+ */
+class CResultStore : public COutputInterface
+{
+public:
+  /**
+   * The index entry of a chunk
+   */
+  struct Chunk
+  {
+    unsigned C_INT64 run;
+    unsigned C_INT64 first;
+    unsigned C_INT64 steps;
+    unsigned C_INT64 offset;
+  };
+
+  /**
+   * Default constructor
+   */
+  CResultStore();
+
+  /**
+   * Copy constructor
+   * @param const CResultStore & src
+   */
+  CResultStore(const CResultStore & src);
+
+  /**
+   * Destructor
+   */
+  virtual ~CResultStore();
+
+  /**
+   * Set the name of the file the results are written to
+   * @param const std::string & fileName
+   */
+  void setFileName(const std::string & fileName);
+
+  /**
+   * Retrieve the name of the file the results are written to
+   * @return const std::string & fileName
+   */
+  const std::string & getFileName() const;
+
+  /**
+   * Add an object to be recorded. Only objects with a floating point value are
+   * recorded.
+   * @param const CRegisteredCommonName & cn
+   */
+  void addObject(const CRegisteredCommonName & cn);
+
+  /**
+   * Remove all objects
+   */
+  void clearObjects();
+
+  /**
+   * Set the maximal number of steps per chunk
+   * @param const size_t & chunkSteps
+   */
+  void setChunkSteps(const size_t & chunkSteps);
+
+  /**
+   * Compile the object list and open the file
+   * @param CObjectInterface::ContainerList listOfContainer
+   * @return bool success
+   */
+  virtual bool compile(CObjectInterface::ContainerList listOfContainer);
+
+  /**
+   * Perform an output event for the current activity
+   * @param const Activity & activity
+   */
+  virtual void output(const Activity & activity);
+
+  /**
+   * Introduce an additional separator into the output, i.e., start a new run
+   * @param const Activity & activity
+   */
+  virtual void separate(const Activity & activity);
+
+  /**
+   * Finish the output, i.e., write the index and close the file
+   */
+  virtual void finish();
+
+  /**
+   * Close the file if applicable
+   */
+  virtual void close();
+
+private:
+  /**
+   * Write the buffered steps as a chunk
+   */
+  void writeChunk();
+
+  /**
+   * The name of the file
+   */
+  std::string mFileName;
+
+  /**
+   * The common names of the recorded objects
+   */
+  std::vector< CRegisteredCommonName > mNames;
+
+  /**
+   * The maximal number of steps per chunk
+   */
+  size_t mChunkSteps;
+
+  /**
+   * Pointers to the values of the recorded objects
+   */
+  std::vector< const C_FLOAT64 * > mValues;
+
+  /**
+   * The file
+   */
+  std::ofstream mFile;
+
+  /**
+   * The buffered steps of the current chunk, each row holds one dataset
+   */
+  CMatrix< C_FLOAT64 > mBuffer;
+
+  /**
+   * The number of buffered steps
+   */
+  size_t mBufferedSteps;
+
+  /**
+   * The number of steps of each run
+   */
+  std::vector< unsigned C_INT64 > mRuns;
+
+  /**
+   * The index of all written chunks
+   */
+  std::vector< Chunk > mChunks;
+};
+
+#endif // COPASI_CResultStore
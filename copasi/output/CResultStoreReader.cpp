@@ -0,0 +1,213 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include <cstring>
+#include <limits>
+
+#include "copasi/copasi.h"
+
+#include "CResultStoreReader.h"
+
+#include "copasi/commandline/CLocaleString.h"
+
+CResultStoreReader::CResultStoreReader():
+  mFile(),
+  mNames(),
+  mChunks(),
+  mRuns(),
+  mFirstChunks()
+{}
+
+CResultStoreReader::~CResultStoreReader()
+{
+  close();
+}
+
+bool CResultStoreReader::open(const std::string & fileName)
+{
+  close();
+
+  mFile.open(CLocaleString::fromUtf8(fileName).c_str(), std::ios::in | std::ios::binary);
+
+  if (mFile.fail())
+    return false;
+
+  char Magic[8];
+  unsigned C_INT32 Version = 0;
+  unsigned C_INT32 ByteOrder = 0;
+  unsigned C_INT64 IndexOffset = 0;
+  unsigned C_INT32 Count = 0;
+  unsigned C_INT32 ChunkSteps = 0;
+
+  mFile.read(Magic, 8);
+  mFile.read((char *) &Version, sizeof(Version));
+  mFile.read((char *) &ByteOrder, sizeof(ByteOrder));
+  mFile.read((char *) &IndexOffset, sizeof(IndexOffset));
+  mFile.read((char *) &Count, sizeof(Count));
+  mFile.read((char *) &ChunkSteps, sizeof(ChunkSteps));
+
+  // We only read complete files written with the native byte order.
+  if (mFile.fail() ||
+      memcmp(Magic, "COPASIRS", 8) != 0 ||
+      Version != 1 ||
+      ByteOrder != 0x01020304 ||
+      IndexOffset == 0)
+    {
+      close();
+      return false;
+    }
+
+  mNames.resize(Count);
+  std::vector< std::string >::iterator itName = mNames.begin();
+  std::vector< std::string >::iterator endName = mNames.end();
+
+  for (; itName != endName && !mFile.fail(); ++itName)
+    {
+      unsigned C_INT32 Length = 0;
+      mFile.read((char *) &Length, sizeof(Length));
+      itName->resize(Length);
+
+      if (Length > 0)
+        mFile.read(&(*itName)[0], Length);
+    }
+
+  mFile.seekg(IndexOffset);
+
+  unsigned C_INT64 Size = 0;
+  mFile.read((char *) &Size, sizeof(Size));
+
+  if (!mFile.fail())
+    {
+      mChunks.resize(Size);
+
+      if (Size > 0)
+        mFile.read((char *) mChunks.data(), Size * sizeof(CResultStore::Chunk));
+    }
+
+  mFile.read((char *) &Size, sizeof(Size));
+
+  if (!mFile.fail())
+    {
+      mRuns.resize(Size);
+
+      if (Size > 0)
+        mFile.read((char *) mRuns.data(), Size * sizeof(unsigned C_INT64));
+    }
+
+  if (mFile.fail())
+    {
+      close();
+      return false;
+    }
+
+  // The chunks are written in order of the runs.
+  mFirstChunks.assign(mRuns.size() + 1, mChunks.size());
+
+  for (size_t i = mChunks.size(); i > 0; --i)
+    if (mChunks[i - 1].run < mRuns.size())
+      mFirstChunks[mChunks[i - 1].run] = i - 1;
+
+  for (size_t i = mRuns.size(); i > 0; --i)
+    if (mFirstChunks[i - 1] > mFirstChunks[i])
+      mFirstChunks[i - 1] = mFirstChunks[i];
+
+  return true;
+}
+
+void CResultStoreReader::close()
+{
+  if (mFile.is_open())
+    mFile.close();
+
+  mFile.clear();
+  mNames.clear();
+  mChunks.clear();
+  mRuns.clear();
+  mFirstChunks.clear();
+}
+
+size_t CResultStoreReader::getDatasetCount() const
+{
+  return mNames.size();
+}
+
+std::string CResultStoreReader::getDatasetName(const size_t & dataset) const
+{
+  if (dataset < mNames.size())
+    return mNames[dataset];
+
+  return std::string();
+}
+
+size_t CResultStoreReader::getDatasetIndex(const std::string & name) const
+{
+  for (size_t i = 0; i < mNames.size(); ++i)
+    if (mNames[i] == name)
+      return i;
+
+  return C_INVALID_INDEX;
+}
+
+size_t CResultStoreReader::getRunCount() const
+{
+  return mRuns.size();
+}
+
+size_t CResultStoreReader::getStepCount(const size_t & run) const
+{
+  if (run < mRuns.size())
+    return mRuns[run];
+
+  return 0;
+}
+
+std::vector< C_FLOAT64 > CResultStoreReader::getData(const size_t & run, const size_t & dataset)
+{
+  std::vector< C_FLOAT64 > Values;
+
+  if (run >= mRuns.size() || dataset >= mNames.size())
+    return Values;
+
+  Values.resize(mRuns[run], std::numeric_limits< C_FLOAT64 >::quiet_NaN());
+
+  std::vector< CResultStore::Chunk >::const_iterator it = mChunks.begin() + mFirstChunks[run];
+  std::vector< CResultStore::Chunk >::const_iterator end = mChunks.begin() + mFirstChunks[run + 1];
+
+  for (; it != end; ++it)
+    {
+      if (it->first + it->steps > Values.size())
+        continue;
+
+      mFile.seekg(it->offset + dataset * it->steps * sizeof(C_FLOAT64));
+      mFile.read((char *)(Values.data() + it->first), it->steps * sizeof(C_FLOAT64));
+    }
+
+  mFile.clear();
+
+  return Values;
+}
+
+C_FLOAT64 CResultStoreReader::getValue(const size_t & run, const size_t & step, const size_t & dataset)
+{
+  C_FLOAT64 Value = std::numeric_limits< C_FLOAT64 >::quiet_NaN();
+
+  if (run >= mRuns.size() || dataset >= mNames.size())
+    return Value;
+
+  std::vector< CResultStore::Chunk >::const_iterator it = mChunks.begin() + mFirstChunks[run];
+  std::vector< CResultStore::Chunk >::const_iterator end = mChunks.begin() + mFirstChunks[run + 1];
+
+  for (; it != end; ++it)
+    if (it->first <= step && step < it->first + it->steps)
+      {
+        mFile.seekg(it->offset + (dataset * it->steps + step - it->first) * sizeof(C_FLOAT64));
+        mFile.read((char *) &Value, sizeof(C_FLOAT64));
+        mFile.clear();
+
+        break;
+      }
+
+  return Value;
+}
@@ -0,0 +1,122 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_CResultStoreReader
+#define COPASI_CResultStoreReader
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "copasi/output/CResultStore.h"
+
+/**
+ * The class CResultStoreReader provides random access to the runs of a file
+ * written by CResultStore. Only the index is read when the file is opened,
+ * the values are read on demand.
+ */
+class CResultStoreReader
+{
+public:
+  /**
+   * Default constructor
+   */
+  CResultStoreReader();
+
+  /**
+   * Destructor
+   */
+  ~CResultStoreReader();
+
+  /**
+   * Open a result file and read its index
+   * @param const std::string & fileName
+   * @return bool success
+   */
+  bool open(const std::string & fileName);
+
+  /**
+   * Close the file
+   */
+  void close();
+
+  /**
+   * Retrieve the number of datasets
+   * @return size_t datasetCount
+   */
+  size_t getDatasetCount() const;
+
+  /**
+   * Retrieve the common name of the object of the indexed dataset
+   * @param const size_t & dataset
+   * @return std::string name
+   */
+  std::string getDatasetName(const size_t & dataset) const;
+
+  /**
+   * Retrieve the index of the dataset for the given common name
+   * @param const std::string & name
+   * @return size_t dataset (C_INVALID_INDEX if not found)
+   */
+  size_t getDatasetIndex(const std::string & name) const;
+
+  /**
+   * Retrieve the number of runs
+   * @return size_t runCount
+   */
+  size_t getRunCount() const;
+
+  /**
+   * Retrieve the number of steps of the indexed run
+   * @param const size_t & run
+   * @return size_t stepCount
+   */
+  size_t getStepCount(const size_t & run) const;
+
+  /**
+   * Retrieve the values of a dataset for all steps of a run
+   * @param const size_t & run
+   * @param const size_t & dataset
+   * @return std::vector< C_FLOAT64 > values
+   */
+  std::vector< C_FLOAT64 > getData(const size_t & run, const size_t & dataset);
+
+  /**
+   * Retrieve a single value
+   * @param const size_t & run
+   * @param const size_t & step
+   * @param const size_t & dataset
+   * @return C_FLOAT64 value (NaN if the indexes are invalid)
+   */
+  C_FLOAT64 getValue(const size_t & run, const size_t & step, const size_t & dataset);
+
+private:
+  /**
+   * The file
+   */
+  std::ifstream mFile;
+
+  /**
+   * The common names of the datasets
+   */
+  std::vector< std::string > mNames;
+
+  /**
+   * The index of all chunks
+   */
+  std::vector< CResultStore::Chunk > mChunks;
+
+  /**
+   * The number of steps of each run
+   */
+  std::vector< unsigned C_INT64 > mRuns;
+
+  /**
+   * The index of the first chunk of each run
+   */
+  std::vector< size_t > mFirstChunks;
+};
+
+#endif // COPASI_CResultStoreReader
@@ -0,0 +1,412 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifndef WIN32
+# include <errno.h>
+# include <fcntl.h>
+# include <poll.h>
+# include <unistd.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+#endif // not WIN32
+
+#include "copasi/copasi.h"
+
+#include "CSocketOutput.h"
+
+#include "copasi/core/CDataObject.h"
+#include "copasi/math/CMathObject.h"
+#include "copasi/utilities/CCopasiMessage.h"
+
+CSocketOutput::CSocketOutput():
+  COutputInterface(),
+  mSocketName(),
+  mNames(),
+  mActivities(DURING),
+  mBatchRows(256),
+  mTimeout(100),
+  mFinishTimeout(10000),
+  mValues(),
+  mBatch(),
+  mPending(),
+  mPendingSent(0),
+  mPendingRows(),
+  mDroppedRows(0),
+  mSocket(-1)
+{}
+
+CSocketOutput::CSocketOutput(const CSocketOutput & src):
+  COutputInterface(src),
+  mSocketName(src.mSocketName),
+  mNames(src.mNames),
+  mActivities(src.mActivities),
+  mBatchRows(src.mBatchRows),
+  mTimeout(src.mTimeout),
+  mFinishTimeout(src.mFinishTimeout),
+  mValues(),
+  mBatch(),
+  mPending(),
+  mPendingSent(0),
+  mPendingRows(),
+  mDroppedRows(0),
+  mSocket(-1)
+{}
+
+CSocketOutput::~CSocketOutput()
+{
+  close();
+}
+
+void CSocketOutput::setSocketName(const std::string & socketName)
+{
+  mSocketName = socketName;
+}
+
+const std::string & CSocketOutput::getSocketName() const
+{
+  return mSocketName;
+}
+
+void CSocketOutput::addObject(const CRegisteredCommonName & cn)
+{
+  mNames.push_back(cn);
+}
+
+void CSocketOutput::clearObjects()
+{
+  mNames.clear();
+}
+
+void CSocketOutput::setActivities(const unsigned C_INT32 & activities)
+{
+  mActivities = activities;
+}
+
+void CSocketOutput::setBatchRows(const size_t & batchRows)
+{
+  mBatchRows = std::max< size_t >(batchRows, 1);
+}
+
+void CSocketOutput::setTimeout(const size_t & timeout)
+{
+  mTimeout = timeout;
+}
+
+void CSocketOutput::setFinishTimeout(const size_t & finishTimeout)
+{
+  mFinishTimeout = finishTimeout;
+}
+
+const size_t & CSocketOutput::getDroppedRows() const
+{
+  return mDroppedRows;
+}
+
+// virtual
+bool CSocketOutput::compile(CObjectInterface::ContainerList listOfContainer)
+{
+  close();
+
+  mObjects.clear();
+  mValues.clear();
+  mBatch.clear();
+  mDroppedRows = 0;
+
+  std::vector< std::string > Names;
+  std::vector< CRegisteredCommonName >::const_iterator it = mNames.begin();
+  std::vector< CRegisteredCommonName >::const_iterator end = mNames.end();
+
+  for (; it != end; ++it)
+    {
+      CObjectInterface * pObject = CObjectInterface::GetObjectFromCN(listOfContainer, *it);
+      const CDataObject * pDataObject = dynamic_cast< const CDataObject * >(pObject);
+
+      if (pObject == NULL ||
+          pObject->getValuePointer() == NULL ||
+          (dynamic_cast< const CMathObject * >(pObject) == NULL &&
+           (pDataObject == NULL || !pDataObject->hasFlag(CDataObject::ValueDbl))))
+        {
+          CCopasiMessage(CCopasiMessage::WARNING, MCCopasiTask + 6, it->c_str());
+          continue;
+        }
+
+      mObjects.insert(pObject);
+      mValues.push_back((const C_FLOAT64 *) pObject->getValuePointer());
+      Names.push_back(*it);
+    }
+
+  if (!connectSocket())
+    {
+      CCopasiMessage(CCopasiMessage::ERROR, MCCopasiTask + 9, mSocketName.c_str());
+      return false;
+    }
+
+  mBatch.reserve(mBatchRows * mValues.size());
+
+  std::vector< char > Payload;
+  unsigned C_INT32 Version = 1;
+  unsigned C_INT32 ByteOrder = 0x01020304;
+
+  Payload.insert(Payload.end(), (const char *) &Version, (const char *)(&Version + 1));
+  Payload.insert(Payload.end(), (const char *) &ByteOrder, (const char *)(&ByteOrder + 1));
+
+  std::vector< std::string >::const_iterator itName = Names.begin();
+  std::vector< std::string >::const_iterator endName = Names.end();
+
+  for (; itName != endName; ++itName)
+    {
+      unsigned C_INT32 Length = (unsigned C_INT32) itName->size();
+      Payload.insert(Payload.end(), (const char *) &Length, (const char *)(&Length + 1));
+      Payload.insert(Payload.end(), itName->begin(), itName->end());
+    }
+
+  sendFrame(HEADER, mValues.size(), Payload.data(), Payload.size());
+
+  return true;
+}
+
+// virtual
+void CSocketOutput::output(const COutputInterface::Activity & activity)
+{
+  if (!(activity & mActivities) || mSocket < 0)
+    return;
+
+  std::vector< const C_FLOAT64 * >::const_iterator it = mValues.begin();
+  std::vector< const C_FLOAT64 * >::const_iterator end = mValues.end();
+
+  for (; it != end; ++it)
+    mBatch.push_back(**it);
+
+  if (mBatch.size() >= mBatchRows * mValues.size())
+    sendBatch();
+}
+
+// virtual
+void CSocketOutput::separate(const COutputInterface::Activity & /* activity */)
+{
+  if (mSocket < 0)
+    return;
+
+  sendBatch();
+  sendFrame(SEPARATOR, 0, NULL, 0);
+}
+
+// virtual
+void CSocketOutput::finish()
+{
+  if (mSocket < 0)
+    return;
+
+  // The consumer is given more time to accept the remaining frames so that the
+  // last batch is not dropped and the finish frame is received.
+  sendPending(mFinishTimeout);
+  sendBatch();
+  sendFrame(FINISH, mDroppedRows, NULL, 0);
+  sendPending(mFinishTimeout);
+
+  disconnectSocket();
+
+  if (mDroppedRows > 0)
+    CCopasiMessage(CCopasiMessage::WARNING, MCCopasiTask + 10, (int) mDroppedRows, mSocketName.c_str());
+}
+
+// virtual
+void CSocketOutput::close()
+{
+  finish();
+}
+
+void CSocketOutput::sendBatch()
+{
+  if (mBatch.empty())
+    return;
+
+  // Rows without values are not published.
+  if (!mValues.empty())
+    sendFrame(DATA, mBatch.size() / mValues.size(), (const char *) mBatch.data(), mBatch.size() * sizeof(C_FLOAT64));
+
+  mBatch.clear();
+}
+
+void CSocketOutput::sendFrame(const FrameType & type, const size_t & count,
+                              const char * pPayload, const size_t & size)
+{
+  // The integrator must not wait longer than the timeout for a slow consumer.
+  // A data frame is dropped if the previous frames are still pending, control
+  // frames are always queued to keep the stream consistent.
+  if (!sendPending(mTimeout) && type == DATA)
+    {
+      mDroppedRows += count;
+      return;
+    }
+
+  if (mSocket < 0)
+    {
+      if (type == DATA)
+        mDroppedRows += count;
+
+      return;
+    }
+
+  unsigned C_INT32 Type = type;
+  unsigned C_INT32 Count = (unsigned C_INT32) count;
+  unsigned C_INT64 Size = size;
+
+  mPending.insert(mPending.end(), (const char *) &Type, (const char *)(&Type + 1));
+  mPending.insert(mPending.end(), (const char *) &Count, (const char *)(&Count + 1));
+  mPending.insert(mPending.end(), (const char *) &Size, (const char *)(&Size + 1));
+
+  if (size > 0)
+    mPending.insert(mPending.end(), pPayload, pPayload + size);
+
+  if (type == DATA)
+    mPendingRows.push_back(std::make_pair(mPending.size(), count));
+
+  sendPending(0);
+}
+
+#ifndef WIN32
+
+bool CSocketOutput::connectSocket()
+{
+  struct sockaddr_un Address;
+  memset(&Address, 0, sizeof(Address));
+
+  if (mSocketName.empty() ||
+      mSocketName.size() >= sizeof(Address.sun_path))
+    return false;
+
+  Address.sun_family = AF_UNIX;
+  strncpy(Address.sun_path, mSocketName.c_str(), sizeof(Address.sun_path) - 1);
+
+  mSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if (mSocket < 0)
+    return false;
+
+  if (connect(mSocket, (struct sockaddr *) &Address, sizeof(Address)) != 0)
+    {
+      disconnectSocket();
+      return false;
+    }
+
+  // The consumer is written to without blocking, waiting is controlled by poll.
+  fcntl(mSocket, F_SETFL, fcntl(mSocket, F_GETFL, 0) | O_NONBLOCK);
+
+#ifdef SO_NOSIGPIPE
+  int NoSigPipe = 1;
+  setsockopt(mSocket, SOL_SOCKET, SO_NOSIGPIPE, &NoSigPipe, sizeof(NoSigPipe));
+#endif // SO_NOSIGPIPE
+
+  return true;
+}
+
+void CSocketOutput::disconnectSocket()
+{
+  if (mSocket >= 0)
+    ::close(mSocket);
+
+  mSocket = -1;
+
+  // Rows which have not been sent completely are lost.
+  std::vector< std::pair< size_t, size_t > >::const_iterator it = mPendingRows.begin();
+  std::vector< std::pair< size_t, size_t > >::const_iterator end = mPendingRows.end();
+
+  for (; it != end; ++it)
+    if (it->first > mPendingSent)
+      mDroppedRows += it->second;
+
+  mPending.clear();
+  mPendingSent = 0;
+  mPendingRows.clear();
+}
+
+bool CSocketOutput::sendPending(const size_t & timeout)
+{
+  if (mSocket < 0)
+    return false;
+
+#ifdef MSG_NOSIGNAL
+  int Flags = MSG_NOSIGNAL;
+#else
+  int Flags = 0;
+#endif // MSG_NOSIGNAL
+
+  std::chrono::steady_clock::time_point Deadline =
+    std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+  while (mPendingSent < mPending.size())
+    {
+      ssize_t Sent = send(mSocket, mPending.data() + mPendingSent, mPending.size() - mPendingSent, Flags);
+
+      if (Sent > 0)
+        {
+          mPendingSent += Sent;
+          continue;
+        }
+
+      if (Sent < 0 && errno == EINTR)
+        continue;
+
+      if (Sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+          // The consumer disconnected.
+          disconnectSocket();
+          return false;
+        }
+
+      long Remaining = (long) std::chrono::duration_cast< std::chrono::microseconds >(Deadline - std::chrono::steady_clock::now()).count();
+
+      if (Remaining <= 0)
+        return false;
+
+      // poll waits at least the remaining time.
+      Remaining = (Remaining + 999) / 1000;
+
+      struct pollfd Poll;
+      Poll.fd = mSocket;
+      Poll.events = POLLOUT;
+      Poll.revents = 0;
+
+      if (poll(&Poll, 1, (int) Remaining) < 0 && errno != EINTR)
+        {
+          disconnectSocket();
+          return false;
+        }
+    }
+
+  mPending.clear();
+  mPendingSent = 0;
+  mPendingRows.clear();
+
+  return true;
+}
+
+#else // WIN32
+
+// Named pipes are not supported yet.
+bool CSocketOutput::connectSocket()
+{
+  return false;
+}
+
+void CSocketOutput::disconnectSocket()
+{
+  mSocket = -1;
+  mPending.clear();
+  mPendingSent = 0;
+  mPendingRows.clear();
+}
+
+bool CSocketOutput::sendPending(const size_t & /* timeout */)
+{
+  return false;
+}
+
+#endif // not WIN32
@@ -0,0 +1,260 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_CSocketOutput
+#define COPASI_CSocketOutput
+
+#include <string>
+#include <vector>
+
+#include "copasi/core/CRegisteredCommonName.h"
+#include "copasi/output/COutputHandler.h"
+
+/**
+ * The class CSocketOutput is an output interface which publishes the values
+ * of a list of objects to a live consumer listening on a local Unix domain
+ * socket. The interface connects to the socket when it is compiled, i.e., the
+ * consumer must listen before the task is started.
+ *
+ * Rows are sent in batches. A batch which cannot be sent within the timeout
+ * because the consumer does not keep up is dropped, i.e., a slow consumer
+ * delays each output by at most the timeout. The number of dropped rows is
+ * reported in the finish frame. When the output is finished the consumer is
+ * given the finish timeout to accept the remaining frames. If it does not,
+ * the connection is closed without the finish frame and the rows which have
+ * not been sent completely are counted as dropped.
+ *
+ * The protocol (native byte order):
+ *   Each frame starts with:
+ *     uint32 type (HEADER, DATA, SEPARATOR, or FINISH)
+ *     uint32 count
+ *     uint64 size of the payload in bytes
+ *   HEADER: count is the number of datasets n, the payload is:
+ *     uint32 version (1)
+ *     uint32 byte order mark 0x01020304 in the byte order of the sender
+ *     n times: uint32 length followed by the common name of the dataset
+ *   DATA: count is the number of rows, the payload holds the values of all n
+ *     datasets for each row as doubles
+ *   SEPARATOR: count is 0, no payload
+ *   FINISH: count is the number of dropped rows, no payload
+ */
+class CSocketOutput : public COutputInterface
+{
+public:
+  /**
+   * The type of a frame
+   */
+  enum FrameType
+  {
+    HEADER = 1,
+    DATA = 2,
+    SEPARATOR = 3,
+    FINISH = 4
+  };
+
+  /**
+   * Default constructor
+   */
+  CSocketOutput();
+
+  /**
+   * Copy constructor
+   * @param const CSocketOutput & src
+   */
+  CSocketOutput(const CSocketOutput & src);
+
+  /**
+   * Destructor
+   */
+  virtual ~CSocketOutput();
+
+  /**
+   * Set the path of the socket the consumer listens on
+   * @param const std::string & socketName
+   */
+  void setSocketName(const std::string & socketName);
+
+  /**
+   * Retrieve the path of the socket the consumer listens on
+   * @return const std::string & socketName
+   */
+  const std::string & getSocketName() const;
+
+  /**
+   * Add an object to be published. Only objects with a floating point value
+   * are published.
+   * @param const CRegisteredCommonName & cn
+   */
+  void addObject(const CRegisteredCommonName & cn);
+
+  /**
+   * Remove all objects
+   */
+  void clearObjects();
+
+  /**
+   * Set the activities for which rows are published, e.g., DURING for time
+   * courses (default) or AFTER for steady states.
+   * @param const unsigned C_INT32 & activities
+   */
+  void setActivities(const unsigned C_INT32 & activities);
+
+  /**
+   * Set the maximal number of rows sent in one data frame
+   * @param const size_t & batchRows
+   */
+  void setBatchRows(const size_t & batchRows);
+
+  /**
+   * Set the time in milliseconds an output waits for the consumer
+   * before the batch is dropped
+   * @param const size_t & timeout
+   */
+  void setTimeout(const size_t & timeout);
+
+  /**
+   * Set the time in milliseconds the output waits for the consumer to
+   * accept the remaining frames when it is finished
+   * @param const size_t & finishTimeout
+   */
+  void setFinishTimeout(const size_t & finishTimeout);
+
+  /**
+   * Retrieve the number of rows dropped since the last compile
+   * @return const size_t & droppedRows
+   */
+  const size_t & getDroppedRows() const;
+
+  /**
+   * Compile the object list and connect to the socket
+   * @param CObjectInterface::ContainerList listOfContainer
+   * @return bool success
+   */
+  virtual bool compile(CObjectInterface::ContainerList listOfContainer);
+
+  /**
+   * Perform an output event for the current activity
+   * @param const Activity & activity
+   */
+  virtual void output(const Activity & activity);
+
+  /**
+   * Introduce an additional separator into the output
+   * @param const Activity & activity
+   */
+  virtual void separate(const Activity & activity);
+
+  /**
+   * Finish the output, i.e., send the remaining rows and disconnect
+   */
+  virtual void finish();
+
+  /**
+   * Disconnect if applicable
+   */
+  virtual void close();
+
+private:
+  /**
+   * Connect to the socket
+   * @return bool success
+   */
+  bool connectSocket();
+
+  /**
+   * Disconnect from the socket. Pending rows are dropped.
+   */
+  void disconnectSocket();
+
+  /**
+   * Send the batched rows
+   */
+  void sendBatch();
+
+  /**
+   * Send a frame. Data frames are dropped if the previous frames could not be
+   * sent within the timeout.
+   * @param const FrameType & type
+   * @param const size_t & count
+   * @param const char * pPayload
+   * @param const size_t & size
+   */
+  void sendFrame(const FrameType & type, const size_t & count,
+                 const char * pPayload, const size_t & size);
+
+  /**
+   * Send the pending bytes
+   * @param const size_t & timeout in milliseconds
+   * @return bool drained
+   */
+  bool sendPending(const size_t & timeout);
+
+  /**
+   * The path of the socket
+   */
+  std::string mSocketName;
+
+  /**
+   * The common names of the published objects
+   */
+  std::vector< CRegisteredCommonName > mNames;
+
+  /**
+   * The activities for which rows are published
+   */
+  unsigned C_INT32 mActivities;
+
+  /**
+   * The maximal number of rows in a data frame
+   */
+  size_t mBatchRows;
+
+  /**
+   * The time in milliseconds an output waits for the consumer
+   */
+  size_t mTimeout;
+
+  /**
+   * The time in milliseconds the finish waits for the consumer
+   */
+  size_t mFinishTimeout;
+
+  /**
+   * Pointers to the values of the published objects
+   */
+  std::vector< const C_FLOAT64 * > mValues;
+
+  /**
+   * The batched rows
+   */
+  std::vector< C_FLOAT64 > mBatch;
+
+  /**
+   * The bytes which have not been sent yet
+   */
+  std::vector< char > mPending;
+
+  /**
+   * The number of pending bytes already sent
+   */
+  size_t mPendingSent;
+
+  /**
+   * The end of each pending data frame in the pending bytes and its number of rows
+   */
+  std::vector< std::pair< size_t, size_t > > mPendingRows;
+
+  /**
+   * The number of dropped rows
+   */
+  size_t mDroppedRows;
+
+  /**
+   * The socket descriptor (-1 if not connected)
+   */
+  int mSocket;
+};
+
+#endif // COPASI_CSocketOutput
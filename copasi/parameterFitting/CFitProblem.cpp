@@ -26,6 +26,7 @@
 
 
 #include <cmath>
+#include <sstream>
 
 #include "copasi.h"
 
@@ -47,6 +48,8 @@
 #include "utilities/CProcessReport.h"
 #include "utilities/CCopasiException.h"
 #include "core/CDataArray.h"
+#include "core/CContext.h"
+#include "optimization/COptMethod.h"
 
 #include "lapack/blaswrap.h"           //use blas
 #include "lapack/lapackwrap.h"        //use CLAPACK
@@ -106,9 +109,22 @@ CFitProblem::CFitProblem(const CTaskEnum::Task & type,
   mCorrelation(0, 0),
   mpCorrelationMatrixInterface(NULL),
   mpCorrelationMatrix(NULL),
+  mProfileValues(0, 0),
+  mpProfileValuesMatrixInterface(NULL),
+  mpProfileValuesMatrix(NULL),
+  mProfileObjective(0, 0),
+  mpProfileObjectiveMatrixInterface(NULL),
+  mpProfileObjectiveMatrix(NULL),
+  mProfileEvaluations(0),
+  mpParmCalculateProfiles(NULL),
+  mpParmProfileSteps(NULL),
+  mpParmProfileStepSize(NULL),
+  mWorkers(false),
+  mCrossValidationCache(),
   mpCreateParameterSets(NULL),
-  mTrajectoryUpdate(false)
-
+  mTrajectoryUpdate(false),
+  mIsWorker(false),
+  mpWorkerContainer(NULL)
 {
   initObjects();
   initializeParameter();
@@ -167,8 +183,22 @@ CFitProblem::CFitProblem(const CFitProblem& src,
   mCorrelation(src.mCorrelation),
   mpCorrelationMatrixInterface(NULL),
   mpCorrelationMatrix(NULL),
+  mProfileValues(0, 0),
+  mpProfileValuesMatrixInterface(NULL),
+  mpProfileValuesMatrix(NULL),
+  mProfileObjective(0, 0),
+  mpProfileObjectiveMatrixInterface(NULL),
+  mpProfileObjectiveMatrix(NULL),
+  mProfileEvaluations(0),
+  mpParmCalculateProfiles(NULL),
+  mpParmProfileSteps(NULL),
+  mpParmProfileStepSize(NULL),
+  mWorkers(false),
+  mCrossValidationCache(),
   mpCreateParameterSets(NULL),
-  mTrajectoryUpdate(false)
+  mTrajectoryUpdate(false),
+  mIsWorker(false),
+  mpWorkerContainer(NULL)
 {
   initObjects();
   initializeParameter();
@@ -177,6 +207,12 @@ CFitProblem::CFitProblem(const CFitProblem& src,
 // Destructor
 CFitProblem::~CFitProblem()
 {
+  if (mIsWorker)
+    {
+      pdelete(mpSteadyState);
+      pdelete(mpTrajectory);
+    }
+
   pdelete(mpTrajectoryProblem);
   pdelete(mpDeltaResidualDeltaParameterInterface);
   pdelete(mpDeltaResidualDeltaParameterMatrix);
@@ -196,6 +232,28 @@ CFitProblem::~CFitProblem()
   pdelete(mpFisherScaledEigenvectorsMatrix);
   pdelete(mpCorrelationMatrixInterface);
   pdelete(mpCorrelationMatrix);
+  pdelete(mpProfileValuesMatrixInterface);
+  pdelete(mpProfileValuesMatrix);
+  pdelete(mpProfileObjectiveMatrixInterface);
+  pdelete(mpProfileObjectiveMatrix);
+
+  destroyWorkers();
+
+  if (mpWorkerContainer != NULL)
+    {
+      // Workers created for methods may outlive this problem. They are
+      // released from the container and remain owned by their creator.
+      CDataContainer::objectMap & Objects = mpWorkerContainer->getObjects();
+
+      while (Objects.begin() != Objects.end())
+        {
+          CDataObject * pObject = *Objects.begin();
+          mpWorkerContainer->remove(pObject);
+          pObject->setObjectParent(NULL);
+        }
+
+      pdelete(mpWorkerContainer);
+    }
 }
 
 void CFitProblem::initObjects()
@@ -267,6 +325,20 @@ void CFitProblem::initObjects()
   mpCorrelationMatrix->setDimensionDescription(0, "Parameters");
   mpCorrelationMatrix->setDimensionDescription(1, "Parameters");
   mpCorrelationMatrix->setMode(CDataArray::Mode::Strings);
+
+  mpProfileValuesMatrixInterface = new CMatrixInterface< CMatrix< C_FLOAT64 > >(&mProfileValues);
+  mpProfileValuesMatrix = new CDataArray("Profile Likelihood Parameter Values", this, mpProfileValuesMatrixInterface, false);
+  mpProfileValuesMatrix->setDescription("Profile Likelihood Parameter Values");
+  mpProfileValuesMatrix->setDimensionDescription(0, "Parameters");
+  mpProfileValuesMatrix->setDimensionDescription(1, "Profile Steps");
+  mpProfileValuesMatrix->setMode(CDataArray::Mode::Strings);
+
+  mpProfileObjectiveMatrixInterface = new CMatrixInterface< CMatrix< C_FLOAT64 > >(&mProfileObjective);
+  mpProfileObjectiveMatrix = new CDataArray("Profile Likelihood Objective Values", this, mpProfileObjectiveMatrixInterface, false);
+  mpProfileObjectiveMatrix->setDescription("Profile Likelihood Objective Values");
+  mpProfileObjectiveMatrix->setDimensionDescription(0, "Parameters");
+  mpProfileObjectiveMatrix->setDimensionDescription(1, "Profile Steps");
+  mpProfileObjectiveMatrix->setMode(CDataArray::Mode::Strings);
 }
 
 void CFitProblem::initializeParameter()
@@ -280,6 +352,9 @@ void CFitProblem::initializeParameter()
   mpParmSteadyStateCN = assertParameter("Steady-State", CCopasiParameter::Type::CN, CCommonName(""));
   mpParmTimeCourseCN = assertParameter("Time-Course", CCopasiParameter::Type::CN, CCommonName(""));
   mpCreateParameterSets = assertParameter("Create Parameter Sets", CCopasiParameter::Type::BOOL, false);
+  mpParmCalculateProfiles = assertParameter("Calculate Profile Likelihood", CCopasiParameter::Type::BOOL, false);
+  mpParmProfileSteps = assertParameter("Profile Likelihood Steps", CCopasiParameter::Type::UINT, (unsigned C_INT32) 10);
+  mpParmProfileStepSize = assertParameter("Profile Likelihood Step Size", CCopasiParameter::Type::DOUBLE, (C_FLOAT64) 0.1);
 
   assertGroup("Experiment Set");
 
@@ -476,6 +551,13 @@ bool CFitProblem::initialize()
   CDataModel * pDataModel = getObjectDataModel();
   assert(pDataModel != NULL);
 
+  // A worker owns copies of the subtasks which are recreated.
+  if (mIsWorker)
+    {
+      pdelete(mpSteadyState);
+      pdelete(mpTrajectory);
+    }
+
   // We only need to initialize the steady-state task if steady-state data is present.
   if (mpExperimentSet->hasDataForTaskType(CTaskEnum::Task::steadyState))
     {
@@ -491,6 +573,13 @@ bool CFitProblem::initialize()
       if (mpSteadyState == NULL) fatalError();
 
       *mpParmSteadyStateCN = mpSteadyState->getCN();
+
+      if (mIsWorker)
+        {
+          mpSteadyState = new CSteadyStateTask(*mpSteadyState, getObjectParent());
+          mpSteadyState->setMathContainer(mpContainer);
+        }
+
       mpSteadyState->initialize(CCopasiTask::NO_OUTPUT, NULL, NULL);
     }
   else
@@ -516,6 +605,12 @@ bool CFitProblem::initialize()
 
       *mpParmTimeCourseCN = mpTrajectory->getCN();
 
+      if (mIsWorker)
+        {
+          mpTrajectory = new CTrajectoryTask(*mpTrajectory, getObjectParent());
+          mpTrajectory->setMathContainer(mpContainer);
+        }
+
       // do not update initial values when running fit
       mTrajectoryUpdate = mpTrajectory->isUpdateModel();
       mpTrajectory->setUpdateModel(false);
@@ -576,6 +671,24 @@ bool CFitProblem::initialize()
   mCorrelation.resize(imax, imax);
   mpCorrelationMatrix->resize();
 
+  size_t ProfileSize = 2 * *mpParmProfileSteps + 1;
+  mProfileValues.resize(imax, ProfileSize);
+  mProfileValues = std::numeric_limits< C_FLOAT64 >::quiet_NaN();
+  mpProfileValuesMatrix->resize();
+  mProfileObjective.resize(imax, ProfileSize);
+  mProfileObjective = std::numeric_limits< C_FLOAT64 >::quiet_NaN();
+  mpProfileObjectiveMatrix->resize();
+  mProfileEvaluations = 0;
+
+  for (j = 0; j < ProfileSize; j++)
+    {
+      std::ostringstream Step;
+      Step << (C_INT32) j - (C_INT32) *mpParmProfileSteps;
+
+      mpProfileValuesMatrix->setAnnotationString(1, j, Step.str());
+      mpProfileObjectiveMatrix->setAnnotationString(1, j, Step.str());
+    }
+
   for (j = 0; it != end; ++it, j++)
     {
       pItem = dynamic_cast<CFitItem *>(*it);
@@ -634,6 +747,8 @@ bool CFitProblem::initialize()
       mpFisherScaledEigenvectorsMatrix->setAnnotationString(1, j, Annotation);
       mpCorrelationMatrix->setAnnotationString(0, j, Annotation);
       mpCorrelationMatrix->setAnnotationString(1, j, Annotation);
+      mpProfileValuesMatrix->setAnnotationString(0, j, Annotation);
+      mpProfileObjectiveMatrix->setAnnotationString(0, j, Annotation);
     }
 
   // Create a joined sequence of update methods for parameters and independent values.
@@ -807,6 +922,10 @@ bool CFitProblem::initialize()
   mCrossValidationObjective = mWorstValue;
   mThresholdCounter = 0;
 
+  // The validation values are cached under the same conditions as the objective values.
+  mCrossValidationCache.setSize(mValueCache.getSize());
+  destroyWorkers();
+
   setResidualsRequired(false);
 
   return success;
@@ -867,6 +986,18 @@ void CFitProblem::createParameterSet(const std::string & Name)
 bool CFitProblem::calculate()
 {
   mCounter += 1;
+
+  CCopasiTimeVariable Start = mpTrace != NULL ? CCopasiTimeVariable::getCurrentWallTime() : CCopasiTimeVariable();
+
+  if (findCachedValue(&mResiduals))
+    {
+      traceEvaluation(Start, COptTrace::cached);
+
+      if (mpCallBack) return mpCallBack->progressItem(mhCounter);
+
+      return true;
+    }
+
   bool Continue = true;
 
   size_t i, imax = mpExperimentSet->getExperimentCount();
@@ -897,9 +1028,15 @@ bool CFitProblem::calculate()
   CFitConstraint **ppConstraint = mExperimentConstraints.array();
   CFitConstraint **ppConstraintEnd;
 
+  // The sum of squares never decreases, i.e., we can stop as soon as the partial
+  // value exceeds the bound. Stored results must always be complete.
+  const C_FLOAT64 Bound = mStoreResults ? std::numeric_limits< C_FLOAT64 >::infinity() : mObjectiveBound;
+  bool Terminated = false;
+  COptTrace::Status Status = COptTrace::success;
+
   try
     {
-      for (i = 0; i < imax && Continue; i++) // For each experiment
+      for (i = 0; i < imax && Continue && !Terminated; i++) // For each experiment
         {
           pExp = mpExperimentSet->getExperiment(i);
 
@@ -925,12 +1062,13 @@ bool CFitProblem::calculate()
                   {
                     pExp->updateModelWithIndependentData(j);
 
-                    Continue = mpSteadyState->process(true);
+                    Continue = processSteadyState(mpSteadyState, COptWarmStartStore::Slot(i, j));
 
                     if (!Continue)
                       {
                         mFailedCounterException++;
                         mCalculateValue = mWorstValue;
+                        Status = COptTrace::exception;
                         break;
                       }
 
@@ -948,6 +1086,12 @@ bool CFitProblem::calculate()
                       mCalculateValue += pExp->sumOfSquaresStore(j, DependentValues);
                     else
                       mCalculateValue += pExp->sumOfSquares(j, Residuals);
+
+                    if (mCalculateValue > Bound)
+                      {
+                        Terminated = true;
+                        break;
+                      }
                   }
 
                 // Restore the containers initial state to the current experimental initial conditions
@@ -1039,6 +1183,13 @@ bool CFitProblem::calculate()
                         //additionally also store the the simulation result for the extended time series
                         pExp->storeExtendedTimeSeriesData(pExp->getTimeData()[j]);
                       }
+
+                    // The remaining time points are not simulated.
+                    if (mCalculateValue > Bound)
+                      {
+                        Terminated = true;
+                        break;
+                      }
                   }
               }
               break;
@@ -1059,6 +1210,7 @@ bool CFitProblem::calculate()
 
       mFailedCounterException++;
       mCalculateValue = mWorstValue;
+      Status = COptTrace::exception;
 
       // Restore the containers initial state. This includes all local reaction parameter
       // Additionally this state is synchronized, i.e. nothing to compute.
@@ -1069,6 +1221,7 @@ bool CFitProblem::calculate()
     {
       mFailedCounterException++;
       mCalculateValue = mWorstValue;
+      Status = COptTrace::exception;
 
       // Restore the containers initial state. This includes all local reaction parameter
       // Additionally this state is synchronized, i.e. nothing to compute.
@@ -1079,13 +1232,94 @@ bool CFitProblem::calculate()
     {
       mFailedCounterNaN++;
       mCalculateValue = mWorstValue;
+      Status = COptTrace::notANumber;
     }
 
+  // The value and residuals of a terminated evaluation are incomplete and
+  // failed evaluations may succeed when repeated. The partial sum of squares
+  // is lower than the true value, i.e., it must not be compared with other
+  // candidates and the worst value is reported instead.
+  if (Terminated)
+    {
+      mTerminatedCounter++;
+      mCalculateValue = mWorstValue;
+      Status = COptTrace::terminated;
+    }
+  else if (Status == COptTrace::success)
+    cacheValue(&mResiduals);
+
+  traceEvaluation(Start, Status);
+
   if (mpCallBack) return mpCallBack->progressItem(mhCounter);
 
   return true;
 }
 
+// virtual
+bool CFitProblem::isBatchParallel()
+{
+  return !mStoreResults && createWorkers();
+}
+
+bool CFitProblem::calculateBatch(const std::vector< CVector< C_FLOAT64 > * > & points,
+                                 CVector< C_FLOAT64 > & values,
+                                 CVector< C_FLOAT64 > & constraintViolations)
+{
+  // Stored results must be calculated by this problem.
+  if (mStoreResults ||
+      points.size() < 2 ||
+      !createWorkers())
+    return COptProblem::calculateBatch(points, values, constraintViolations);
+
+  size_t imax = points.size();
+
+  values.resize(imax);
+  constraintViolations.resize(imax);
+
+  sWorker * pWorker = mWorkers.beginThread();
+  sWorker * pWorkerEnd = mWorkers.endThread();
+
+  for (; pWorker != pWorkerEnd; ++pWorker)
+    pWorker->pProblem->setObjectiveBound(mObjectiveBound);
+
+  C_INT32 Size = (C_INT32) imax;
+  bool Continue = true;
+
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic) reduction(&& : Continue)
+#endif // USE_OMP
+
+  for (C_INT32 k = 0; k < Size; k++)
+    {
+      Continue = mWorkers.active().pProblem->calculatePoint(*points[k], values[k], constraintViolations[k]) && Continue;
+    }
+
+  // Collect the counters of the workers.
+  for (pWorker = mWorkers.beginThread(); pWorker != pWorkerEnd; ++pWorker)
+    {
+      CFitProblem & Worker = *pWorker->pProblem;
+
+      mCounter += Worker.mCounter;
+      mFailedCounterException += Worker.mFailedCounterException;
+      mFailedCounterNaN += Worker.mFailedCounterNaN;
+      mConstraintCounter += Worker.mConstraintCounter;
+      mFailedConstraintCounter += Worker.mFailedConstraintCounter;
+      mTerminatedCounter += Worker.mTerminatedCounter;
+
+      Worker.mCounter = 0;
+      Worker.mFailedCounterException = 0;
+      Worker.mFailedCounterNaN = 0;
+      Worker.mConstraintCounter = 0;
+      Worker.mFailedConstraintCounter = 0;
+      Worker.mTerminatedCounter = 0;
+    }
+
+  if (mpCallBack)
+    Continue &= mpCallBack->progressItem(mhCounter);
+
+  return Continue;
+}
+
 bool CFitProblem::restore(const bool & updateModel)
 {
   bool success = true;
@@ -1105,6 +1339,7 @@ bool CFitProblem::restore(const bool & updateModel)
   success &= COptProblem::restore(updateModel);
 
   pdelete(mpTrajectoryProblem);
+  destroyWorkers();
 
   return success;
 }
@@ -1212,6 +1447,16 @@ void CFitProblem::printResult(std::ostream * ostream) const
      << CCopasiTimeVariable::LL2String(CPUTime.getSeconds(), 1) << "."
      << CCopasiTimeVariable::LL2String(CPUTime.getMilliSeconds(true), 3) << std::endl;
   os << "Evaluations/Second [1/s]:\t" << mCounter / (C_FLOAT64)(CPUTime.getMilliSeconds() / 1e3) << std::endl;
+
+  if (mValueCache.getSize() > 0)
+    {
+      os << "Cache Hits:\t" << mValueCache.getHits() << std::endl;
+      os << "Cache Misses:\t" << mValueCache.getMisses() << std::endl;
+    }
+
+  if (mTerminatedCounter > 0)
+    os << "Terminated Evaluations:\t" << mTerminatedCounter << std::endl;
+
   os << std::endl;
 
   std::vector< COptItem * >::const_iterator itItem =
@@ -1298,6 +1543,17 @@ void CFitProblem::printResult(std::ostream * ostream) const
       os << "Correlation Matrix:" << std::endl;
       os << "  " << mCorrelation << std::endl;
     }
+
+  if (*mpParmCalculateProfiles)
+    {
+      os << "Profile Likelihood Evaluations:\t" << mProfileEvaluations << std::endl;
+
+      os << "Profile Likelihood Parameter Values:" << std::endl;
+      os << "  " << mProfileValues << std::endl;
+
+      os << "Profile Likelihood Objective Values:" << std::endl;
+      os << "  " << mProfileObjective << std::endl;
+    }
 }
 
 std::ostream &operator<<(std::ostream &os, const CFitProblem & o)
@@ -1372,6 +1628,47 @@ const CVector< C_FLOAT64 > & CFitProblem::getResiduals() const
   return mResiduals;
 }
 
+CFitProblem * CFitProblem::createWorker(CMathContainer * pContainer) const
+{
+  if (pContainer == NULL) return NULL;
+
+  // The workers are kept out of the object hierarchy of the data model.
+  if (mpWorkerContainer == NULL)
+    {
+      mpWorkerContainer = new CDataContainer("Workers", NO_PARENT, "Container");
+      mpWorkerContainer->setObjectParent(this);
+    }
+
+  CFitProblem * pWorker = new CFitProblem(*this, mpWorkerContainer);
+
+  pWorker->mIsWorker = true;
+  // Workers may run concurrently and must not report progress.
+  pWorker->setCallBack(NULL);
+  pWorker->setMathContainer(pContainer);
+
+  if (!pWorker->initialize())
+    {
+      delete pWorker;
+      return NULL;
+    }
+
+  pWorker->setResidualsRequired(mResiduals.size() > 0);
+
+  // Evaluations of a worker are recorded in the trace of this problem.
+  pWorker->mpTrace = mpTrace;
+
+  // A worker must keep the same item fixed at the same value.
+  if (mFixedOptItem != C_INVALID_INDEX)
+    pWorker->fixOptItem(mFixedOptItem, *mContainerVariables[mFixedOptItem]);
+
+  return pWorker;
+}
+
+const bool & CFitProblem::isWorker() const
+{
+  return mIsWorker;
+}
+
 void CFitProblem::calcFIM(const CMatrix< C_FLOAT64 >& jacobian, CMatrix< C_FLOAT64 >& fim)
 {
   size_t i, j, l;
@@ -1719,6 +2016,9 @@ bool CFitProblem::calcCov(const CMatrix< C_FLOAT64 >& fim, CMatrix< C_FLOAT64 >&
 bool CFitProblem::calculateStatistics(const C_FLOAT64 & factor,
                                       const C_FLOAT64 & resolution)
 {
+  // The statistics require complete evaluations.
+  mObjectiveBound = std::numeric_limits< C_FLOAT64 >::infinity();
+
   // Set the current values to the solution values.
   size_t i, imax = mSolutionVariables.size();
 
@@ -2037,6 +2337,177 @@ CDataArray & CFitProblem::getCorrelations() const
   return *mpCorrelationMatrix;
 }
 
+const bool & CFitProblem::getCalculateProfiles() const
+{
+  return *mpParmCalculateProfiles;
+}
+
+void CFitProblem::setCalculateProfiles(const bool & calculate)
+{
+  *mpParmCalculateProfiles = calculate;
+}
+
+CDataArray & CFitProblem::getProfileValues() const
+{
+  return *mpProfileValuesMatrix;
+}
+
+CDataArray & CFitProblem::getProfileObjectiveValues() const
+{
+  return *mpProfileObjectiveMatrix;
+}
+
+bool CFitProblem::calculateProfiles()
+{
+  mProfileValues = std::numeric_limits< C_FLOAT64 >::quiet_NaN();
+  mProfileObjective = std::numeric_limits< C_FLOAT64 >::quiet_NaN();
+  mProfileEvaluations = 0;
+
+  if (!*mpParmCalculateProfiles ||
+      mSolutionValue == mWorstValue ||
+      mpContainer == NULL)
+    return false;
+
+  // Each thread needs its own container, problem, and minimizer. Without
+  // threads the master uses copies too so that the solution is not modified.
+  CContext< sProfile > Profiles(true);
+
+  sProfile * pProfile = Profiles.beginThread();
+  sProfile * pProfileEnd = Profiles.endThread();
+
+  if (!Profiles.isParallel())
+    {
+      pProfile = &Profiles.master();
+      pProfileEnd = pProfile + 1;
+    }
+
+  sProfile * pProfileBegin = pProfile;
+  bool success = true;
+
+  for (; pProfile != pProfileEnd && success; ++pProfile)
+    {
+      pProfile->pContainer = new CMathContainer(*mpContainer);
+      pProfile->pProblem = createWorker(pProfile->pContainer);
+
+      if (pProfile->pProblem == NULL)
+        {
+          success = false;
+          break;
+        }
+
+      pProfile->pProblem->setCalculateStatistics(false);
+      pProfile->pProblem->setRandomizeStartValues(false);
+      pProfile->pProblem->setObjectiveBound(std::numeric_limits< C_FLOAT64 >::infinity());
+
+      // let's use our favorite lsq method
+      pProfile->pMinimizer = static_cast< COptMethod * >(CCopasiMethod::createMethod(getObjectParent(),
+                             CTaskEnum::Method::LevenbergMarquardt,
+                             CTaskEnum::Task::parameterFitting));
+      pProfile->pMinimizer->setMathContainer(pProfile->pContainer);
+      pProfile->pMinimizer->setProblem(pProfile->pProblem);
+    }
+
+  if (success)
+    {
+      size_t i;
+      C_INT32 Size = (C_INT32) mpOptItems->size();
+      bool Running = true;
+
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic) reduction(&& : Running)
+#endif // USE_OMP
+
+      for (C_INT32 k = 0; k < Size; k++)
+        {
+          Running = calculateProfile(Profiles.active(), k) && Running;
+        }
+
+      for (i = 0; i < mSolutionVariables.size(); i++)
+        {
+          mProfileValues(i, *mpParmProfileSteps) = mSolutionVariables[i];
+          mProfileObjective(i, *mpParmProfileSteps) = mSolutionValue;
+        }
+
+      success = Running;
+    }
+
+  for (pProfile = pProfileBegin; pProfile != pProfileEnd; ++pProfile)
+    {
+      mProfileEvaluations += pProfile->Evaluations;
+
+      pdelete(pProfile->pMinimizer);
+      // The problem refers to the container and must be destroyed first.
+      pdelete(pProfile->pProblem);
+      pdelete(pProfile->pContainer);
+    }
+
+  return success;
+}
+
+bool CFitProblem::calculateProfile(sProfile & profile, const size_t & index)
+{
+  bool Running = true;
+
+  const COptItem & Item = *(*mpOptItems)[index];
+  const C_FLOAT64 & Solution = mSolutionVariables[index];
+  const C_FLOAT64 & StepSize = *mpParmProfileStepSize;
+  const C_INT32 Steps = (C_INT32) *mpParmProfileSteps;
+
+  CFitProblem & Problem = *profile.pProblem;
+  CVector< C_FLOAT64 > Start;
+
+  C_INT32 Direction, Step;
+  size_t i, imax = mSolutionVariables.size();
+
+  for (Direction = -1; Direction <= 1 && Running; Direction += 2)
+    {
+      // Each direction starts at the solution.
+      Start = mSolutionVariables;
+
+      for (Step = 1; Step <= Steps && Running; ++Step)
+        {
+          C_FLOAT64 Value;
+
+          // The steps are relative to the solution unless it is zero.
+          if (Solution != 0.0)
+            Value = Solution * pow(1.0 + StepSize, Direction * Step);
+          else
+            Value = Direction * Step * StepSize;
+
+          // The profile ends at the bounds of the item.
+          if (Item.checkConstraint(Value)) break;
+
+          Problem.reset();
+
+          if (!Problem.fixOptItem(index, Value)) return false;
+
+          // We warm start from the optimum of the previous profile point.
+          const std::vector< COptItem * > & FreeItems = Problem.getOptItemList();
+          std::vector< COptItem * >::const_iterator itFree = FreeItems.begin();
+
+          for (i = 0; i < imax; i++)
+            if (i != index)
+              (*itFree++)->setStartValue(Start[i]);
+
+          Problem.resetEvaluations();
+          Running &= profile.pMinimizer->optimise();
+          profile.Evaluations += Problem.getFunctionEvaluations();
+
+          C_INT32 Column = Steps + Direction * Step;
+          mProfileValues(index, Column) = Value;
+          mProfileObjective(index, Column) = Problem.getSolutionValue();
+
+          if (Problem.getSolutionValue() < std::numeric_limits< C_FLOAT64 >::infinity() &&
+              Problem.getSolutionVariables().size() == imax)
+            Start = Problem.getSolutionVariables();
+        }
+    }
+
+  Problem.releaseOptItem();
+
+  return Running;
+}
+
 const CExperimentSet & CFitProblem::getExperimentSet() const
 {
   return *mpExperimentSet;
@@ -2091,191 +2562,300 @@ bool CFitProblem::calculateCrossValidation()
   bool Continue = true;
 
   size_t i, imax = mpCrossValidationSet->getExperimentCount();
-  size_t j;
-  size_t kmax;
   C_FLOAT64 CalculateValue = 0.0;
 
-  CExperiment * pExp = NULL;
-
-  C_FLOAT64 * Residuals = NULL;
-  C_FLOAT64 * DependentValues = mCrossValidationDependentValues.array();
-
-  C_FLOAT64 ** pUpdate = mExperimentValues.array();
-
+  // The validation value only depends on the solution variables.
+  CVector< C_FLOAT64 * > SolutionVariables(mSolutionVariables.size());
+  C_FLOAT64 ** ppSolutionVariable = SolutionVariables.array();
   C_FLOAT64 * pSolution = mSolutionVariables.array();
   C_FLOAT64 * pSolutionEnd = pSolution + mSolutionVariables.size();
 
-  std::vector<COptItem *>::iterator itConstraint;
-  std::vector<COptItem *>::iterator endConstraint = mpConstraintItems->end();
+  for (; pSolution != pSolutionEnd; ++pSolution, ++ppSolutionVariable)
+    *ppSolutionVariable = pSolution;
 
-  std::vector< Refresh *>::const_iterator itRefresh;
-  std::vector< Refresh *>::const_iterator endRefresh;
+  if (mStoreResults ||
+      !mCrossValidationCache.find(SolutionVariables, CalculateValue))
+    {
+      C_FLOAT64 * DependentValues = mCrossValidationDependentValues.array();
 
-  // Reset the constraints memory
-  for (itConstraint = mpConstraintItems->begin(); itConstraint != endConstraint; ++itConstraint)
-    static_cast<CFitConstraint *>(*itConstraint)->resetConstraintViolation();
+      std::vector<COptItem *>::iterator itConstraint;
+      std::vector<COptItem *>::iterator endConstraint = mpConstraintItems->end();
 
-  CFitConstraint **ppConstraint = mCrossValidationConstraints.array();
-  CFitConstraint **ppConstraintEnd;
+      // Reset the constraints memory
+      for (itConstraint = mpConstraintItems->begin(); itConstraint != endConstraint; ++itConstraint)
+        static_cast<CFitConstraint *>(*itConstraint)->resetConstraintViolation();
 
-  try
-    {
-      for (i = 0; i < imax && Continue; i++) // For each CrossValidation
+      // The workers check their own copies of the constraints, i.e., we only
+      // use them if there are no constraints.
+      if (!mStoreResults &&
+          imax > 1 &&
+          mpConstraintItems->empty() &&
+          createWorkers())
         {
-          pExp = mpCrossValidationSet->getExperiment(i);
+          CVector< C_FLOAT64 > Values(imax);
+          C_INT32 Size = (C_INT32) imax;
+          bool Running = true;
 
-          // set the global and CrossValidation local fit item values.
-          for (; pSolution != pSolutionEnd; pSolution++, pUpdate++)
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic) reduction(&& : Running)
+#endif // USE_OMP
+
+          for (C_INT32 k = 0; k < Size; k++)
             {
-              if (*pUpdate)
+              C_FLOAT64 * pDependentValues = NULL;
+              Running = mWorkers.active().pProblem->calculateCrossValidationExperiment(k, mSolutionVariables, pDependentValues, Values[k]) && Running;
+            }
+
+          Continue = Running;
+
+          // Sum in the order of the experiments so that the result does not
+          // depend on the scheduling of the threads.
+          for (i = 0; i < imax; i++)
+            {
+              if (Values[i] == mWorstValue)
                 {
-                  **pUpdate = *pSolution;
+                  CalculateValue = mWorstValue;
+                  break;
                 }
-            }
 
-          mpContainer->applyUpdateSequence(mCrossValidationInitialUpdates[i]);
+              CalculateValue += Values[i];
+            }
 
-          kmax = pExp->getNumDataRows();
+          sWorker * pWorker = mWorkers.beginThread();
+          sWorker * pWorkerEnd = mWorkers.endThread();
 
-          switch (pExp->getExperimentType())
+          for (; pWorker != pWorkerEnd; ++pWorker)
             {
-              case CTaskEnum::Task::steadyState:
-              {
-                CVector< C_FLOAT64 > CompleteExperimentInitialState = mpContainer->getCompleteInitialState();
+              mFailedCounterException += pWorker->pProblem->mFailedCounterException;
+              pWorker->pProblem->mFailedCounterException = 0;
+            }
+        }
+      else
+        {
+          for (i = 0; i < imax && Continue; i++) // For each CrossValidation
+            {
+              C_FLOAT64 Value;
+              Continue = calculateCrossValidationExperiment(i, mSolutionVariables, DependentValues, Value);
 
-                // set independent data
-                for (j = 0; j < kmax && Continue; j++) // For each data row;
-                  {
-                    pExp->updateModelWithIndependentData(j);
+              if (Value == mWorstValue)
+                {
+                  CalculateValue = mWorstValue;
+                  break;
+                }
 
-                    Continue &= mpSteadyState->process(true);
+              CalculateValue += Value;
+            }
+        }
 
-                    if (!Continue)
-                      {
-                        CalculateValue = mWorstValue;
-                        break;
-                      }
+      if (isnan(CalculateValue))
+        {
+          mFailedCounterNaN++;
+          CalculateValue = mWorstValue;
+        }
 
-                    // We check after each simulation whether the constraints are violated.
-                    // Make sure the constraint values are up to date.
-                    mpContainer->applyUpdateSequence(mCrossValidationConstraintUpdates[i]);
+      // Failed evaluations are not cached since they may succeed when repeated.
+      bool Failed = (CalculateValue == mWorstValue);
 
-                    ppConstraint = mCrossValidationConstraints[i];
-                    ppConstraintEnd = ppConstraint + mCrossValidationConstraints.numCols();
+      if (!checkFunctionalConstraints())
+        CalculateValue = mWorstValue;
 
-                    for (; ppConstraint != ppConstraintEnd; ++ppConstraint)
-                      if (*ppConstraint)(*ppConstraint)->checkConstraint();
+      if (!mStoreResults && !Failed)
+        mCrossValidationCache.insert(SolutionVariables, CalculateValue);
+    }
 
-                    if (mStoreResults)
-                      CalculateValue += pExp->sumOfSquaresStore(j, DependentValues);
-                    else
-                      CalculateValue += pExp->sumOfSquares(j, Residuals);
-                  }
+  if (mpCallBack)
+    Continue &= mpCallBack->progressItem(mhCounter);
 
-                // Restore the containers initial state to the current experimental initial conditions
-                mpContainer->setCompleteInitialState(CompleteExperimentInitialState);
-              }
-              break;
+  C_FLOAT64 CurrentObjective =
+    (1.0 - mpCrossValidationSet->getWeight()) * mSolutionValue
+    + mpCrossValidationSet->getWeight() * CalculateValue * mpCrossValidationSet->getDataPointCount() / mpExperimentSet->getDataPointCount();
 
-              case CTaskEnum::Task::timeCourse:
+  if (CurrentObjective > mCrossValidationObjective)
+    mThresholdCounter++;
+  else
+    {
+      mThresholdCounter = 0;
+      mCrossValidationObjective = CurrentObjective;
+      mCrossValidationSolutionValue = CalculateValue;
+    }
+
+  Continue &= (mThresholdCounter < mpCrossValidationSet->getThreshold());
+
+  return Continue;
+}
+
+bool CFitProblem::calculateCrossValidationExperiment(const size_t & index,
+    const CVectorCore< C_FLOAT64 > & solution,
+    C_FLOAT64 *& pDependentValues,
+    C_FLOAT64 & value)
+{
+  bool Continue = true;
+  value = 0.0;
+
+  size_t j;
+  size_t kmax;
+
+  CExperiment * pExp = mpCrossValidationSet->getExperiment(index);
+
+  C_FLOAT64 * Residuals = NULL;
+
+  C_FLOAT64 ** pUpdate = mCrossValidationValues[index];
+
+  const C_FLOAT64 * pSolution = solution.array();
+  const C_FLOAT64 * pSolutionEnd = pSolution + solution.size();
+
+  CFitConstraint **ppConstraint;
+  CFitConstraint **ppConstraintEnd;
+
+  try
+    {
+      // set the global and CrossValidation local fit item values.
+      for (; pSolution != pSolutionEnd; pSolution++, pUpdate++)
+        {
+          if (*pUpdate)
+            {
+              **pUpdate = *pSolution;
+            }
+        }
+
+      mpContainer->applyUpdateSequence(mCrossValidationInitialUpdates[index]);
+
+      kmax = pExp->getNumDataRows();
+
+      switch (pExp->getExperimentType())
+        {
+          case CTaskEnum::Task::steadyState:
+          {
+            CVector< C_FLOAT64 > CompleteExperimentInitialState = mpContainer->getCompleteInitialState();
+
+            // set independent data
+            for (j = 0; j < kmax && Continue; j++) // For each data row;
               {
-                size_t numIntermediateSteps;
-                C_FLOAT64 LastTime = std::numeric_limits< C_FLOAT64 >::quiet_NaN();
-                bool Advanced = true;
+                pExp->updateModelWithIndependentData(j);
 
-                if (mStoreResults)
+                Continue &= mpSteadyState->process(true);
+
+                if (!Continue)
                   {
-                    //calculate a reasonable number of intermediate points
-                    numIntermediateSteps = 4; //TODO
-                    //resize the storage for the extended time series
-                    pExp->initExtendedTimeSeries(numIntermediateSteps * kmax - numIntermediateSteps + 1);
+                    value = mWorstValue;
+                    break;
                   }
 
-                for (j = 0; j < kmax && Continue; j++) // For each data row;
-                  {
-                    if (j)
-                      {
-                        if (mStoreResults)
-                          {
-                            //do additional intermediate steps for nicer display
-                            C_FLOAT64 ttt;
-                            size_t ic;
+                // We check after each simulation whether the constraints are violated.
+                // Make sure the constraint values are up to date.
+                mpContainer->applyUpdateSequence(mCrossValidationConstraintUpdates[index]);
 
-                            for (ic = 1; ic < numIntermediateSteps; ++ic)
-                              {
-                                ttt = pExp->getTimeData()[j - 1] + (pExp->getTimeData()[j] - pExp->getTimeData()[j - 1]) * (C_FLOAT64(ic) / numIntermediateSteps);
-                                mpTrajectory->processStep(ttt);
-                                //save the simulation results in the experiment
-                                pExp->storeExtendedTimeSeriesData(ttt);
-                              }
-                          }
+                ppConstraint = mCrossValidationConstraints[index];
+                ppConstraintEnd = ppConstraint + mCrossValidationConstraints.numCols();
 
-                        //do the regular step
-                        C_FLOAT64 NextTime = pExp->getTimeData()[j];
-                        Advanced = (NextTime != LastTime);
+                for (; ppConstraint != ppConstraintEnd; ++ppConstraint)
+                  if (*ppConstraint)(*ppConstraint)->checkConstraint();
 
-                        if (Advanced)
-                          {
-                            mpTrajectory->processStep(NextTime);
-                            LastTime = NextTime;
-                          }
-                      }
-                    else
-                      {
-                        // Set independent data. A time course only has one set of
-                        // independent data.
-                        pExp->updateModelWithIndependentData(0);
+                if (mStoreResults)
+                  value += pExp->sumOfSquaresStore(j, pDependentValues);
+                else
+                  value += pExp->sumOfSquares(j, Residuals);
+              }
 
-                        // We need to apply the parameter and independent
-                        // value updates as one unit.
-                        mpContainer->applyUpdateSequence(mCrossValidationInitialUpdates[i]);
+            // Restore the containers initial state to the current experimental initial conditions
+            mpContainer->setCompleteInitialState(CompleteExperimentInitialState);
+          }
+          break;
 
-                        static_cast<CTrajectoryProblem *>(mpTrajectory->getProblem())->setStepNumber(1);
-                        mpTrajectory->processStart(true);
+          case CTaskEnum::Task::timeCourse:
+          {
+            size_t numIntermediateSteps;
+            C_FLOAT64 LastTime = std::numeric_limits< C_FLOAT64 >::quiet_NaN();
+            bool Advanced = true;
 
-                        C_FLOAT64 NextTime = pExp->getTimeData()[0];
+            if (mStoreResults)
+              {
+                //calculate a reasonable number of intermediate points
+                numIntermediateSteps = 4; //TODO
+                //resize the storage for the extended time series
+                pExp->initExtendedTimeSeries(numIntermediateSteps * kmax - numIntermediateSteps + 1);
+              }
 
-                        if (NextTime != *mpInitialStateTime)
+            for (j = 0; j < kmax && Continue; j++) // For each data row;
+              {
+                if (j)
+                  {
+                    if (mStoreResults)
+                      {
+                        //do additional intermediate steps for nicer display
+                        C_FLOAT64 ttt;
+                        size_t ic;
+
+                        for (ic = 1; ic < numIntermediateSteps; ++ic)
                           {
-                            mpTrajectory->processStep(NextTime);
-                            LastTime = NextTime;
+                            ttt = pExp->getTimeData()[j - 1] + (pExp->getTimeData()[j] - pExp->getTimeData()[j - 1]) * (C_FLOAT64(ic) / numIntermediateSteps);
+                            mpTrajectory->processStep(ttt);
+                            //save the simulation results in the experiment
+                            pExp->storeExtendedTimeSeriesData(ttt);
                           }
                       }
 
+                    //do the regular step
+                    C_FLOAT64 NextTime = pExp->getTimeData()[j];
+                    Advanced = (NextTime != LastTime);
+
                     if (Advanced)
                       {
-                        // We check after each simulation whether the constraints are violated.
-                        // Make sure the constraint values are up to date.
-                        mpContainer->applyUpdateSequence(mCrossValidationConstraintUpdates[i]);
+                        mpTrajectory->processStep(NextTime);
+                        LastTime = NextTime;
+                      }
+                  }
+                else
+                  {
+                    // Set independent data. A time course only has one set of
+                    // independent data.
+                    pExp->updateModelWithIndependentData(0);
 
-                        ppConstraint = mCrossValidationConstraints[i];
-                        ppConstraintEnd = ppConstraint + mCrossValidationConstraints.numCols();
+                    // We need to apply the parameter and independent
+                    // value updates as one unit.
+                    mpContainer->applyUpdateSequence(mCrossValidationInitialUpdates[index]);
 
-                        for (; ppConstraint != ppConstraintEnd; ++ppConstraint)
-                          if (*ppConstraint)(*ppConstraint)->checkConstraint();
-                      }
+                    static_cast<CTrajectoryProblem *>(mpTrajectory->getProblem())->setStepNumber(1);
+                    mpTrajectory->processStart(true);
 
-                    if (mStoreResults)
-                      CalculateValue += pExp->sumOfSquaresStore(j, DependentValues);
-                    else
-                      CalculateValue += pExp->sumOfSquares(j, Residuals);
+                    C_FLOAT64 NextTime = pExp->getTimeData()[0];
 
-                    if (mStoreResults)
+                    if (NextTime != *mpInitialStateTime)
                       {
-                        //additionally also store the the simulation result for the extended time series
-                        pExp->storeExtendedTimeSeriesData(pExp->getTimeData()[j]);
+                        mpTrajectory->processStep(NextTime);
+                        LastTime = NextTime;
                       }
                   }
-              }
-              break;
 
-              default:
-                break;
-            }
+                if (Advanced)
+                  {
+                    // We check after each simulation whether the constraints are violated.
+                    // Make sure the constraint values are up to date.
+                    mpContainer->applyUpdateSequence(mCrossValidationConstraintUpdates[index]);
 
-          // Restore the containers initial state. This includes all local reaction parameter
-          // Additionally this state is synchronized, i.e. nothing to compute.
-          mpContainer->setCompleteInitialState(mCompleteInitialState);
+                    ppConstraint = mCrossValidationConstraints[index];
+                    ppConstraintEnd = ppConstraint + mCrossValidationConstraints.numCols();
+
+                    for (; ppConstraint != ppConstraintEnd; ++ppConstraint)
+                      if (*ppConstraint)(*ppConstraint)->checkConstraint();
+                  }
+
+                if (mStoreResults)
+                  value += pExp->sumOfSquaresStore(j, pDependentValues);
+                else
+                  value += pExp->sumOfSquares(j, Residuals);
+
+                if (mStoreResults)
+                  {
+                    //additionally also store the the simulation result for the extended time series
+                    pExp->storeExtendedTimeSeriesData(pExp->getTimeData()[j]);
+                  }
+              }
+          }
+          break;
+
+          default:
+            break;
         }
     }
 
@@ -2285,51 +2865,66 @@ bool CFitProblem::calculateCrossValidation()
       CCopasiMessage::getLastMessage();
 
       mFailedCounterException++;
-      CalculateValue = mWorstValue;
-
-      // Restore the containers initial state. This includes all local reaction parameter
-      // Additionally this state is synchronized, i.e. nothing to compute.
-      mpContainer->setCompleteInitialState(mCompleteInitialState);
+      value = mWorstValue;
     }
 
   catch (...)
     {
       mFailedCounterException++;
-      CalculateValue = mWorstValue;
-
-      // Restore the containers initial state. This includes all local reaction parameter
-      // Additionally this state is synchronized, i.e. nothing to compute.
-      mpContainer->setCompleteInitialState(mCompleteInitialState);
+      value = mWorstValue;
     }
 
-  if (isnan(CalculateValue))
-    {
-      mFailedCounterNaN++;
-      CalculateValue = mWorstValue;
-    }
+  // Restore the containers initial state. This includes all local reaction parameter
+  // Additionally this state is synchronized, i.e. nothing to compute.
+  mpContainer->setCompleteInitialState(mCompleteInitialState);
 
-  if (!checkFunctionalConstraints())
-    CalculateValue = mWorstValue;
+  return Continue;
+}
 
-  if (mpCallBack)
-    Continue &= mpCallBack->progressItem(mhCounter);
+bool CFitProblem::createWorkers()
+{
+  if (mWorkers.isParallel())
+    return true;
 
-  C_FLOAT64 CurrentObjective =
-    (1.0 - mpCrossValidationSet->getWeight()) * mSolutionValue
-    + mpCrossValidationSet->getWeight() * CalculateValue * mpCrossValidationSet->getDataPointCount() / mpExperimentSet->getDataPointCount();
+  mWorkers.init(mpContainer != NULL);
 
-  if (CurrentObjective > mCrossValidationObjective)
-    mThresholdCounter++;
-  else
+  if (!mWorkers.isParallel())
+    return false;
+
+  sWorker * pWorker = mWorkers.beginThread();
+  sWorker * pWorkerEnd = mWorkers.endThread();
+
+  for (; pWorker != pWorkerEnd; ++pWorker)
     {
-      mThresholdCounter = 0;
-      mCrossValidationObjective = CurrentObjective;
-      mCrossValidationSolutionValue = CalculateValue;
+      pWorker->pContainer = new CMathContainer(*mpContainer);
+      pWorker->pProblem = createWorker(pWorker->pContainer);
+
+      if (pWorker->pProblem == NULL)
+        {
+          // Fall back to the serial calculation.
+          destroyWorkers();
+          return false;
+        }
+
+      pWorker->pProblem->setResidualsRequired(false);
     }
 
-  Continue &= (mThresholdCounter < mpCrossValidationSet->getThreshold());
+  return true;
+}
 
-  return Continue;
+void CFitProblem::destroyWorkers()
+{
+  sWorker * pWorker = mWorkers.beginThread();
+  sWorker * pWorkerEnd = mWorkers.endThread();
+
+  for (; pWorker != pWorkerEnd; ++pWorker)
+    {
+      // The problem refers to the container and must be destroyed first.
+      pdelete(pWorker->pProblem);
+      pdelete(pWorker->pContainer);
+    }
+
+  mWorkers.init(false);
 }
 
 void CFitProblem::fixBuild55()
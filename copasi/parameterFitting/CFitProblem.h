@@ -23,6 +23,7 @@
 #include "optimization/COptProblem.h"
 #include <copasi/parameterFitting/CFitItem.h>
 #include "copasi/core/CMatrix.h"
+#include "copasi/core/CContext.h"
 
 class CExperimentSet;
 class CCrossValidationSet;
@@ -30,6 +31,8 @@ class CTrajectoryProblem;
 class CState;
 class CFitConstraint;
 class CDataArray;
+class CMathContainer;
+class COptMethod;
 template < class CMatrixType > class CMatrixInterface;
 
 class CFitProblem : public COptProblem
@@ -85,6 +88,25 @@ public:
    */
   virtual bool calculate();
 
+  /**
+   * Calculate the objective values of a batch of points. The points are
+   * distributed over concurrently working copies of the problem.
+   * @param const std::vector< CVector< C_FLOAT64 > * > & points
+   * @param CVector< C_FLOAT64 > & values
+   * @param CVector< C_FLOAT64 > & constraintViolations
+   * @result bool continue
+   */
+  virtual bool calculateBatch(const std::vector< CVector< C_FLOAT64 > * > & points,
+                              CVector< C_FLOAT64 > & values,
+                              CVector< C_FLOAT64 > & constraintViolations);
+
+  /**
+   * Check whether batches of points are calculated concurrently, i.e., whether
+   * workers are available
+   * @result bool isBatchParallel
+   */
+  virtual bool isBatchParallel();
+
   /**
    * Do all necessary restore procedures so that the
    * model is in the same state as before
@@ -142,6 +164,24 @@ public:
    */
   const CVector< C_FLOAT64 > & getResiduals() const;
 
+  /**
+   * Create a worker, i.e., a copy of this initialized problem which evaluates
+   * the objective function on the provided copy of the math container. The
+   * worker uses private copies of the steady-state and time course tasks and
+   * may therefore be calculated concurrently with this problem and with other
+   * workers. The worker is not part of the object hierarchy of the data model.
+   * The caller owns the worker, which must be destroyed before the container.
+   * @param CMathContainer * pContainer
+   * @return CFitProblem * pWorker (NULL on failure)
+   */
+  CFitProblem * createWorker(CMathContainer * pContainer) const;
+
+  /**
+   * Check whether the problem is a worker
+   * @return const bool & isWorker
+   */
+  const bool & isWorker() const;
+
   /**
    * calculate the FIM from the parameter estimation jacobian
    */
@@ -247,6 +287,40 @@ public:
    */
   CDataArray & getCorrelations() const;
 
+  /**
+   * Calculate the profile likelihood of each fit item. Starting from the
+   * solution each item is stepped along its profile in both directions while
+   * the remaining items are re-optimized. Each re-optimization starts from the
+   * optimum of the previous profile point. The profiles of different items
+   * are calculated concurrently.
+   * @return bool success
+   */
+  bool calculateProfiles();
+
+  /**
+   * Check whether the profile likelihood is calculated
+   * @return const bool & calculateProfiles
+   */
+  const bool & getCalculateProfiles() const;
+
+  /**
+   * Set whether the profile likelihood is calculated
+   * @param const bool & calculate
+   */
+  void setCalculateProfiles(const bool & calculate);
+
+  /**
+   * Retrieve the values of the fit items along their profiles.
+   * @return CDataArray & profileValues
+   */
+  CDataArray & getProfileValues() const;
+
+  /**
+   * Retrieve the objective values along the profiles of the fit items.
+   * @return CDataArray & profileObjectiveValues
+   */
+  CDataArray & getProfileObjectiveValues() const;
+
   /**
    * Retrieve the experiment set.
    * @return const CExperimentSet & experiementSet
@@ -359,6 +433,66 @@ private:
    */
   bool calculateCrossValidation();
 
+  /**
+   * Calculate the objective value of a single cross validation experiment
+   * for the given solution variables
+   * @param const size_t & index
+   * @param const CVectorCore< C_FLOAT64 > & solution
+   * @param C_FLOAT64 *& pDependentValues
+   * @param C_FLOAT64 & value
+   * @result bool continue
+   */
+  bool calculateCrossValidationExperiment(const size_t & index,
+                                          const CVectorCore< C_FLOAT64 > & solution,
+                                          C_FLOAT64 *& pDependentValues,
+                                          C_FLOAT64 & value);
+
+  /**
+   * Create the workers which calculate batches of points and the cross
+   * validation experiments concurrently.
+   * @return bool parallel
+   */
+  bool createWorkers();
+
+  /**
+   * Destroy the workers
+   */
+  void destroyWorkers();
+
+  struct sWorker
+  {
+    sWorker():
+      pContainer(NULL),
+      pProblem(NULL)
+    {}
+
+    CMathContainer * pContainer;
+    CFitProblem * pProblem;
+  };
+
+  struct sProfile
+  {
+    sProfile():
+      pContainer(NULL),
+      pProblem(NULL),
+      pMinimizer(NULL),
+      Evaluations(0)
+    {}
+
+    CMathContainer * pContainer;
+    CFitProblem * pProblem;
+    COptMethod * pMinimizer;
+    unsigned C_INT32 Evaluations;
+  };
+
+  /**
+   * Calculate the profile of the fit item with the given index
+   * @param sProfile & profile
+   * @param const size_t & index
+   * @return bool continue
+   */
+  bool calculateProfile(sProfile & profile, const size_t & index);
+
 private:
   // Attributes
   /**
@@ -568,6 +702,53 @@ private:
   CMatrixInterface< CMatrix< C_FLOAT64 > > * mpCorrelationMatrixInterface;
   CDataArray * mpCorrelationMatrix;
 
+  /**
+   * The values of the fit items along their profiles
+   */
+  CMatrix< C_FLOAT64 > mProfileValues;
+  CMatrixInterface< CMatrix< C_FLOAT64 > > * mpProfileValuesMatrixInterface;
+  CDataArray * mpProfileValuesMatrix;
+
+  /**
+   * The objective values along the profiles of the fit items
+   */
+  CMatrix< C_FLOAT64 > mProfileObjective;
+  CMatrixInterface< CMatrix< C_FLOAT64 > > * mpProfileObjectiveMatrixInterface;
+  CDataArray * mpProfileObjectiveMatrix;
+
+  /**
+   * The number of function evaluations of the profile likelihood calculation
+   */
+  unsigned C_INT32 mProfileEvaluations;
+
+  /**
+   * A pointer to the value of the CCopasiParameter holding Calculate Profile Likelihood
+   */
+  bool * mpParmCalculateProfiles;
+
+  /**
+   * A pointer to the value of the CCopasiParameter holding the number of
+   * profile steps in each direction
+   */
+  unsigned C_INT32 * mpParmProfileSteps;
+
+  /**
+   * A pointer to the value of the CCopasiParameter holding the relative size
+   * of a profile step
+   */
+  C_FLOAT64 * mpParmProfileStepSize;
+
+  /**
+   * The workers calculating batches of points and the cross validation
+   * experiments concurrently
+   */
+  CContext< sWorker > mWorkers;
+
+  /**
+   * The cache of the cross validation values of the accepted solutions
+   */
+  COptValueCache mCrossValidationCache;
+
   /**
    * A pointer to the value of the CCopasiParameter holding Create Parameter Sets
    */
@@ -577,6 +758,19 @@ private:
    * The original value of the trajectory update flag
    */
   bool mTrajectoryUpdate;
+
+  /**
+   * Indicates whether the problem is a worker owning its steady-state and
+   * time course tasks.
+   */
+  bool mIsWorker;
+
+  /**
+   * A private container holding the workers and their tasks. The container
+   * refers to this problem as its parent, i.e., the workers have access to
+   * the data model, but it is not one of the children of this problem.
+   */
+  mutable CDataContainer * mpWorkerContainer;
 };
 
 #endif  // COPASI_CFitProblem
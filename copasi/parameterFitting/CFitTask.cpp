@@ -102,6 +102,18 @@ bool CFitTask::process(const bool & useInitialValues)
   bool success = pMethod->optimise();
 
   pProblem->calculateStatistics();
+
+  if (pProblem->getCalculateProfiles())
+    {
+      // The re-optimizations along the profiles must not produce output.
+      COutputHandler * pOutputHandler = mpOutputHandler;
+      mpOutputHandler = NULL;
+
+      pProblem->calculateProfiles();
+
+      mpOutputHandler = pOutputHandler;
+    }
+
   pProblem->createParameterSets();
 
   output(COutputInterface::AFTER);
@@ -178,6 +178,7 @@ void CPlotItem::setType(CPlotItem::Type type)
     {
       assertParameter("log X", CCopasiParameter::Type::BOOL, false);
       assertParameter("log Y", CCopasiParameter::Type::BOOL, false);
+      assertParameter("output interval", CCopasiParameter::Type::DOUBLE, (C_FLOAT64) 0.0);
       mpXMLActivity = NULL;
       mActivity = (COutputInterface::Activity) 0;
     }
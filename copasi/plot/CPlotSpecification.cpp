@@ -185,6 +185,20 @@ void CPlotSpecification::setLogY(bool l)
   setValue("log Y", l);
 }
 
+void CPlotSpecification::setOutputInterval(const C_FLOAT64 & outputInterval)
+{
+  setValue("output interval", outputInterval);
+}
+
+C_FLOAT64 CPlotSpecification::getOutputInterval() const
+{
+  const CCopasiParameter * pParameter = getParameter("output interval");
+
+  if (pParameter == NULL) return 0.0;
+
+  return pParameter->getValue< C_FLOAT64 >();
+}
+
 //*************************************
 
 CPlotItem* CPlotSpecification::createItem(const std::string & name, CPlotItem::Type type)
@@ -109,6 +109,20 @@ public:
 
   void setLogX(bool l);
   void setLogY(bool l);
+
+  /**
+   * Set the minimal interval of simulated time between two points plotted
+   * during a task. A point is plotted for every step if the interval is not
+   * positive, which is the default.
+   * @param const C_FLOAT64 & outputInterval
+   */
+  void setOutputInterval(const C_FLOAT64 & outputInterval);
+
+  /**
+   * Retrieve the minimal interval of simulated time between two points
+   * @return C_FLOAT64 outputInterval
+   */
+  C_FLOAT64 getOutputInterval() const;
 };
 
 #endif
@@ -97,6 +97,7 @@ PlotWindow::PlotWindow(COutputHandlerPlot *pHandler, const CPlotSpecification *p
   createToolBar();
   mpPlot = new CopasiPlot(ptrSpec, this);
   setCentralWidget(mpPlot);
+  setOutputInterval(ptrSpec->getOutputInterval());
   initializing  = true;
   mpaToggleLogX->setChecked(ptrSpec->isLogX());
   mpaToggleLogY->setChecked(ptrSpec->isLogY());
@@ -209,6 +210,7 @@ bool PlotWindow::initFromSpec(const CPlotSpecification *ptrSpec)
 
   if (result)
     {
+      setOutputInterval(ptrSpec->getOutputInterval());
       initializing  = true;
       mpaToggleLogX->setChecked(ptrSpec->isLogX());
       mpaToggleLogY->setChecked(ptrSpec->isLogY());
@@ -33,6 +33,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
 #include <string.h>
 
 #include "copasi.h"
@@ -45,6 +46,7 @@ const std::string CRandom::TypeName[] =
   "r250",
   "Mersenne Twister",
   "Mersenne Twister (HR)",
+  "Philox 4x32-10",
   ""
 };
 
@@ -53,6 +55,7 @@ const char * CRandom::XMLType[] =
   "r250",
   "MersenneTwister",
   "MersenneTwisterHR",
+  "Philox4x32",
   NULL
 };
 
@@ -81,6 +84,11 @@ CRandom * CRandom::createGenerator(CRandom::Type type,
         RandomGenerator->mType = type;
         break;
 
+      case philox4x32:
+        RandomGenerator = new Cphilox4x32(seed);
+        RandomGenerator->mType = type;
+        break;
+
       default:
         RandomGenerator = new Cmt19937(seed);
         RandomGenerator->mType = type;
@@ -560,3 +568,266 @@ C_FLOAT64 CRandom::getRandomGamma(C_FLOAT64 shape, C_FLOAT64 scale)
 {
   return scale * getRandomStdGamma(shape);
 }
+
+C_FLOAT64 CRandom::getRandomBinomial(const unsigned C_INT32 & trials,
+                                     const C_FLOAT64 & probability)
+{
+  if (isnan(probability) || probability < 0.0 || probability > 1.0)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  if (trials == 0 || probability == 0.0) return 0.0;
+
+  if (probability == 1.0) return trials;
+
+  if (probability > 0.5)
+    return trials - getRandomBinomial(trials, 1.0 - probability);
+
+  // For large means we split the trials at the a-th order statistic X of the
+  // uniform numbers which is Beta(a, trials + 1 - a) distributed
+  // (Knuth, The Art of Computer Programming, Vol. 2, 3.4.1).
+  if (trials * probability >= 30.0)
+    {
+      unsigned C_INT32 a = 1 + trials / 2;
+      unsigned C_INT32 b = trials + 1 - a;
+
+      C_FLOAT64 Ga = getRandomStdGamma(a);
+      C_FLOAT64 X = Ga / (Ga + getRandomStdGamma(b));
+
+      if (X >= probability)
+        return getRandomBinomial(a - 1, probability / X);
+
+      return a + getRandomBinomial(b - 1, (probability - X) / (1.0 - X));
+    }
+
+  // Inversion
+  C_FLOAT64 q = 1.0 - probability;
+  C_FLOAT64 s = probability / q;
+  C_FLOAT64 r = pow(q, (C_FLOAT64) trials);
+  C_FLOAT64 u = getRandomCO();
+  unsigned C_INT32 x = 0;
+
+  while (u > r && x < trials)
+    {
+      u -= r;
+      ++x;
+      r *= s * (trials + 1 - x) / x;
+    }
+
+  return x;
+}
+
+void CRandom::fillRandomU(unsigned C_INT32 * pValues, const size_t & size)
+{
+  unsigned C_INT32 * pValue = pValues;
+  unsigned C_INT32 * pValueEnd = pValues + size;
+
+  for (; pValue != pValueEnd; ++pValue)
+    *pValue = getRandomU();
+}
+
+void CRandom::fillRandomCC(C_FLOAT64 * pValues, const size_t & size)
+{
+  C_FLOAT64 * pValue = pValues;
+  C_FLOAT64 * pValueEnd = pValues + size;
+
+  for (; pValue != pValueEnd; ++pValue)
+    *pValue = getRandomCC();
+}
+
+void CRandom::fillRandomCO(C_FLOAT64 * pValues, const size_t & size)
+{
+  C_FLOAT64 * pValue = pValues;
+  C_FLOAT64 * pValueEnd = pValues + size;
+
+  for (; pValue != pValueEnd; ++pValue)
+    *pValue = getRandomCO();
+}
+
+void CRandom::fillRandomOO(C_FLOAT64 * pValues, const size_t & size)
+{
+  C_FLOAT64 * pValue = pValues;
+  C_FLOAT64 * pValueEnd = pValues + size;
+
+  for (; pValue != pValueEnd; ++pValue)
+    *pValue = getRandomOO();
+}
+
+void CRandom::fillUniform(C_FLOAT64 * pValues, const size_t & size,
+                          const C_FLOAT64 & shift, const C_FLOAT64 & scale)
+{
+  unsigned C_INT32 Integers[256];
+
+  C_FLOAT64 * pValue = pValues;
+  C_FLOAT64 * pValueEnd = pValues + size;
+
+  while (pValue != pValueEnd)
+    {
+      size_t Size = std::min< size_t >(256, pValueEnd - pValue);
+      fillRandomU(Integers, Size);
+
+      // This loop has no dependencies and is vectorized by the compiler.
+      for (size_t i = 0; i < Size; ++i)
+        pValue[i] = (Integers[i] + shift) * scale;
+
+      pValue += Size;
+    }
+}
+
+void CRandom::fillRandomExp(C_FLOAT64 * pValues, const size_t & size)
+{
+  fillRandomOO(pValues, size);
+
+  C_FLOAT64 * pValue = pValues;
+  C_FLOAT64 * pValueEnd = pValues + size;
+
+  for (; pValue != pValueEnd; ++pValue)
+    *pValue = -log(*pValue);
+}
+
+void CRandom::fillRandomNormal(C_FLOAT64 * pValues, const size_t & size,
+                               const C_FLOAT64 & mean,
+                               const C_FLOAT64 & sd)
+{
+  if (size == 0) return;
+
+  // Box-Muller transformation of pairs of uniform random numbers
+  size_t Pairs = size / 2;
+  fillRandomOO(pValues, 2 * Pairs);
+
+  C_FLOAT64 * pValue = pValues;
+  C_FLOAT64 * pValueEnd = pValues + 2 * Pairs;
+
+  for (; pValue != pValueEnd; pValue += 2)
+    {
+      C_FLOAT64 Radius = sqrt(-2.0 * log(pValue[0])) * sd;
+      C_FLOAT64 Angle = 2.0 * M_PI * pValue[1];
+
+      pValue[0] = Radius * cos(Angle) + mean;
+      pValue[1] = Radius * sin(Angle) + mean;
+    }
+
+  if (size % 2)
+    {
+      C_FLOAT64 Uniform[2];
+      fillRandomOO(Uniform, 2);
+
+      *pValueEnd = sqrt(-2.0 * log(Uniform[0])) * cos(2.0 * M_PI * Uniform[1]) * sd + mean;
+    }
+}
+
+/**
+ * Helper class providing uniform random numbers in 0 < x < 1 which are
+ * generated in blocks.
+ */
+class CUniformPool
+{
+public:
+  CUniformPool(CRandom & random):
+    mRandom(random),
+    mpCurrent(mValues + Size)
+  {}
+
+  C_FLOAT64 next()
+  {
+    if (mpCurrent == mValues + Size)
+      {
+        mRandom.fillRandomOO(mValues, Size);
+        mpCurrent = mValues;
+      }
+
+    return *mpCurrent++;
+  }
+
+private:
+  enum {Size = 256};
+  CRandom & mRandom;
+  C_FLOAT64 mValues[Size];
+  C_FLOAT64 * mpCurrent;
+};
+
+void CRandom::fillRandomPoisson(C_FLOAT64 * pValues, const size_t & size,
+                                const C_FLOAT64 & mean)
+{
+  std::vector< C_FLOAT64 > Means(size, mean);
+  fillRandomPoisson(pValues, Means.data(), size);
+}
+
+void CRandom::fillRandomPoisson(C_FLOAT64 * pValues, const C_FLOAT64 * pMeans,
+                                const size_t & size)
+{
+  CUniformPool Pool(*this);
+
+  C_FLOAT64 * pValue = pValues;
+  C_FLOAT64 * pValueEnd = pValues + size;
+  const C_FLOAT64 * pMean = pMeans;
+
+  for (; pValue != pValueEnd; ++pValue, ++pMean)
+    {
+      const C_FLOAT64 & Mean = *pMean;
+
+      if (isnan(Mean) || Mean < 0.0)
+        {
+          *pValue = std::numeric_limits<double>::quiet_NaN();
+        }
+      else if (Mean < 10.0)
+        {
+          // Inversion
+          C_FLOAT64 p = exp(-Mean);
+          C_FLOAT64 u = Pool.next();
+          C_FLOAT64 k = 0.0;
+
+          while (u > p && p > 0.0)
+            {
+              u -= p;
+              k += 1.0;
+              p *= Mean / k;
+            }
+
+          *pValue = k;
+        }
+      else
+        {
+          // Transformed rejection with squeeze (W. Hoermann, Insurance: Mathematics
+          // and Economics 12, 39-45 (1993))
+          C_FLOAT64 LogMean = log(Mean);
+          C_FLOAT64 b = 0.931 + 2.53 * sqrt(Mean);
+          C_FLOAT64 a = -0.059 + 0.02483 * b;
+          C_FLOAT64 InvAlpha = 1.1239 + 1.1328 / (b - 3.4);
+          C_FLOAT64 vr = 0.9277 - 3.6224 / (b - 2.0);
+
+          while (true)
+            {
+              C_FLOAT64 U = Pool.next() - 0.5;
+              C_FLOAT64 V = Pool.next();
+              C_FLOAT64 us = 0.5 - fabs(U);
+              C_FLOAT64 k = floor((2.0 * a / us + b) * U + Mean + 0.43);
+
+              if (us >= 0.07 && V <= vr)
+                {
+                  *pValue = k;
+                  break;
+                }
+
+              if (k < 0.0 || (us < 0.013 && V > us))
+                continue;
+
+              if (log(V) + log(InvAlpha) - log(a / (us * us) + b) <= -Mean + k * LogMean - lgamma(k + 1.0))
+                {
+                  *pValue = k;
+                  break;
+                }
+            }
+        }
+    }
+}
+
+void CRandom::fillRandomBinomial(C_FLOAT64 * pValues, const size_t & size,
+                                 const unsigned C_INT32 & trials,
+                                 const C_FLOAT64 & probability)
+{
+  C_FLOAT64 * pValue = pValues;
+  C_FLOAT64 * pValueEnd = pValues + size;
+
+  for (; pValue != pValueEnd; ++pValue)
+    *pValue = getRandomBinomial(trials, probability);
+}
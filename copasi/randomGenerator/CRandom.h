@@ -57,6 +57,7 @@ public:
     r250 = 0,
     mt19937,
     mt19937HR,
+    philox4x32,
     unkown
   };
 
@@ -255,6 +256,104 @@ public:
   virtual C_FLOAT64 getRandomGamma(C_FLOAT64 shape, C_FLOAT64 scale);
   virtual C_FLOAT64 getRandomStdGamma(C_FLOAT64 shape);
 
+  /**
+   * Produces a Binomial distributed random number, i.e., the number of
+   * successes in the given number of trials with the given probability.
+   * @param const unsigned C_INT32 & trials
+   * @param const C_FLOAT64 & probability
+   * @return C_FLOAT64 random
+   */
+  C_FLOAT64 getRandomBinomial(const unsigned C_INT32 & trials,
+                              const C_FLOAT64 & probability);
+
+  // Bulk operations
+  /**
+   * Fill the buffer with random numbers in 0 <= n <= Modulus. The sequence
+   * is identical to the one produced by repeated calls to getRandomU().
+   * @param unsigned C_INT32 * pValues
+   * @param const size_t & size
+   */
+  virtual void fillRandomU(unsigned C_INT32 * pValues, const size_t & size);
+
+  /**
+   * Fill the buffer with uniformly distributed random numbers in 0 <= x <= 1.
+   * The sequence is identical to the one produced by repeated calls to getRandomCC().
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   */
+  virtual void fillRandomCC(C_FLOAT64 * pValues, const size_t & size);
+
+  /**
+   * Fill the buffer with uniformly distributed random numbers in 0 <= x < 1.
+   * The sequence is identical to the one produced by repeated calls to getRandomCO().
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   */
+  virtual void fillRandomCO(C_FLOAT64 * pValues, const size_t & size);
+
+  /**
+   * Fill the buffer with uniformly distributed random numbers in 0 < x < 1.
+   * The sequence is identical to the one produced by repeated calls to getRandomOO().
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   */
+  virtual void fillRandomOO(C_FLOAT64 * pValues, const size_t & size);
+
+  /**
+   * Fill the buffer with exponentially distributed random numbers with rate 1.
+   * Note: The values are computed by inversion and therefore differ from the
+   * sequence produced by getRandomExp().
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   */
+  void fillRandomExp(C_FLOAT64 * pValues, const size_t & size);
+
+  /**
+   * Fill the buffer with Normally distributed random numbers with Mean=mean and SD=sd.
+   * Note: The values are computed with the Box-Muller transformation and therefore
+   * differ from the sequence produced by getRandomNormal().
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   * @param const C_FLOAT64 & mean (default: 0.0)
+   * @param const C_FLOAT64 & sd (default: 1.0)
+   */
+  void fillRandomNormal(C_FLOAT64 * pValues, const size_t & size,
+                        const C_FLOAT64 & mean = 0.0,
+                        const C_FLOAT64 & sd = 1.0);
+
+  /**
+   * Fill the buffer with Poisson distributed random numbers where the mean
+   * of each value is given by the corresponding element of pMeans.
+   * Note: The values are computed by inversion for small means and by
+   * transformed rejection (PTRS) otherwise. The sequence therefore differs
+   * from the one produced by getRandomPoisson().
+   * @param C_FLOAT64 * pValues
+   * @param const C_FLOAT64 * pMeans
+   * @param const size_t & size
+   */
+  void fillRandomPoisson(C_FLOAT64 * pValues, const C_FLOAT64 * pMeans,
+                         const size_t & size);
+
+  /**
+   * Fill the buffer with Poisson distributed random numbers with Mean=mean.
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   * @param const C_FLOAT64 & mean
+   */
+  void fillRandomPoisson(C_FLOAT64 * pValues, const size_t & size,
+                         const C_FLOAT64 & mean);
+
+  /**
+   * Fill the buffer with Binomial distributed random numbers.
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   * @param const unsigned C_INT32 & trials
+   * @param const C_FLOAT64 & probability
+   */
+  void fillRandomBinomial(C_FLOAT64 * pValues, const size_t & size,
+                          const unsigned C_INT32 & trials,
+                          const C_FLOAT64 & probability);
+
 protected:
 
   /**
@@ -263,9 +362,22 @@ protected:
       */
 
   void setModulus(const unsigned C_INT32 & modulus);
+
+  /**
+   * Fill the buffer with (fillRandomU() + shift) * scale. Generators whose
+   * uniform floating point numbers are computed this way use it to
+   * implement fillRandomCC, fillRandomCO, and fillRandomOO.
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   * @param const C_FLOAT64 & shift
+   * @param const C_FLOAT64 & scale
+   */
+  void fillUniform(C_FLOAT64 * pValues, const size_t & size,
+                   const C_FLOAT64 & shift, const C_FLOAT64 & scale);
 };
 
 #include "Cr250.h"
 #include "Cmt19937.h"
+#include "Cphilox4x32.h"
 
 #endif // COPASI_CRandom
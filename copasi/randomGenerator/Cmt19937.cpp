@@ -237,6 +237,41 @@ C_FLOAT64 Cmt19937::getRandomOO()
   /* divided by 2^32 */
 }
 
+void Cmt19937::fillRandomU(unsigned C_INT32 * pValues, const size_t & size)
+{
+  unsigned C_INT32 * pValue = pValues;
+  unsigned C_INT32 * pValueEnd = pValues + size;
+  unsigned C_INT32 y;
+
+  for (; pValue != pValueEnd; ++pValue)
+    {
+      if (--mLeft == 0)
+        next_state();
+
+      y = *mNext++;
+
+      /* Tempering */
+      y ^= (y >> 11);
+      y ^= (y << 7) & 0x9d2c5680UL;
+      y ^= (y << 15) & 0xefc60000UL;
+      y ^= (y >> 18);
+
+      *pValue = y;
+    }
+
+  if (size > 0)
+    mNumberU = pValueEnd[-1];
+}
+
+void Cmt19937::fillRandomCC(C_FLOAT64 * pValues, const size_t & size)
+{fillUniform(pValues, size, 0.0, 1.0 / 4294967295.0);}
+
+void Cmt19937::fillRandomCO(C_FLOAT64 * pValues, const size_t & size)
+{fillUniform(pValues, size, 0.0, 1.0 / 4294967296.0);}
+
+void Cmt19937::fillRandomOO(C_FLOAT64 * pValues, const size_t & size)
+{fillUniform(pValues, size, 0.5, 1.0 / 4294967296.0);}
+
 /* generates a random number on [0,1) with 53-bit resolution*/
 C_FLOAT64 Cmt19937::genrand_res53()
 {
@@ -272,6 +307,17 @@ C_FLOAT64 Cmt19937HR::getRandomOO()
 
 /* These real versions are due to Isaku Wada, 2002/01/09 added */
 
+// The high resolution numbers combine two integers, i.e., we must not use
+// the conversion of Cmt19937.
+void Cmt19937HR::fillRandomCC(C_FLOAT64 * pValues, const size_t & size)
+{CRandom::fillRandomCC(pValues, size);}
+
+void Cmt19937HR::fillRandomCO(C_FLOAT64 * pValues, const size_t & size)
+{CRandom::fillRandomCO(pValues, size);}
+
+void Cmt19937HR::fillRandomOO(C_FLOAT64 * pValues, const size_t & size)
+{CRandom::fillRandomOO(pValues, size);}
+
 #ifdef XXXX
 int main()
 {
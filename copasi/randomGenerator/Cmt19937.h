@@ -132,6 +132,34 @@ class Cmt19937 : public CRandom
      */
     C_FLOAT64 getRandomOO();
 
+    /**
+     * Fill the buffer with random numbers in 0 <= n <= Modulus
+     * @param unsigned C_INT32 * pValues
+     * @param const size_t & size
+     */
+    void fillRandomU(unsigned C_INT32 * pValues, const size_t & size);
+
+    /**
+     * Fill the buffer with uniformly distributed random numbers in 0 <= x <= 1.
+     * @param C_FLOAT64 * pValues
+     * @param const size_t & size
+     */
+    void fillRandomCC(C_FLOAT64 * pValues, const size_t & size);
+
+    /**
+     * Fill the buffer with uniformly distributed random numbers in 0 <= x < 1.
+     * @param C_FLOAT64 * pValues
+     * @param const size_t & size
+     */
+    void fillRandomCO(C_FLOAT64 * pValues, const size_t & size);
+
+    /**
+     * Fill the buffer with uniformly distributed random numbers in 0 < x < 1.
+     * @param C_FLOAT64 * pValues
+     * @param const size_t & size
+     */
+    void fillRandomOO(C_FLOAT64 * pValues, const size_t & size);
+
     void init_by_array(unsigned C_INT32 init_key[],
                        C_INT32 key_length);
 
@@ -171,6 +199,27 @@ class Cmt19937HR : public Cmt19937
      * @return C_FLOAT64 random
      */
     C_FLOAT64 getRandomOO();
+
+    /**
+     * Fill the buffer with uniformly distributed random numbers in 0 <= x <= 1.
+     * @param C_FLOAT64 * pValues
+     * @param const size_t & size
+     */
+    void fillRandomCC(C_FLOAT64 * pValues, const size_t & size);
+
+    /**
+     * Fill the buffer with uniformly distributed random numbers in 0 <= x < 1.
+     * @param C_FLOAT64 * pValues
+     * @param const size_t & size
+     */
+    void fillRandomCO(C_FLOAT64 * pValues, const size_t & size);
+
+    /**
+     * Fill the buffer with uniformly distributed random numbers in 0 < x < 1.
+     * @param C_FLOAT64 * pValues
+     * @param const size_t & size
+     */
+    void fillRandomOO(C_FLOAT64 * pValues, const size_t & size);
   };
 
 #endif // COPASI_Cmt19937
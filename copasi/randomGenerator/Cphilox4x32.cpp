@@ -0,0 +1,170 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include <string.h>
+#include <algorithm>
+
+#include "copasi.h"
+#include "CRandom.h"
+
+/* Multipliers and Weyl constants of Philox4x32 */
+#define Cphilox4x32_M0 0xD2511F53UL
+#define Cphilox4x32_M1 0xCD9E8D57UL
+#define Cphilox4x32_W0 0x9E3779B9UL
+#define Cphilox4x32_W1 0xBB67AE85UL
+#define Cphilox4x32_ROUNDS 10
+
+/* The number of blocks computed together; the lanes are independent and vectorized by the compiler. */
+#define Cphilox4x32_LANES 8
+
+Cphilox4x32::Cphilox4x32(unsigned C_INT32 seed):
+  CRandom(),
+  mUsed(4)
+{
+  setModulus(0xffffffffUL);
+
+  mKey[1] = 0;
+  initialize(seed);
+}
+
+Cphilox4x32::~Cphilox4x32() {}
+
+void Cphilox4x32::initialize(unsigned C_INT32 seed)
+{
+  mKey[0] = seed;
+  memset(mCounter, 0, sizeof(mCounter));
+  mUsed = 4;
+}
+
+void Cphilox4x32::setStream(const unsigned C_INT32 & stream)
+{
+  mKey[1] = stream;
+  memset(mCounter, 0, sizeof(mCounter));
+  mUsed = 4;
+}
+
+const unsigned C_INT32 & Cphilox4x32::getStream() const
+{
+  return mKey[1];
+}
+
+void Cphilox4x32::jumpAhead(const unsigned C_INT64 & blocks)
+{
+  unsigned C_INT64 Low = ((unsigned C_INT64) mCounter[1] << 32 | mCounter[0]) + blocks;
+
+  // Carry into the upper 64 bit of the counter
+  if (Low < blocks && ++mCounter[2] == 0)
+    ++mCounter[3];
+
+  mCounter[0] = (unsigned C_INT32)(Low & 0xffffffffUL);
+  mCounter[1] = (unsigned C_INT32)(Low >> 32);
+
+  mUsed = 4;
+}
+
+void Cphilox4x32::generateBlocks(unsigned C_INT32 * pValues, const size_t & blocks)
+{
+  // The rounds are always computed for all lanes so that the loops can be
+  // vectorized. Unused lanes must therefore be initialized.
+  unsigned C_INT32 C0[Cphilox4x32_LANES] = {0};
+  unsigned C_INT32 C1[Cphilox4x32_LANES] = {0};
+  unsigned C_INT32 C2[Cphilox4x32_LANES] = {0};
+  unsigned C_INT32 C3[Cphilox4x32_LANES] = {0};
+  size_t Block = 0;
+
+  while (Block < blocks)
+    {
+      size_t Lanes = std::min< size_t >(Cphilox4x32_LANES, blocks - Block);
+      size_t j;
+
+      for (j = 0; j < Lanes; ++j)
+        {
+          C0[j] = mCounter[0];
+          C1[j] = mCounter[1];
+          C2[j] = mCounter[2];
+          C3[j] = mCounter[3];
+
+          // 128-bit increment
+          if (++mCounter[0] == 0 && ++mCounter[1] == 0 && ++mCounter[2] == 0)
+            ++mCounter[3];
+        }
+
+      unsigned C_INT32 K0 = mKey[0];
+      unsigned C_INT32 K1 = mKey[1];
+
+      for (size_t Round = 0; Round < Cphilox4x32_ROUNDS; ++Round)
+        {
+          for (j = 0; j < Cphilox4x32_LANES; ++j)
+            {
+              unsigned C_INT64 P0 = (unsigned C_INT64) Cphilox4x32_M0 * C0[j];
+              unsigned C_INT64 P1 = (unsigned C_INT64) Cphilox4x32_M1 * C2[j];
+
+              unsigned C_INT32 Hi0 = (unsigned C_INT32)(P0 >> 32);
+              unsigned C_INT32 Lo0 = (unsigned C_INT32) P0;
+              unsigned C_INT32 Hi1 = (unsigned C_INT32)(P1 >> 32);
+              unsigned C_INT32 Lo1 = (unsigned C_INT32) P1;
+
+              C0[j] = Hi1 ^ C1[j] ^ K0;
+              C1[j] = Lo1;
+              C2[j] = Hi0 ^ C3[j] ^ K1;
+              C3[j] = Lo0;
+            }
+
+          K0 += Cphilox4x32_W0;
+          K1 += Cphilox4x32_W1;
+        }
+
+      for (j = 0; j < Lanes; ++j, pValues += 4)
+        {
+          pValues[0] = C0[j];
+          pValues[1] = C1[j];
+          pValues[2] = C2[j];
+          pValues[3] = C3[j];
+        }
+
+      Block += Lanes;
+    }
+}
+
+unsigned C_INT32 Cphilox4x32::getRandomU()
+{
+  if (mUsed == 4)
+    {
+      generateBlocks(mBlock, 1);
+      mUsed = 0;
+    }
+
+  return mNumberU = mBlock[mUsed++];
+}
+
+void Cphilox4x32::fillRandomU(unsigned C_INT32 * pValues, const size_t & size)
+{
+  unsigned C_INT32 * pValue = pValues;
+  unsigned C_INT32 * pValueEnd = pValues + size;
+
+  // Use what is left of the current block so that the sequence does not
+  // depend on how the numbers are requested.
+  while (mUsed < 4 && pValue != pValueEnd)
+    *pValue++ = mBlock[mUsed++];
+
+  size_t Blocks = (pValueEnd - pValue) / 4;
+  generateBlocks(pValue, Blocks);
+  pValue += 4 * Blocks;
+
+  while (pValue != pValueEnd)
+    *pValue++ = getRandomU();
+
+  if (size > 0)
+    mNumberU = pValueEnd[-1];
+}
+
+void Cphilox4x32::fillRandomCC(C_FLOAT64 * pValues, const size_t & size)
+{fillUniform(pValues, size, 0.0, mModulusInv);}
+
+void Cphilox4x32::fillRandomCO(C_FLOAT64 * pValues, const size_t & size)
+{fillUniform(pValues, size, 0.0, mModulusInv1);}
+
+void Cphilox4x32::fillRandomOO(C_FLOAT64 * pValues, const size_t & size)
+{fillUniform(pValues, size, 0.5, mModulusInv1);}
@@ -0,0 +1,135 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+/**
+ * Cphilox4x32 class implementing the counter based Philox4x32-10 random number
+ * generator described in:
+ * J. K. Salmon, M. A. Moraes, R. O. Dror, and D. E. Shaw,
+ * "Parallel Random Numbers: As Easy as 1, 2, 3", SC11 (2011)
+ *
+ * Each block of 4 random numbers is a bijection of a 128-bit counter and a
+ * 64-bit key. The key is formed by the seed and a stream number, i.e., workers
+ * using the same seed but different streams obtain independent sequences.
+ * Since the state is the counter any position in the sequence can be reached
+ * in constant time with jumpAhead().
+ */
+
+#ifndef COPASI_Cphilox4x32
+#define COPASI_Cphilox4x32
+
+class Cphilox4x32 : public CRandom
+{
+  friend CRandom * CRandom::createGenerator(CRandom::Type type,
+      unsigned C_INT32 seed);
+
+  // Attributes
+private:
+  /**
+   * The key consisting of the seed and the stream
+   */
+  unsigned C_INT32 mKey[2];
+
+  /**
+   * The 128-bit counter of the next block
+   */
+  unsigned C_INT32 mCounter[4];
+
+  /**
+   * The current block
+   */
+  unsigned C_INT32 mBlock[4];
+
+  /**
+   * The number of values of the current block already used
+   */
+  size_t mUsed;
+
+  // Operations
+protected:
+  /**
+   * Default/Named constructor.
+   * Seeds the random number generator with the given seed.
+   * @param C_INT32 seed
+   */
+  Cphilox4x32(unsigned C_INT32 seed);
+
+  /**
+   * Compute the blocks for the given number of consecutive counters starting
+   * at mCounter and advance the counter.
+   * @param unsigned C_INT32 * pValues (size: 4 * blocks)
+   * @param const size_t & blocks
+   */
+  void generateBlocks(unsigned C_INT32 * pValues, const size_t & blocks);
+
+public:
+  /**
+   * The destructor.
+   */
+  ~Cphilox4x32();
+
+  /**
+   * Initialize or reinitialize the random number generator with
+   * the given seed. The stream is not changed and the counter is reset.
+   * @param unsigned C_INT32 seed (default system seed)
+   */
+  void initialize(unsigned C_INT32 seed = CRandom::getSystemSeed());
+
+  /**
+   * Select the stream of the generator and reset the counter. Generators with
+   * the same seed but different streams produce independent sequences
+   * which is suitable for parallel workers.
+   * @param const unsigned C_INT32 & stream
+   */
+  void setStream(const unsigned C_INT32 & stream);
+
+  /**
+   * Retrieve the stream of the generator
+   * @return const unsigned C_INT32 & stream
+   */
+  const unsigned C_INT32 & getStream() const;
+
+  /**
+   * Skip the given number of blocks of 4 random numbers. Values remaining
+   * from the current block are discarded.
+   * @param const unsigned C_INT64 & blocks
+   */
+  void jumpAhead(const unsigned C_INT64 & blocks);
+
+  /**
+   * Get a random number in 0 <= n <= Modulus
+   * @return unsigned C_INT32 random
+   */
+  unsigned C_INT32 getRandomU();
+
+  /**
+   * Fill the buffer with random numbers in 0 <= n <= Modulus
+   * @param unsigned C_INT32 * pValues
+   * @param const size_t & size
+   */
+  void fillRandomU(unsigned C_INT32 * pValues, const size_t & size);
+
+  /**
+   * Fill the buffer with uniformly distributed random numbers in 0 <= x <= 1.
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   */
+  void fillRandomCC(C_FLOAT64 * pValues, const size_t & size);
+
+  /**
+   * Fill the buffer with uniformly distributed random numbers in 0 <= x < 1.
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   */
+  void fillRandomCO(C_FLOAT64 * pValues, const size_t & size);
+
+  /**
+   * Fill the buffer with uniformly distributed random numbers in 0 < x < 1.
+   * @param C_FLOAT64 * pValues
+   * @param const size_t & size
+   */
+  void fillRandomOO(C_FLOAT64 * pValues, const size_t & size);
+};
+
+#endif // COPASI_Cphilox4x32
@@ -32,6 +32,10 @@
 #include "copasi/utilities/utility.h"
 #include "copasi/commandline/CLocaleString.h"
 
+#ifdef COPASI_ASYNC_REPORT
+# include "CReportWriter.h"
+#endif // COPASI_ASYNC_REPORT
+
 //////////////////////////////////////////////////
 //
 //class CReport
@@ -52,7 +56,9 @@ CReport::CReport():
   mpHeader(NULL),
   mpBody(NULL),
   mpFooter(NULL),
-  mState(Invalid)
+  mState(Invalid),
+  mpWriter(NULL),
+  mAsynchronous(true)
 {}
 
 CReport::CReport(const CReport & src):
@@ -70,7 +76,9 @@ CReport::CReport(const CReport & src):
   mpHeader(src.mpHeader),
   mpBody(src.mpBody),
   mpFooter(src.mpFooter),
-  mState(Invalid)
+  mState(Invalid),
+  mpWriter(NULL),
+  mAsynchronous(src.mAsynchronous)
 {}
 
 CReport::~CReport()
@@ -110,6 +118,18 @@ const bool & CReport::confirmOverwrite() const
 void CReport::setConfirmOverwrite(const bool & confirmOverwrite)
 {mConfirmOverwrite = confirmOverwrite;}
 
+void CReport::setAsynchronous(const bool & asynchronous)
+{mAsynchronous = asynchronous;}
+
+bool CReport::isAsynchronous() const
+{
+#ifdef COPASI_ASYNC_REPORT
+  return mAsynchronous;
+#else
+  return false;
+#endif // COPASI_ASYNC_REPORT
+}
+
 void CReport::output(const Activity & activity)
 {
   switch (activity)
@@ -132,6 +152,8 @@ void CReport::separate(const Activity & /* activity */)
 {
   if (!mpOstream) return;
 
+  drainWriter();
+
   (*mpOstream) << std::endl;
 }
 
@@ -145,11 +167,17 @@ void CReport::finish()
   pdelete(mpBody);
   pdelete(mpFooter);
 
+  stopWriter();
+
+  if (mpOstream) mpOstream->flush();
+
   mState = Invalid;
 }
 
 void CReport::close()
 {
+  stopWriter();
+
   if (mStreamOwner) pdelete(mpOstream);
 
   mpOstream = NULL;
@@ -160,6 +188,8 @@ void CReport::printHeader()
 {
   if (!mpOstream) return;
 
+  drainWriter();
+
   if (mpHeader)
     switch (mState)
       {
@@ -238,6 +268,27 @@ void CReport::printBody()
 
   if (mState == BodyFooter) return;
 
+#ifdef COPASI_ASYNC_REPORT
+
+  // The writer is created when the first row of the body is printed.
+  if (mState != BodyBody)
+    {
+      stopWriter();
+
+      if (mAsynchronous)
+        mpWriter = CReportWriter::create(mpOstream, mBodyObjectList);
+    }
+
+  mState = BodyBody;
+
+  if (mpWriter != NULL)
+    {
+      mpWriter->push();
+      return;
+    }
+
+#endif // COPASI_ASYNC_REPORT
+
   mState = BodyBody;
 
   std::vector< CObjectInterface * >::iterator it = mBodyObjectList.begin();
@@ -257,9 +308,12 @@ void CReport::printFooter()
 {
   if (!mpOstream) return;
 
+  drainWriter();
+
   // Close the body part
   if (mState < BodyFooter)
     {
+      stopWriter();
       mState = BodyFooter;
 
       if (mpBody) mpBody->printFooter();
@@ -302,6 +356,29 @@ void CReport::printFooter()
   (*mpOstream) << std::endl;
 }
 
+void CReport::drainWriter()
+{
+#ifdef COPASI_ASYNC_REPORT
+
+  if (mpWriter != NULL) mpWriter->drain();
+
+#endif // COPASI_ASYNC_REPORT
+
+  // Child reports write to the same stream.
+  if (mpHeader) mpHeader->drainWriter();
+
+  if (mpBody) mpBody->drainWriter();
+
+  if (mpFooter) mpFooter->drainWriter();
+}
+
+void CReport::stopWriter()
+{
+#ifdef COPASI_ASYNC_REPORT
+  pdelete(mpWriter);
+#endif // COPASI_ASYNC_REPORT
+}
+
 // Compile the List of Report Objects;
 // Support Parellel
 
@@ -313,6 +390,8 @@ bool CReport::compile(CObjectInterface::ContainerList listOfContainer)
   // check if there is a Report Definition Defined
   if (!mpReportDef) return false;
 
+  setOutputInterval(mpReportDef->getOutputInterval());
+
   if (mpReportDef->isTable())
     if (!const_cast< CReportDefinition * >(mpReportDef)->preCompileTable(listOfContainer)) success = false;
 
@@ -423,6 +502,7 @@ void CReport::generateObjectsFromName(const CObjectInterface::ContainerList & li
         {
           pReport = new CReport();
           pReport->setReportDefinition(pReportDefinition);
+          pReport->setAsynchronous(mAsynchronous);
 
           return;
         }
@@ -39,6 +39,7 @@
 
 class CReportDefinition;
 class CReportTable;
+class CReportWriter;
 
 class CReport : public COutputInterface
 {
@@ -80,6 +81,18 @@ private:
 
   State mState;
 
+  /**
+   * The writer formatting the body rows in a separate thread (NULL if the body
+   * is written synchronously)
+   */
+  CReportWriter * mpWriter;
+
+  /**
+   * Indicates whether the body rows are written in a separate thread if
+   * supported
+   */
+  bool mAsynchronous;
+
 public:
   /**
    * Default constructor.
@@ -196,6 +209,20 @@ public:
    */
   void setConfirmOverwrite(const bool & confirmOverwrite);
 
+  /**
+   * Set whether the body rows are written in a separate thread. This is only
+   * supported if COPASI is built with COPASI_ASYNC_REPORT, where it is the
+   * default.
+   * @param const bool & asynchronous
+   */
+  void setAsynchronous(const bool & asynchronous);
+
+  /**
+   * Check whether the body rows are written in a separate thread
+   * @return bool asynchronous
+   */
+  bool isAsynchronous() const;
+
 private:
   /**
    * to print header
@@ -212,6 +239,17 @@ private:
    */
   void printFooter();
 
+  /**
+   * Wait until the writer has written all body rows. This must be called before
+   * anything else is written to the stream.
+   */
+  void drainWriter();
+
+  /**
+   * Write all body rows and stop the writer
+   */
+  void stopWriter();
+
   /**
    * transfer every individual object list from name vector
    */
@@ -57,6 +57,7 @@ CData CReportDefinition::toData() const
   Data.addProperty(CData::REPORT_IS_TABLE, mTable);
   Data.addProperty(CData::REPORT_SHOW_TITLE, mbTitle);
   Data.addProperty(CData::REPORT_PRECISION, mPrecision);
+  Data.addProperty(CData::REPORT_OUTPUT_INTERVAL, mOutputInterval);
 
   return Data;
 }
@@ -100,7 +101,8 @@ CReportDefinition::CReportDefinition(const std::string & name,
   mSeparator("\t"),
   mTable(true),
   mbTitle(true),
-  mPrecision(6)
+  mPrecision(6),
+  mOutputInterval(0.0)
 {}
 
 CReportDefinition::CReportDefinition(const CReportDefinition & src,
@@ -113,6 +115,7 @@ CReportDefinition::CReportDefinition(const CReportDefinition & src,
   mTable(src.mTable),
   mbTitle(src.mbTitle),
   mPrecision(src.mPrecision),
+  mOutputInterval(src.mOutputInterval),
   mHeaderVector(src.mHeaderVector),
   mBodyVector(src.mBodyVector),
   mFooterVector(src.mFooterVector),
@@ -232,6 +235,12 @@ void CReportDefinition::setPrecision(const unsigned C_INT32 & precision)
 const unsigned C_INT32 & CReportDefinition::getPrecision() const
 {return mPrecision;}
 
+void CReportDefinition::setOutputInterval(const C_FLOAT64 & outputInterval)
+{mOutputInterval = outputInterval;}
+
+const C_FLOAT64 & CReportDefinition::getOutputInterval() const
+{return mOutputInterval;}
+
 const std::string & CReportDefinition::getKey() const
 {return mKey;}
 
@@ -61,6 +61,7 @@ private:
   bool mTable;
   bool mbTitle;
   unsigned C_INT32 mPrecision;
+  C_FLOAT64 mOutputInterval;
 
 protected:
   CReportDefinition(const CReportDefinition & src);
@@ -232,6 +233,20 @@ public:
    */
   const unsigned C_INT32 & getPrecision() const;
 
+  /**
+   * Set the minimal interval of simulated time between two body rows written
+   * during a task. A row is written for every step if the interval is not
+   * positive, which is the default.
+   * @param const C_FLOAT64 & outputInterval
+   */
+  void setOutputInterval(const C_FLOAT64 & outputInterval);
+
+  /**
+   * Retrieve the minimal interval of simulated time between two body rows
+   * @return const C_FLOAT64 & outputInterval
+   */
+  const C_FLOAT64 & getOutputInterval() const;
+
   /**
    *
    */
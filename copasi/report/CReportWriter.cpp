@@ -0,0 +1,190 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#include "copasi/copasi.h"
+
+#ifdef COPASI_ASYNC_REPORT
+
+#include <algorithm>
+
+#include "CReportWriter.h"
+
+#include "copasi/core/CDataObject.h"
+#include "copasi/core/CDataString.h"
+#include "copasi/math/CMathObject.h"
+
+// static
+CReportWriter * CReportWriter::create(std::ostream * pOstream,
+                                      const std::vector< CObjectInterface * > & objects,
+                                      const size_t & capacity)
+{
+  if (pOstream == NULL || objects.empty() || capacity == 0)
+    return NULL;
+
+  std::vector< std::string > Text(1);
+  std::vector< const C_FLOAT64 * > Values;
+
+  std::vector< CObjectInterface * >::const_iterator it = objects.begin();
+  std::vector< CObjectInterface * >::const_iterator end = objects.end();
+
+  for (; it != end; ++it)
+    {
+      const CDataObject * pDataObject = dynamic_cast< const CDataObject * >(*it);
+      const CDataString * pString = dynamic_cast< const CDataString * >(*it);
+
+      if (pString != NULL)
+        {
+          Text.back() += pString->getStaticString();
+        }
+      else if (dynamic_cast< const CMathObject * >(*it) != NULL ||
+               (pDataObject != NULL && pDataObject->hasFlag(CDataObject::ValueDbl)))
+        {
+          Values.push_back((const C_FLOAT64 *)(*it)->getValuePointer());
+          Text.push_back(std::string());
+        }
+      else
+        {
+          return NULL;
+        }
+    }
+
+  // A row without values does not benefit from the writer.
+  if (Values.empty() || std::find(Values.begin(), Values.end(), (const C_FLOAT64 *) NULL) != Values.end())
+    return NULL;
+
+  CReportWriter * pWriter = new CReportWriter(pOstream, capacity);
+  pWriter->mText.swap(Text);
+  pWriter->mValues.swap(Values);
+  pWriter->mRing.resize(pWriter->mCapacity * pWriter->mValues.size());
+  pWriter->mThread = std::thread(&CReportWriter::run, pWriter);
+
+  return pWriter;
+}
+
+CReportWriter::CReportWriter(std::ostream * pOstream, const size_t & capacity):
+  mpOstream(pOstream),
+  mText(),
+  mValues(),
+  mCapacity(capacity),
+  mRing(),
+  mHead(0),
+  mTail(0),
+  mStop(false),
+  mWriterWaiting(false),
+  mProducerWaiting(false),
+  mMutex(),
+  mRowsPushed(),
+  mRowsWritten(),
+  mThread()
+{}
+
+CReportWriter::~CReportWriter()
+{
+  {
+    std::lock_guard< std::mutex > Lock(mMutex);
+    mStop.store(true);
+  }
+
+  mRowsPushed.notify_one();
+
+  if (mThread.joinable())
+    mThread.join();
+
+  mpOstream->flush();
+}
+
+void CReportWriter::push()
+{
+  size_t Head = mHead.load(std::memory_order_relaxed);
+
+  // Back pressure: wait until the writer has made room.
+  if (Head - mTail.load(std::memory_order_acquire) >= mCapacity)
+    {
+      std::unique_lock< std::mutex > Lock(mMutex);
+      mProducerWaiting.store(true);
+      mRowsWritten.wait(Lock, [this, Head]() {return Head - mTail.load() < mCapacity;});
+      mProducerWaiting.store(false);
+    }
+
+  C_FLOAT64 * pRow = mRing.data() + (Head % mCapacity) * mValues.size();
+  std::vector< const C_FLOAT64 * >::const_iterator it = mValues.begin();
+  std::vector< const C_FLOAT64 * >::const_iterator end = mValues.end();
+
+  for (; it != end; ++it, ++pRow)
+    *pRow = **it;
+
+  // The sequentially consistent store and load guarantee that either the
+  // writer sees the new row before it sleeps or we see that it sleeps.
+  mHead.store(Head + 1);
+
+  if (mWriterWaiting.load())
+    {
+      std::lock_guard< std::mutex > Lock(mMutex);
+      mRowsPushed.notify_one();
+    }
+}
+
+void CReportWriter::drain()
+{
+  if (mTail.load(std::memory_order_acquire) == mHead.load(std::memory_order_relaxed))
+    return;
+
+  std::unique_lock< std::mutex > Lock(mMutex);
+  mProducerWaiting.store(true);
+  mRowsWritten.wait(Lock, [this]() {return mTail.load() == mHead.load();});
+  mProducerWaiting.store(false);
+}
+
+void CReportWriter::run()
+{
+  while (true)
+    {
+      size_t Tail = mTail.load(std::memory_order_relaxed);
+
+      if (Tail != mHead.load(std::memory_order_acquire))
+        {
+          write(mRing.data() + (Tail % mCapacity) * mValues.size());
+
+          // Rows are flushed whenever the writer catches up, i.e., a live reader
+          // sees them without flushing each row. This must happen before the tail
+          // is updated since a drained stream belongs to the simulation thread.
+          if (Tail + 1 == mHead.load())
+            mpOstream->flush();
+
+          mTail.store(Tail + 1);
+
+          if (mProducerWaiting.load())
+            {
+              std::lock_guard< std::mutex > Lock(mMutex);
+              mRowsWritten.notify_one();
+            }
+
+          continue;
+        }
+
+      // All rows pushed before the stop request are written.
+      if (mStop.load())
+        break;
+
+      std::unique_lock< std::mutex > Lock(mMutex);
+      mWriterWaiting.store(true);
+      mRowsPushed.wait(Lock, [this, Tail]() {return mStop.load() || mHead.load() != Tail;});
+      mWriterWaiting.store(false);
+    }
+}
+
+void CReportWriter::write(const C_FLOAT64 * pRow)
+{
+  std::vector< std::string >::const_iterator itText = mText.begin();
+  const C_FLOAT64 * pRowEnd = pRow + mValues.size();
+
+  for (; pRow != pRowEnd; ++pRow, ++itText)
+    (*mpOstream) << *itText << *pRow;
+
+  // Rows are not flushed individually, see run().
+  (*mpOstream) << *itText << '\n';
+}
+
+#endif // COPASI_ASYNC_REPORT
@@ -0,0 +1,154 @@
+// Copyright (C) 2018 by Pedro Mendes, Virginia Tech Intellectual
+// Properties, Inc., University of Heidelberg, and University of
+// of Connecticut School of Medicine.
+// All rights reserved.
+
+#ifndef COPASI_CReportWriter
+#define COPASI_CReportWriter
+
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "copasi/core/CObjectInterface.h"
+
+/**
+ * The class CReportWriter writes the body rows of a report in a separate
+ * thread. The simulation thread only copies the current values of the body
+ * objects into a single producer single consumer ring buffer. The writer
+ * thread formats the rows and writes them to the stream of the report.
+ *
+ * If the ring buffer is full the simulation thread waits until the writer has
+ * made room, i.e., no rows are ever dropped and the memory is bounded. Waiting
+ * threads sleep on a condition variable, which is only notified if the other
+ * thread actually waits. The writer flushes the stream whenever the ring buffer
+ * is empty, i.e., a live reader sees the rows with little delay.
+ */
+class CReportWriter
+{
+public:
+  /**
+   * Create a writer for the given body objects. Only objects with a floating
+   * point value and static strings are supported. For any other object NULL is
+   * returned and the report must be written synchronously.
+   * @param std::ostream * pOstream
+   * @param const std::vector< CObjectInterface * > & objects
+   * @param const size_t & capacity (default: 4096 rows)
+   * @return CReportWriter * pWriter
+   */
+  static CReportWriter * create(std::ostream * pOstream,
+                                const std::vector< CObjectInterface * > & objects,
+                                const size_t & capacity = 4096);
+
+  /**
+   * Destructor. All buffered rows are written and the writer thread is stopped.
+   */
+  ~CReportWriter();
+
+  /**
+   * Copy the current values of the body objects into the ring buffer. This
+   * waits if the buffer is full.
+   */
+  void push();
+
+  /**
+   * Wait until all buffered rows have been written to the stream. Afterwards the
+   * stream may be used by the calling thread until the next push.
+   */
+  void drain();
+
+private:
+  /**
+   * Constructor
+   * @param std::ostream * pOstream
+   * @param const size_t & capacity
+   */
+  CReportWriter(std::ostream * pOstream, const size_t & capacity);
+
+  /**
+   * The main loop of the writer thread
+   */
+  void run();
+
+  /**
+   * Format the buffered row and write it to the stream
+   * @param const C_FLOAT64 * pRow
+   */
+  void write(const C_FLOAT64 * pRow);
+
+  /**
+   * The stream of the report
+   */
+  std::ostream * mpOstream;
+
+  /**
+   * The static text preceding each value and the text at the end of the row
+   */
+  std::vector< std::string > mText;
+
+  /**
+   * Pointers to the values of the body objects
+   */
+  std::vector< const C_FLOAT64 * > mValues;
+
+  /**
+   * The maximal number of buffered rows
+   */
+  size_t mCapacity;
+
+  /**
+   * The ring buffer holding the values of the rows
+   */
+  std::vector< C_FLOAT64 > mRing;
+
+  /**
+   * The number of rows pushed
+   */
+  std::atomic< size_t > mHead;
+
+  /**
+   * The number of rows written
+   */
+  std::atomic< size_t > mTail;
+
+  /**
+   * Indicates that the writer thread must stop once all rows are written
+   */
+  std::atomic< bool > mStop;
+
+  /**
+   * Indicates that the writer thread waits for rows
+   */
+  std::atomic< bool > mWriterWaiting;
+
+  /**
+   * Indicates that the simulation thread waits for the writer
+   */
+  std::atomic< bool > mProducerWaiting;
+
+  /**
+   * The mutex protecting the waits
+   */
+  std::mutex mMutex;
+
+  /**
+   * Notified when rows are pushed or the writer must stop
+   */
+  std::condition_variable mRowsPushed;
+
+  /**
+   * Notified when rows are written
+   */
+  std::condition_variable mRowsWritten;
+
+  /**
+   * The writer thread
+   */
+  std::thread mThread;
+};
+
+#endif // COPASI_CReportWriter
@@ -910,6 +910,9 @@ SBMLImporter::finishCurrentStep()
 void
 SBMLImporter::finishImport()
 {
+  startImportPhase("");
+  invalidateSBMLIdIndex();
+
   if (mpProgressHandler == NULL)  return;
 
   finishCurrentStep();
@@ -922,6 +925,8 @@ SBMLImporter::createProgressStepOrStop(unsigned C_INT32 globalStep,
                                        unsigned C_INT32 currentTotal,
                                        const std::string& title)
 {
+  startImportPhase(title);
+
   if (mpProgressHandler == NULL) return false;
 
   if (mCurrentStepHandle != C_INVALID_INDEX)
@@ -1323,6 +1328,7 @@ CModel* SBMLImporter::createCModelFromSBMLDocument(SBMLDocument* sbmlDocument, s
                   // create a an ode rule for that reaction instead
                   std::string id = reaction->getId();
                   reaction->setId(std::string("unused_") + id);
+                  invalidateSBMLIdIndex();
                   Parameter* param = sbmlModel->createParameter();
                   param->setId(id);
                   param->setValue(0);
@@ -1643,6 +1649,7 @@ CModel* SBMLImporter::createCModelFromSBMLDocument(SBMLDocument* sbmlDocument, s
                   if (found != copasi2sbmlmap.end())
                     {
                       copasi2sbmlmap.erase(found);
+                      invalidateSBMLIdIndex();
                     }
                 }
 
@@ -2243,10 +2250,12 @@ CFunction* findFunction(CDataVectorN < CFunction > &  db, const CFunction* func)
  *
  * @param kLaw the kinetic law
  * @param pSBMLModel the model to search for conflicting reactions
+ * @param reactionIds the ids of all reactions in the model
  * @param prefix the prefix to use when modifying the id.
  */
 void renameShadowingFluxReferences(KineticLaw* kLaw,
                                    Model* pSBMLModel,
+                                   const std::set<std::string>& reactionIds,
                                    const std::string& prefix)
 {
   if (!kLaw->isSetMath()) return;
@@ -2266,6 +2275,10 @@ void renameShadowingFluxReferences(KineticLaw* kLaw,
       std::string currentId = current->getId();
       viableIds.insert(currentId);
 
+      // The lookup in the SBML model is linear, i.e., we check the known ids first.
+      if (reactionIds.find(currentId) == reactionIds.end())
+        continue;
+
       Reaction* other = pSBMLModel->getReaction(currentId);
 
       if (other == NULL)
@@ -2705,8 +2718,9 @@ SBMLImporter::createCReactionFromReaction(Reaction* sbmlReaction, Model* pSBMLMo
 
       // issue 2407: ensure that no reaction ids are shadowed
       // by local parameters
-      renameShadowingFluxReferences(kLaw, pSBMLModel,
+      renameShadowingFluxReferences(kLaw, pSBMLModel, mReactions,
                                     copasiReaction->getObjectName());
+      invalidateSBMLIdIndex();
 
       const ListOfParameters* pParamList = NULL;
 
@@ -3294,7 +3308,12 @@ SBMLImporter::SBMLImporter():
   mCompartmentMap(),
   mParameterFluxMap(),
   mChangedObjects(),
-  mUnitExpressions()
+  mUnitExpressions(),
+  mSBMLIdIndex(),
+  mpSBMLIdIndexMap(NULL),
+  mSBMLIdIndexSize(0),
+  mImportStatistics(),
+  mPhaseStart()
 {
   this->speciesMap = std::map<std::string, CMetab*>();
   this->functionDB = NULL;
@@ -3316,6 +3335,8 @@ SBMLImporter::SBMLImporter():
   this->mRateRuleForSpeciesReferenceIgnored = false;
   this->mEventAssignmentForSpeciesReferenceIgnored = false;
   this->mConversionFactorFound = false;
+  this->mImportStatistics.IdLookups = 0;
+  this->mImportStatistics.IdIndexBuilds = 0;
 
   this->mIgnoredSBMLMessages.insert(10501);
   this->mIgnoredSBMLMessages.insert(10512);
@@ -3668,6 +3689,12 @@ SBMLImporter::parseSBML(const std::string& sbmlDocumentText,
   this->functionDB = funDB;
   SBMLReader* reader = new SBMLReader();
 
+  mImportStatistics.PhaseTimes.clear();
+  mImportStatistics.IdLookups = 0;
+  mImportStatistics.IdIndexBuilds = 0;
+  invalidateSBMLIdIndex();
+  startImportPhase("Reading SBML file...");
+
   mGlobalStepCounter = 0;
 
   if (mpProgressHandler != NULL)
@@ -4755,12 +4782,14 @@ bool SBMLImporter::sbmlId2CopasiCN(ASTNode* pNode, std::map<const CDataObject*,
         }
       else
         {
-          std::map<const CDataObject*, SBase*>::iterator it = copasi2sbmlmap.begin();
-          std::map<const CDataObject*, SBase*>::iterator endIt = copasi2sbmlmap.end();
+          std::vector< CopasiToSBMLIterator > Candidates = findSBMLIdCandidates(name, copasi2sbmlmap);
+          std::vector< CopasiToSBMLIterator >::const_iterator itCandidate = Candidates.begin();
+          std::vector< CopasiToSBMLIterator >::const_iterator endCandidate = Candidates.end();
           bool found = false;
 
-          while (it != endIt)
+          while (itCandidate != endCandidate)
             {
+              std::map<const CDataObject*, SBase*>::const_iterator it = *itCandidate;
               int type = it->second->getTypeCode();
 
               switch (type)
@@ -4849,7 +4878,7 @@ bool SBMLImporter::sbmlId2CopasiCN(ASTNode* pNode, std::map<const CDataObject*,
                     break;
                 }
 
-              ++it;
+              ++itCandidate;
             }
 
           if (!found) success = false;
@@ -6327,6 +6356,122 @@ CProcessReport* SBMLImporter::getImportHandlerAddr() const
   return mpProgressHandler;
 }
 
+const SBMLImporter::sImportStatistics & SBMLImporter::getImportStatistics() const
+{
+  return mImportStatistics;
+}
+
+void SBMLImporter::startImportPhase(const std::string & title)
+{
+  CCopasiTimeVariable Now = CCopasiTimeVariable::getCurrentWallTime();
+
+  if (!mImportStatistics.PhaseTimes.empty())
+    {
+      mImportStatistics.PhaseTimes.back().second += (Now - mPhaseStart).getMicroSeconds() * 1e-6;
+    }
+
+  if (!title.empty())
+    {
+      mImportStatistics.PhaseTimes.push_back(std::make_pair(title, 0.0));
+    }
+
+  mPhaseStart = Now;
+}
+
+void SBMLImporter::getSBMLIds(const CopasiToSBMLIterator & it, std::string ids[3]) const
+{
+  ids[0] = it->second->getId();
+
+  // Level 1 elements are identified by their name
+  ids[1] = (mLevel == 1) ? it->second->getName() : "";
+
+  const CReaction * pReaction = dynamic_cast< const CReaction * >(it->first);
+  const CModelEntity * pModelEntity = dynamic_cast< const CModelEntity * >(it->first);
+
+  if (pReaction != NULL)
+    ids[2] = pReaction->getSBMLId();
+  else if (pModelEntity != NULL)
+    ids[2] = pModelEntity->getSBMLId();
+  else
+    ids[2] = "";
+}
+
+std::vector< SBMLImporter::CopasiToSBMLIterator >
+SBMLImporter::findSBMLIdCandidates(const std::string & id,
+                                   const std::map< const CDataObject *, SBase * > & copasi2sbmlmap)
+{
+  // Elements are only removed or renamed after calling invalidateSBMLIdIndex, i.e.,
+  // a change in size indicates that elements have been added.
+  if (mpSBMLIdIndexMap != &copasi2sbmlmap ||
+      mSBMLIdIndexSize != copasi2sbmlmap.size())
+    buildSBMLIdIndex(copasi2sbmlmap);
+
+  ++mImportStatistics.IdLookups;
+
+  std::unordered_map< std::string, std::vector< CopasiToSBMLIterator > >::const_iterator found = mSBMLIdIndex.find(id);
+
+  if (found == mSBMLIdIndex.end())
+    return std::vector< CopasiToSBMLIterator >();
+
+  // We verify that the candidates still have the id. Otherwise an element has been
+  // renamed without invalidating the index and we need to rebuild it.
+  std::vector< CopasiToSBMLIterator >::const_iterator it = found->second.begin();
+  std::vector< CopasiToSBMLIterator >::const_iterator end = found->second.end();
+  std::string Ids[3];
+
+  for (; it != end; ++it)
+    {
+      getSBMLIds(*it, Ids);
+
+      if (Ids[0] != id && Ids[1] != id && Ids[2] != id)
+        {
+          buildSBMLIdIndex(copasi2sbmlmap);
+          found = mSBMLIdIndex.find(id);
+
+          if (found == mSBMLIdIndex.end())
+            return std::vector< CopasiToSBMLIterator >();
+
+          break;
+        }
+    }
+
+  return found->second;
+}
+
+void SBMLImporter::buildSBMLIdIndex(const std::map< const CDataObject *, SBase * > & copasi2sbmlmap)
+{
+  mSBMLIdIndex.clear();
+  mpSBMLIdIndexMap = &copasi2sbmlmap;
+  mSBMLIdIndexSize = copasi2sbmlmap.size();
+  ++mImportStatistics.IdIndexBuilds;
+
+  CopasiToSBMLIterator it = copasi2sbmlmap.begin();
+  CopasiToSBMLIterator end = copasi2sbmlmap.end();
+  std::string Ids[3];
+
+  for (; it != end; ++it)
+    {
+      getSBMLIds(it, Ids);
+
+      for (size_t i = 0; i < 3; ++i)
+        {
+          if (Ids[i].empty()) continue;
+
+          std::vector< CopasiToSBMLIterator > & Candidates = mSBMLIdIndex[Ids[i]];
+
+          if (Candidates.empty() || Candidates.back() != it)
+            Candidates.push_back(it);
+        }
+    }
+}
+
+void SBMLImporter::invalidateSBMLIdIndex()
+{
+  mSBMLIdIndex.clear();
+  mpSBMLIdIndexMap = NULL;
+  mSBMLIdIndexSize = 0;
+}
+
 void SBMLImporter::clearCallBack()
 {
   setImportHandler(NULL);
@@ -6541,6 +6686,7 @@ bool SBMLImporter::removeUnusedFunctions(CFunctionDB* pTmpFunctionDB, std::map<c
           std::map<const CDataObject*, SBase*>::iterator pos = copasi2sbmlmap.find(pTree);
           assert(pos != copasi2sbmlmap.end());
           copasi2sbmlmap.erase(pos);
+          invalidateSBMLIdIndex();
         }
 
       ++mCurrentStepCounter;
@@ -6676,20 +6822,27 @@ void SBMLImporter::importRule(const Rule* rule, CModelEntity::Status ruleType, s
       // So we treat this the same way as the stoichiometryMath in SBML level 2
 
       // find the chemical equation element
-      std::map<const CDataObject*, SBase*>::const_iterator it = copasi2sbmlmap.begin(), endit = copasi2sbmlmap.end();
+      std::vector< CopasiToSBMLIterator > Candidates = findSBMLIdCandidates(sbmlId, copasi2sbmlmap);
+      std::vector< CopasiToSBMLIterator >::const_iterator itCandidate = Candidates.begin();
+      std::vector< CopasiToSBMLIterator >::const_iterator endCandidate = Candidates.end();
 
-      while (it != endit)
+      while (itCandidate != endCandidate)
         {
-          if (it->second->getId() == sbmlId)
+          if ((*itCandidate)->second->getId() == sbmlId)
             {
               break;
             }
 
-          ++it;
+          ++itCandidate;
         }
 
-      assert(it != endit);
-      const CChemEqElement* pChemEqElement = dynamic_cast<const CChemEqElement*>(it->first);
+      assert(itCandidate != endCandidate);
+      const CChemEqElement* pChemEqElement = NULL;
+
+      if (itCandidate != endCandidate)
+        {
+          pChemEqElement = dynamic_cast<const CChemEqElement*>((*itCandidate)->first);
+        }
 
       if (this->mLevel > 2 &&  pChemEqElement != NULL && rule->getMath() != NULL)
         {
@@ -6710,11 +6863,14 @@ void SBMLImporter::importRule(const Rule* rule, CModelEntity::Status ruleType, s
   Species* pS;
   Parameter* pP;
   const CDataObject* pObject = NULL;
-  std::map<const CDataObject*, SBase*>::iterator it = copasi2sbmlmap.begin();
-  std::map<const CDataObject*, SBase*>::iterator endit = copasi2sbmlmap.end();
+  std::vector< CopasiToSBMLIterator > Candidates = findSBMLIdCandidates(sbmlId, copasi2sbmlmap);
+  std::vector< CopasiToSBMLIterator >::const_iterator itCandidate = Candidates.begin();
+  std::vector< CopasiToSBMLIterator >::const_iterator endCandidate = Candidates.end();
 
-  while (it != endit)
+  while (itCandidate != endCandidate)
     {
+      std::map<const CDataObject*, SBase*>::const_iterator it = *itCandidate;
+
       switch (it->second->getTypeCode())
         {
           case SBML_COMPARTMENT:
@@ -6828,7 +6984,7 @@ void SBMLImporter::importRule(const Rule* rule, CModelEntity::Status ruleType, s
 
       if (found) break;
 
-      ++it;
+      ++itCandidate;
     }
 
   if (found)
@@ -7186,8 +7342,9 @@ void SBMLImporter::replaceObjectNames(ASTNode* pNode, const std::map<const CData
               bool haveData = itNode->getUserData() != NULL;
               // the id can either belong to a compartment, a species, a reaction or a
               // global parameter
-              std::map<const CDataObject*, SBase*>::const_iterator it = copasi2sbmlmap.begin();
-              std::map<const CDataObject*, SBase*>::const_iterator endit = copasi2sbmlmap.end();
+              std::vector< CopasiToSBMLIterator > Candidates = findSBMLIdCandidates(name, copasi2sbmlmap);
+              std::vector< CopasiToSBMLIterator >::const_iterator itCandidate = Candidates.begin();
+              std::vector< CopasiToSBMLIterator >::const_iterator endCandidate = Candidates.end();
               const CReaction* pReaction;
               const CModelEntity* pModelEntity;
 
@@ -7209,8 +7366,9 @@ void SBMLImporter::replaceObjectNames(ASTNode* pNode, const std::map<const CData
                   continue;
                 }
 
-              while (it != endit)
+              while (itCandidate != endCandidate)
                 {
+                  std::map<const CDataObject*, SBase*>::const_iterator it = *itCandidate;
                   const CDataObject* pObject = it->first;
                   pReaction = dynamic_cast<const CReaction*>(pObject);
                   pModelEntity = dynamic_cast<const CModelEntity*>(pObject);
@@ -7318,11 +7476,11 @@ void SBMLImporter::replaceObjectNames(ASTNode* pNode, const std::map<const CData
                       break;
                     }
 
-                  ++it;
+                  ++itCandidate;
                 }
 
               // not found
-              if (it == endit)
+              if (itCandidate == endCandidate)
                 {
                   CCopasiMessage(CCopasiMessage::EXCEPTION, MCSBML + 74, name.c_str());
                 }
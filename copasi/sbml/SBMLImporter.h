@@ -24,11 +24,14 @@
 #include <map>
 #include <set>
 #include <utility>
+#include <vector>
+#include <unordered_map>
 #include "sbml/math/ASTNode.h"
 
 #include "copasi/function/CFunctionDB.h"
 #include "copasi/sbml/StdException.h"
 #include "copasi/model/CModel.h"
+#include "copasi/utilities/CopasiTime.h"
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 class SBMLDocument;
@@ -52,7 +55,31 @@ class CListOfLayouts;
 
 class SBMLImporter
 {
+public:
+  /**
+   * Statistics collected during the last import
+   */
+  struct sImportStatistics
+  {
+    /**
+     * The wall clock time in seconds spent in each import phase
+     */
+    std::vector< std::pair< std::string, C_FLOAT64 > > PhaseTimes;
+
+    /**
+     * The number of SBML id lookups in the COPASI to SBML map
+     */
+    size_t IdLookups;
+
+    /**
+     * The number of times the SBML id index has been built
+     */
+    size_t IdIndexBuilds;
+  };
+
 protected:
+  typedef std::map< const CDataObject *, SBase * >::const_iterator CopasiToSBMLIterator;
+
   static
   C_FLOAT64 round(const C_FLOAT64 & x);
 
@@ -158,6 +185,72 @@ protected:
   std::set<const CDataObject*> mChangedObjects;
   std::map<const UnitDefinition*, std::string> mUnitExpressions;
 
+  /**
+   * Hash index of the SBML ids (and the SBML ids of the COPASI objects) to
+   * the entries of the COPASI to SBML map. The entries for each id are stored
+   * in the order of the map.
+   */
+  std::unordered_map< std::string, std::vector< CopasiToSBMLIterator > > mSBMLIdIndex;
+
+  /**
+   * The map for which the index was built
+   */
+  const std::map< const CDataObject *, SBase * > * mpSBMLIdIndexMap;
+
+  /**
+   * The size of the map when the index was built
+   */
+  size_t mSBMLIdIndexSize;
+
+  /**
+   * The statistics of the current import
+   */
+  sImportStatistics mImportStatistics;
+
+  /**
+   * The wall clock time at the start of the current import phase
+   */
+  CCopasiTimeVariable mPhaseStart;
+
+  /**
+   * Retrieve all entries of the COPASI to SBML map whose SBML object or COPASI
+   * object may have the given id. The caller must still compare the id. The index
+   * is rebuilt automatically when elements are added to the map or when a
+   * candidate no longer has the id.
+   * @param const std::string & id
+   * @param const std::map< const CDataObject *, SBase * > & copasi2sbmlmap
+   * @return std::vector< CopasiToSBMLIterator > candidates
+   */
+  std::vector< CopasiToSBMLIterator > findSBMLIdCandidates(const std::string & id,
+      const std::map< const CDataObject *, SBase * > & copasi2sbmlmap);
+
+  /**
+   * Build the SBML id index for the given map
+   * @param const std::map< const CDataObject *, SBase * > & copasi2sbmlmap
+   */
+  void buildSBMLIdIndex(const std::map< const CDataObject *, SBase * > & copasi2sbmlmap);
+
+  /**
+   * Retrieve the ids under which an entry of the COPASI to SBML map is indexed,
+   * i.e., the SBML id, the name for Level 1, and the SBML id of the COPASI object.
+   * Ids which do not apply are empty.
+   * @param const CopasiToSBMLIterator & it
+   * @param std::string ids[3]
+   */
+  void getSBMLIds(const CopasiToSBMLIterator & it, std::string ids[3]) const;
+
+  /**
+   * Invalidate the SBML id index. This must be called whenever elements are
+   * removed from the COPASI to SBML map or whenever mapped elements are renamed.
+   */
+  void invalidateSBMLIdIndex();
+
+  /**
+   * Record the time spent in the current import phase and start the next one.
+   * @param const std::string & title (empty if no further phase is started)
+   */
+  void startImportPhase(const std::string & title);
+
   /**
    * This utility functions adds a new step to the progress dialog (if present)
    * @param globalStep the global steps that have been completed
@@ -755,6 +848,13 @@ public:
    */
   virtual void clearCallBack();
 
+  /**
+   * Retrieve the statistics of the last import, i.e., the time spent in each
+   * import phase and the number of id lookups.
+   * @return const sImportStatistics & statistics
+   */
+  const sImportStatistics & getImportStatistics() const;
+
 
   /**
    * Enhanced method to identify identical SBML unit definitions.
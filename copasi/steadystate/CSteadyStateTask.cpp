@@ -52,7 +52,8 @@ CSteadyStateTask::CSteadyStateTask(const CDataContainer * pParent,
   mpJacobianAnn(NULL),
   mpJacobianXAnn(NULL),
   mEigenValues("Eigenvalues of Jacobian", this),
-  mEigenValuesX("Eigenvalues of reduced system Jacobian", this)
+  mEigenValuesX("Eigenvalues of reduced system Jacobian", this),
+  mProcessingGuess(false)
 {
   mpProblem = new CSteadyStateProblem(this);
 
@@ -70,7 +71,8 @@ CSteadyStateTask::CSteadyStateTask(const CSteadyStateTask & src,
   mpJacobianAnn(NULL),
   mpJacobianXAnn(NULL),
   mEigenValues(src.mEigenValues, this),
-  mEigenValuesX(src.mEigenValuesX, this)
+  mEigenValuesX(src.mEigenValuesX, this),
+  mProcessingGuess(false)
 {
   mpProblem =
     new CSteadyStateProblem(*(CSteadyStateProblem *) src.mpProblem, this);
@@ -273,7 +275,9 @@ bool CSteadyStateTask::process(const bool & useInitialValues)
       mSteadyState[mpContainer->getCountFixedEventTargets()] = InitialTime;
     }
 
-  if (mResult == CSteadyStateMethod::notFound)
+  // A failed attempt from a guess is repeated from the initial state, i.e.,
+  // we must not reset the container.
+  if (mResult == CSteadyStateMethod::notFound && !mProcessingGuess)
     restore();
 
   //update Jacobian
@@ -361,6 +365,38 @@ bool CSteadyStateTask::process(const bool & useInitialValues)
   return (mResult != CSteadyStateMethod::notFound);
 }
 
+bool CSteadyStateTask::processWithGuess(const CVectorCore< C_FLOAT64 > & guess)
+{
+  mpContainer->applyInitialValues();
+
+  const CVectorCore< C_FLOAT64 > & State = mpContainer->getState(true);
+
+  if (guess.size() != State.size())
+    return process(false);
+
+  // We keep the fixed event targets and the time of the current state.
+  size_t Offset = mpContainer->getCountFixedEventTargets() + 1;
+  CVector< C_FLOAT64 > Guess(State);
+  memcpy(Guess.array() + Offset, guess.array() + Offset, (Guess.size() - Offset) * sizeof(C_FLOAT64));
+
+  mpContainer->setState(Guess);
+  mpContainer->updateSimulatedValues(true);
+
+  mProcessingGuess = true;
+  bool success = process(false);
+  mProcessingGuess = false;
+
+  // If no proper steady state is found from the guess we fall back to the
+  // initial state. Note, a steady state found from the guess is not checked to
+  // be the one reached from the initial state.
+  if (success &&
+      (mResult == CSteadyStateMethod::found ||
+       mResult == CSteadyStateMethod::foundEquilibrium))
+    return true;
+
+  return process(true);
+}
+
 bool CSteadyStateTask::restore()
 {
   setCallBack(NULL);
@@ -92,6 +92,11 @@ private:
    */
   CSteadyStateMethod::ReturnCode mResult;
 
+  /**
+   * Indicates whether the method is started from a guess of the steady state
+   */
+  bool mProcessingGuess;
+
   //Operations
 private:
   /**
@@ -149,6 +154,21 @@ public:
    */
   virtual bool process(const bool & useInitialValues);
 
+  /**
+   * Process the task starting the method from the given guess instead of the
+   * initial state. The guess is the reduced state of a previously found steady
+   * state of the same model, e.g., for nearby parameter values. The initial values
+   * are applied first, i.e., conserved totals and fixed values are always the
+   * current ones. If the method does not find a proper steady state from the guess
+   * the task is processed from the initial state.
+   *
+   * Note, for models with more than one steady state the steady state found
+   * from the guess may differ from the one found from the initial state.
+   * @param const CVectorCore< C_FLOAT64 > & guess
+   * @return bool success
+   */
+  bool processWithGuess(const CVectorCore< C_FLOAT64 > & guess);
+
   /**
    * Perform necessary cleanup procedures
    */
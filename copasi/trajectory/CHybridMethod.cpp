@@ -416,9 +416,12 @@ void CHybridMethod::updatePriorityQueue(size_t rIndex, C_FLOAT64 time)
     {
       // reaction is stochastic
       newTime = time + generateReactionTime(rIndex);
-      mPQ.updateNode(rIndex, newTime);
+      mPQ.updateNodeDeferred(rIndex, newTime);
     }
 
+  // All stochastic reactions may have changed; we reorder the queue only once.
+  mPQ.flushUpdates();
+
   return;
 }
 
@@ -448,13 +451,13 @@ void CHybridMethod::updateTauMu(size_t rIndex, C_FLOAT64 time)
       if (mAmu[rIndex] != 0.0)
         {
           newTime = time + generateReactionTime(rIndex);
-          mPQ.updateNode(rIndex, newTime);
+          mPQ.updateNodeDeferred(rIndex, newTime);
         }
     }
   else
     {
       newTime = time + (mAmuOld[rIndex] / mAmu[rIndex]) * (mPQ.getKey(rIndex) - time);
-      mPQ.updateNode(rIndex, newTime);
+      mPQ.updateNodeDeferred(rIndex, newTime);
     }
 
   return;
@@ -246,7 +246,8 @@ protected:
   /**
    *   Updates the putative reaction time of a stochastic reaction in the
    *   priority queue. The corresponding amu and amu_old must be set prior to
-   *   the call of this method.
+   *   the call of this method. The new time is applied to the queue with the
+   *   next call of mPQ.flushUpdates().
    *
    *   @param rIndex A size_t specifying the index of the reaction
    *   @param time A C_FLOAT64 specifying the current time
@@ -96,7 +96,7 @@ void CStochNextReactionMethod::updatePriorityQueue(size_t reaction_index, C_FLOA
   //first the new time for the currently fired reaction
   C_FLOAT64 new_time = time + generateReactionTime(reaction_index);
   mAmuOld[reaction_index] = mAmu[reaction_index];
-  mPQ.updateNode(reaction_index, new_time);
+  mPQ.updateNodeDeferred(reaction_index, new_time);
 
   //now the updates for the other reactions (whose propensities may have changed)
 
@@ -122,7 +122,10 @@ void CStochNextReactionMethod::updatePriorityQueue(size_t reaction_index, C_FLOA
             }
 
           mAmuOld[index] = mAmu[index];
-          mPQ.updateNode(index, new_time);
+          mPQ.updateNodeDeferred(index, new_time);
         }
     }
+
+  // The keys of the dependent reactions still hold the old values until here.
+  mPQ.flushUpdates();
 }
@@ -17,6 +17,7 @@
 // Properties, Inc. and EML Research, gGmbH.
 // All rights reserved.
 
+#include <algorithm>
 #include <limits>
 
 #include "copasi.h"
@@ -43,14 +44,19 @@ std::string CTimeSeries::mDummyString("");
 // static
 C_FLOAT64 CTimeSeries::mDummyFloat(0.0);
 
+// static
+const size_t CTimeSeries::BlockSteps(1024);
+
 CTimeSeries::CTimeSeries():
   COutputInterface(),
-  CMatrix< C_FLOAT64 >(),
+  mBlocks(),
+  mFirstBlockSteps(0),
+  mColumns(0),
   mAllocatedSteps(0),
   mRecordedSteps(0),
   mNumVariables(0),
-  mpIt(mpBuffer),
-  mpEnd(mpBuffer + size()),
+  mpIt(NULL),
+  mpEnd(NULL),
   mContainerValues(),
   mTitles(),
   mCompartment(),
@@ -61,12 +67,14 @@ CTimeSeries::CTimeSeries():
 
 CTimeSeries::CTimeSeries(const CTimeSeries & src):
   COutputInterface(src),
-  CMatrix< C_FLOAT64 >(src),
+  mBlocks(),
+  mFirstBlockSteps(src.mFirstBlockSteps),
+  mColumns(src.mColumns),
   mAllocatedSteps(src.mAllocatedSteps),
   mRecordedSteps(src.mRecordedSteps),
   mNumVariables(src.mNumVariables),
-  mpIt(mpBuffer + mRecordedSteps * mCols),
-  mpEnd(mpBuffer + size()),
+  mpIt(NULL),
+  mpEnd(NULL),
   mContainerValues(),
   mTitles(src.mTitles),
   mCompartment(src.mCompartment),
@@ -75,10 +83,25 @@ CTimeSeries::CTimeSeries(const CTimeSeries & src):
   mNumberToQuantityFactor(src.mNumberToQuantityFactor)
 {
   mContainerValues.initialize(src.mContainerValues);
+
+  std::vector< CMatrix< C_FLOAT64 > * >::const_iterator it = src.mBlocks.begin();
+  std::vector< CMatrix< C_FLOAT64 > * >::const_iterator end = src.mBlocks.end();
+
+  for (; it != end; ++it)
+    mBlocks.push_back(new CMatrix< C_FLOAT64 >(**it));
+
+  // Continue recording after the last recorded step.
+  if (!mBlocks.empty())
+    {
+      mpEnd = mBlocks.back()->array() + mBlocks.back()->size();
+      mpIt = mpEnd - (src.mpEnd - src.mpIt);
+    }
 }
 
 CTimeSeries::~CTimeSeries()
-{}
+{
+  deleteBlocks();
+}
 
 void CTimeSeries::allocate(const size_t & steps)
 {
@@ -88,30 +111,53 @@ void CTimeSeries::allocate(const size_t & steps)
 
 void CTimeSeries::increaseAllocation()
 {
-  size_t diff;
-  diff = mAllocatedSteps / 4;
+  // The steps must be contiguous, i.e., we only append a block if the current one is full.
+  if (mpIt != mpEnd) return;
 
-  if (diff < 10)
-    diff = 10;
-  else if (diff > 10000)
-    diff = 10000;
+  addBlock(BlockSteps);
+  mAllocatedSteps += BlockSteps;
+}
 
-  mAllocatedSteps += diff;
-  CMatrix< C_FLOAT64 >::resize(mAllocatedSteps, mCols, true);
+void CTimeSeries::addBlock(const size_t & steps)
+{
+  mBlocks.push_back(new CMatrix< C_FLOAT64 >(steps, mColumns));
 
-  mpIt = mpBuffer + mRecordedSteps * mCols;
-  mpEnd = mpBuffer + size();
+  mpIt = mBlocks.back()->array();
+  mpEnd = mpIt + mBlocks.back()->size();
+}
+
+void CTimeSeries::deleteBlocks()
+{
+  std::vector< CMatrix< C_FLOAT64 > * >::iterator it = mBlocks.begin();
+  std::vector< CMatrix< C_FLOAT64 > * >::iterator end = mBlocks.end();
+
+  for (; it != end; ++it)
+    delete *it;
+
+  mBlocks.clear();
+  mFirstBlockSteps = 0;
+  mpIt = NULL;
+  mpEnd = NULL;
+}
+
+const C_FLOAT64 * CTimeSeries::getStep(const size_t & step) const
+{
+  if (step < mFirstBlockSteps)
+    return mBlocks[0]->array() + step * mColumns;
+
+  size_t Step = step - mFirstBlockSteps;
+
+  return mBlocks[1 + Step / BlockSteps]->array() + (Step % BlockSteps) * mColumns;
 }
 
 void CTimeSeries::clear()
 {
   mObjects.clear();
-  CMatrix< C_FLOAT64 >::resize(0, 0);
-  mAllocatedSteps = mRows;
+  deleteBlocks();
+  mColumns = 0;
+  mAllocatedSteps = 0;
   mRecordedSteps = 0;
   mNumVariables = 0;
-  mpIt = mpBuffer;
-  mpEnd = mpBuffer + size();
   mTitles.clear();
   mCompartment.resize(0);
   mPivot.resize(0);
@@ -154,7 +200,12 @@ bool CTimeSeries::compile(CObjectInterface::ContainerList listOfContainer)
 
   mObjects.clear();
 
-  CMatrix< C_FLOAT64 >::resize(mAllocatedSteps + 1, imax);
+  // The first block holds all expected steps, i.e., no further allocation is
+  // needed unless events cause additional output.
+  deleteBlocks();
+  mColumns = imax;
+  mFirstBlockSteps = mAllocatedSteps + 1;
+  addBlock(mFirstBlockSteps);
 
   mPivot.resize(imax);
   mTitles.resize(imax);
@@ -164,8 +215,6 @@ bool CTimeSeries::compile(CObjectInterface::ContainerList listOfContainer)
 
   mRecordedSteps = 0;
   mNumVariables = Fixed;
-  mpIt = mpBuffer;
-  mpEnd = mpBuffer + size();
 
   mNumberToQuantityFactor = pContainer->getModel().getNumber2QuantityFactor();
 
@@ -259,8 +308,8 @@ void CTimeSeries::output(const COutputInterface::Activity & activity)
 
   if (mpIt != mpEnd)
     {
-      memcpy(mpIt, mContainerValues.array(), mCols * sizeof(C_FLOAT64));
-      mpIt += mCols;
+      memcpy(mpIt, mContainerValues.array(), mColumns * sizeof(C_FLOAT64));
+      mpIt += mColumns;
       mRecordedSteps++;
     }
 }
@@ -277,7 +326,7 @@ void CTimeSeries::separate(const COutputInterface::Activity & /* activity */)
   if (mpIt != mpEnd)
     {
       C_FLOAT64 * pIt = mpIt;
-      mpIt += mCols;
+      mpIt += mColumns;
       mRecordedSteps++;
 
       // We copy NaN to indicate separation, which is similar to plotting.
@@ -302,7 +351,7 @@ const C_FLOAT64 & CTimeSeries::getData(const size_t & step,
                                        const size_t & var) const
 {
   if (step < mRecordedSteps && var < mNumVariables)
-    return *(mpBuffer + step * mCols + mPivot[var]);
+    return getStep(step)[mPivot[var]];
 
   return mDummyFloat;
 }
@@ -313,11 +362,12 @@ C_FLOAT64 CTimeSeries::getConcentrationData(const size_t & step,
   if (step < mRecordedSteps && var < mNumVariables)
     {
       const size_t & Col = mPivot[var];
+      const C_FLOAT64 * pStep = getStep(step);
 
       if (mCompartment[Col] != C_INVALID_INDEX)
-        return *(mpBuffer + step * mCols + Col) * mNumberToQuantityFactor / *(mpBuffer + step * mCols + mCompartment[Col]);
+        return pStep[Col] * mNumberToQuantityFactor / pStep[mCompartment[Col]];
       else
-        return *(mpBuffer + step * mCols + Col);
+        return pStep[Col];
     }
 
   return mDummyFloat;
@@ -339,6 +389,55 @@ const std::string & CTimeSeries::getKey(const size_t & var) const
   return mDummyString;
 }
 
+const size_t & CTimeSeries::getColumnCount() const
+{return mColumns;}
+
+size_t CTimeSeries::getColumn(const size_t & var) const
+{
+  if (var < mNumVariables)
+    return mPivot[var];
+
+  return C_INVALID_INDEX;
+}
+
+size_t CTimeSeries::getCompartmentColumn(const size_t & var) const
+{
+  if (var < mNumVariables)
+    return mCompartment[mPivot[var]];
+
+  return C_INVALID_INDEX;
+}
+
+const C_FLOAT64 & CTimeSeries::getNumberToQuantityFactor() const
+{return mNumberToQuantityFactor;}
+
+size_t CTimeSeries::getBlockCount() const
+{return mBlocks.size();}
+
+size_t CTimeSeries::getBlockSteps(const size_t & block) const
+{
+  if (block >= mBlocks.size())
+    return 0;
+
+  if (block == 0)
+    return std::min(mRecordedSteps, mFirstBlockSteps);
+
+  size_t First = mFirstBlockSteps + (block - 1) * BlockSteps;
+
+  if (mRecordedSteps <= First)
+    return 0;
+
+  return std::min(mRecordedSteps - First, BlockSteps);
+}
+
+const C_FLOAT64 * CTimeSeries::getBlock(const size_t & block) const
+{
+  if (block < mBlocks.size())
+    return mBlocks[block]->array();
+
+  return NULL;
+}
+
 std::string CTimeSeries::getSBMLId(const size_t & var, const CDataModel* pDataModel) const
 {
   std::string key = getKey(var);
@@ -30,7 +30,13 @@
 class CModel;
 class CDataModel;
 
-class CTimeSeries : public COutputInterface, protected CMatrix< C_FLOAT64 >
+/**
+ * The time series stores the recorded steps in blocks of rows. The first block
+ * is sized to hold the expected number of steps. If more steps are recorded
+ * additional blocks of fixed size are appended, i.e., the recorded data is
+ * never copied.
+ */
+class CTimeSeries : public COutputInterface
 {
 private:
   //since the assignment operator are not properly implemented
@@ -91,7 +97,8 @@ public:
   void allocate(const size_t & steps);
 
   /**
-   * Increase the allocated space for the time series.
+   * Increase the allocated space for the time series by appending a block.
+   * The already recorded steps are not moved.
    */
   void increaseAllocation();
 
@@ -164,7 +171,97 @@ public:
    */
   std::string getSBMLId(const size_t & variable, const CDataModel* pDataModel) const;
 
+  //**** direct access to the recorded values ***
+
+  /**
+   * Retrieve the number of stored columns. The stored columns include
+   * fixed values which are not exposed as variables.
+   * @return const size_t & columnCount
+   */
+  const size_t & getColumnCount() const;
+
+  /**
+   * Retrieve the stored column of the indexed variable
+   * @param const size_t & variable
+   * @return size_t column (C_INVALID_INDEX if the variable is invalid)
+   */
+  size_t getColumn(const size_t & variable) const;
+
+  /**
+   * Retrieve the stored column of the compartment volume of the indexed
+   * variable, which is needed to calculate species concentrations
+   * @param const size_t & variable
+   * @return size_t column (C_INVALID_INDEX if the variable is not a species)
+   */
+  size_t getCompartmentColumn(const size_t & variable) const;
+
+  /**
+   * Retrieve the factor converting particle numbers to amounts
+   * @return const C_FLOAT64 & numberToQuantityFactor
+   */
+  const C_FLOAT64 & getNumberToQuantityFactor() const;
+
+  /**
+   * Retrieve the number of blocks holding the recorded steps
+   * @return size_t blockCount
+   */
+  size_t getBlockCount() const;
+
+  /**
+   * Retrieve the number of recorded steps in the indexed block
+   * @param const size_t & block
+   * @return size_t blockSteps
+   */
+  size_t getBlockSteps(const size_t & block) const;
+
+  /**
+   * Retrieve the values of the indexed block. The steps of a block are
+   * contiguous and each step holds getColumnCount() values. The pointer
+   * is valid until the time series is compiled or cleared.
+   * @param const size_t & block
+   * @return const C_FLOAT64 * block (NULL if the block is invalid)
+   */
+  const C_FLOAT64 * getBlock(const size_t & block) const;
+
 private:
+  /**
+   * Retrieve a pointer to the values of the indexed step
+   * @param const size_t & step
+   * @return const C_FLOAT64 * pStep
+   */
+  const C_FLOAT64 * getStep(const size_t & step) const;
+
+  /**
+   * Append a block for the given number of steps and make it the current
+   * block for recording
+   * @param const size_t & steps
+   */
+  void addBlock(const size_t & steps);
+
+  /**
+   * Release the memory of all blocks
+   */
+  void deleteBlocks();
+
+  /**
+   * The number of steps of each block appended after the first one
+   */
+  static const size_t BlockSteps;
+
+  /**
+   * The blocks storing the recorded steps
+   */
+  std::vector< CMatrix< C_FLOAT64 > * > mBlocks;
+
+  /**
+   * The number of steps of the first block
+   */
+  size_t mFirstBlockSteps;
+
+  /**
+   * The number of values stored for each step
+   */
+  size_t mColumns;
 
   /**
    * The number of allocated steps
@@ -187,7 +284,7 @@ private:
   C_FLOAT64 * mpIt;
 
   /**
-   * Iterator pointing beyond the last allocated step (row)
+   * Iterator pointing beyond the last allocated step (row) of the current block
    */
   C_FLOAT64 * mpEnd;
 
@@ -72,6 +72,7 @@ const CEnumAnnotation< std::string, CData::Property > CData::PropertyName(
   "Report is Table", // REPORT_IS_TABLE
   "Report show Title", // REPORT_SHOW_TITLE
   "Report Precision", // REPORT_PRECISION
+  "Report Output Interval", // REPORT_OUTPUT_INTERVAL
   "Notes", // NOTES
   "MIRIAM Predicate", // MIRIAM_PREDICATE
   "MIRIAM Resource", // MIRIAM_RESOURCE
@@ -74,6 +74,7 @@ public:
     REPORT_IS_TABLE,
     REPORT_SHOW_TITLE,
     REPORT_PRECISION,
+    REPORT_OUTPUT_INTERVAL,
     NOTES,
     MIRIAM_PREDICATE,
     MIRIAM_RESOURCE,
@@ -35,6 +35,18 @@
 
 #define INITIALTEXTSIZE 1024
 
+#ifdef USE_OMP
+# include <mutex>
+
+// Messages may be created concurrently by the threads of a parallel
+// evaluation, i.e., all access to the message deque must be serialized.
+// The mutex is recursive since accessors may create messages themselves.
+static std::recursive_mutex MessageDequeMutex;
+# define LOCK_MESSAGE_DEQUE std::lock_guard< std::recursive_mutex > MessageDequeLock(MessageDequeMutex)
+#else
+# define LOCK_MESSAGE_DEQUE
+#endif // USE_OMP
+
 #ifdef WIN32
 /**
  * The stack of messages. Each message created with one of
@@ -50,6 +62,8 @@ bool CCopasiMessage::IsGUI = false;
 
 const CCopasiMessage & CCopasiMessage::peekFirstMessage()
 {
+  LOCK_MESSAGE_DEQUE;
+
   if (mMessageDeque.empty())
     CCopasiMessage(CCopasiMessage::RAW,
                    MCCopasiMessage + 1);
@@ -59,6 +73,8 @@ const CCopasiMessage & CCopasiMessage::peekFirstMessage()
 
 const CCopasiMessage & CCopasiMessage::peekLastMessage()
 {
+  LOCK_MESSAGE_DEQUE;
+
   if (mMessageDeque.empty())
     CCopasiMessage(CCopasiMessage::RAW,
                    MCCopasiMessage + 1);
@@ -68,6 +84,8 @@ const CCopasiMessage & CCopasiMessage::peekLastMessage()
 
 CCopasiMessage CCopasiMessage::getFirstMessage()
 {
+  LOCK_MESSAGE_DEQUE;
+
   if (mMessageDeque.empty())
     CCopasiMessage(CCopasiMessage::RAW,
                    MCCopasiMessage + 1);
@@ -80,6 +98,8 @@ CCopasiMessage CCopasiMessage::getFirstMessage()
 
 CCopasiMessage CCopasiMessage::getLastMessage()
 {
+  LOCK_MESSAGE_DEQUE;
+
   if (mMessageDeque.empty())
     CCopasiMessage(CCopasiMessage::RAW,
                    MCCopasiMessage + 1);
@@ -92,6 +112,8 @@ CCopasiMessage CCopasiMessage::getLastMessage()
 
 std::string CCopasiMessage::getAllMessageText(const bool & chronological)
 {
+  LOCK_MESSAGE_DEQUE;
+
   std::string Text = "";
   CCopasiMessage(*getMessage)() = chronological ? getFirstMessage : getLastMessage;
 
@@ -107,17 +129,23 @@ std::string CCopasiMessage::getAllMessageText(const bool & chronological)
 
 void CCopasiMessage::clearDeque()
 {
+  LOCK_MESSAGE_DEQUE;
+
   mMessageDeque.clear();
   return;
 }
 
 size_t CCopasiMessage::size()
 {
+  LOCK_MESSAGE_DEQUE;
+
   return mMessageDeque.size();
 }
 
 CCopasiMessage::Type CCopasiMessage::getHighestSeverity()
 {
+  LOCK_MESSAGE_DEQUE;
+
   CCopasiMessage::Type HighestSeverity = RAW;
   std::deque< CCopasiMessage >::const_iterator it = mMessageDeque.begin();
   std::deque< CCopasiMessage >::const_iterator end = mMessageDeque.end();
@@ -130,6 +158,8 @@ CCopasiMessage::Type CCopasiMessage::getHighestSeverity()
 
 bool CCopasiMessage::checkForMessage(const size_t & number)
 {
+  LOCK_MESSAGE_DEQUE;
+
   std::deque< CCopasiMessage >::const_iterator it = mMessageDeque.begin();
   std::deque< CCopasiMessage >::const_iterator end = mMessageDeque.end();
 
@@ -325,12 +355,16 @@ void CCopasiMessage::handler(const bool & /* _throw */)
 
   if (mType != RAW) lineBreak();
 
-  // Remove the message: No more messages.
-  if (mMessageDeque.size() == 1 &&
-      mMessageDeque.back().getNumber() == MCCopasiMessage + 1)
-    getLastMessage();
+  {
+    LOCK_MESSAGE_DEQUE;
+
+    // Remove the message: No more messages.
+    if (mMessageDeque.size() == 1 &&
+        mMessageDeque.back().getNumber() == MCCopasiMessage + 1)
+      getLastMessage();
 
-  mMessageDeque.push_back(*this);
+    mMessageDeque.push_back(*this);
+  }
 
   // All messages are printed to std::cerr
   if (COptions::compareValue("Verbose", true) &&
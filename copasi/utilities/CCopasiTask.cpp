@@ -38,6 +38,7 @@
 #include "model/CModel.h"
 #include "model/CState.h"
 #include "copasi/core/CDataObjectReference.h"
+#include "copasi/core/CContext.h"
 #include "core/CDataTimer.h"
 #include "CopasiDataModel/CDataModel.h"
 #include "copasi/core/CRootContainer.h"
@@ -518,6 +519,10 @@ CCopasiParameterGroup * CCopasiTask::getSliders()
 
 void CCopasiTask::output(const COutputInterface::Activity & activity)
 {
+  // The output handlers are not thread safe, i.e., output requested by
+  // workers running in a parallel region is skipped.
+  if (CContext< bool >::inParallel()) return;
+
   if (mpOutputHandler != NULL)
     switch (activity)
       {
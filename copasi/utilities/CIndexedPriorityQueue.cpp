@@ -24,8 +24,14 @@
 #include "CCopasiMessage.h"
 #include "CIndexedPriorityQueue.h"
 
-CIndexedPriorityQueue::CIndexedPriorityQueue()
-{}
+CIndexedPriorityQueue::CIndexedPriorityQueue():
+  mHeap(),
+  mIndexPointer(),
+  mPendingUpdates(),
+  mStatistics()
+{
+  resetStatistics();
+}
 
 CIndexedPriorityQueue::~CIndexedPriorityQueue()
 {}
@@ -41,28 +47,34 @@ size_t CIndexedPriorityQueue::topIndex() const
 {
   if (mHeap.empty())
     return C_INVALID_INDEX;
+
   return mHeap[0].mIndex;
 }
 
 // juergen: added 26 July, 2002
 size_t CIndexedPriorityQueue::removeStochReaction(const size_t index)
 {
-  size_t t;
-
   // check if index is valid
   if (index >= mIndexPointer.size()) return C_INVALID_INDEX;
 
-  if ((mIndexPointer[index] != C_INVALID_INDEX) && (mIndexPointer[index] != (mHeap.size() - 1))) // if the node with the given index exists in the tree
-    {// remove the node with the given index from the tree
-      swapNodes(t = mIndexPointer[index], mHeap.size() - 1);
-      mHeap.pop_back();
-      mIndexPointer[index] = -1;
-      heapify(t);
-    }
-  else if (mIndexPointer[index] == (mHeap.size() - 1)) // last node in the heap
+  size_t pos = mIndexPointer[index];
+
+  // the node with the given index does not exist in the tree
+  if (pos == C_INVALID_INDEX) return 0;
+
+  ++mStatistics.Removals;
+  mIndexPointer[index] = C_INVALID_INDEX;
+
+  // the last node fills the hole left by the removed one
+  PQNode Last = mHeap.back();
+  mHeap.pop_back();
+
+  if (pos < mHeap.size())
     {
-      mHeap.pop_back();
-      mIndexPointer[index] = -1;
+      if (pos > 0 && Last.mKey < mHeap[parent(pos)].mKey)
+        siftUp(pos, Last);
+      else
+        siftDown(pos, Last);
     }
 
   return 0;
@@ -71,23 +83,15 @@ size_t CIndexedPriorityQueue::removeStochReaction(const size_t index)
 // juergen: added 26 July, 2002
 size_t CIndexedPriorityQueue::insertStochReaction(const size_t index, const C_FLOAT64 key)
 {
-  size_t pos;
-
   // check if index is valid
-  if (index >= mIndexPointer.size()) return - 1;
+  if (index >= mIndexPointer.size()) return C_INVALID_INDEX;
 
-  // first the node is inserted at the end of the heap
-  mIndexPointer[index] = mHeap.size();
-  PQNode heap_node(index, key);
-  mHeap.push_back(heap_node);
-  // bubble the node up the tree to the right position !
-  pos = mIndexPointer[index];
+  ++mStatistics.Pushes;
 
-  while ((pos > 0) && (mHeap[parent(pos)].mKey > key))
-    {
-      swapNodes(pos, parent(pos));
-      pos = parent(pos);
-    }
+  // first the node is inserted at the end of the heap and then moved up the tree
+  PQNode Node(index, key);
+  mHeap.push_back(Node);
+  siftUp(mHeap.size() - 1, Node);
 
   return 0;
 }
@@ -95,12 +99,8 @@ size_t CIndexedPriorityQueue::insertStochReaction(const size_t index, const C_FL
 // juergen: added 26 July, 2002
 void CIndexedPriorityQueue::initializeIndexPointer(const size_t numberOfReactions)
 {
-  size_t i;
-
-  for (i = 0; i < numberOfReactions; i++)
-    {
-      mIndexPointer.push_back(C_INVALID_INDEX);
-    }
+  mIndexPointer.resize(mIndexPointer.size() + numberOfReactions, C_INVALID_INDEX);
+  mHeap.reserve(mIndexPointer.size());
 }
 
 size_t CIndexedPriorityQueue::pushPair(const size_t index, const C_FLOAT64 key)
@@ -114,168 +114,283 @@ size_t CIndexedPriorityQueue::pushPair(const size_t index, const C_FLOAT64 key)
   // be done using the buildHeap() method
 
   // First check that the index corresponds to the heap size before insertion
-  if (static_cast<unsigned int>(index) != mHeap.size())
+  if (index != mHeap.size())
     {
       CCopasiMessage(CCopasiMessage::ERROR, "Error inserting pair into priority queue");
-      return - 1;
+      return C_INVALID_INDEX;
     }
 
-  PQNode heap_node(index, key);
-  mHeap.push_back(heap_node);
+  ++mStatistics.Pushes;
+
+  mHeap.push_back(PQNode(index, key));
   // at first, position == index
-  size_t position = index; // for clarity
-  mIndexPointer.push_back(position);
+  mIndexPointer.push_back(index);
+
   return 0;
 }
 
 void CIndexedPriorityQueue::buildHeap()
 {
-  for (size_t i = mHeap.size() / 2 - 1; i != C_INVALID_INDEX; i--)
+  if (mHeap.size() < 2) return;
+
+  ++mStatistics.Rebuilds;
+
+  // Floyd's method: sift down all nodes which have children starting with the last one.
+  for (size_t i = parent(mHeap.size() - 1) + 1; i > 0;)
     {
-      heapify(i);
+      --i;
+      PQNode Node = mHeap[i];
+      siftDown(i, Node);
     }
 }
 
 void CIndexedPriorityQueue::clear()
-{mHeap.clear(); mIndexPointer.clear();}
+{
+  mHeap.clear();
+  mIndexPointer.clear();
+  mPendingUpdates.clear();
+}
 
 void CIndexedPriorityQueue::updateNode(const size_t index, const C_FLOAT64 new_key)
 {
+  ++mStatistics.Updates;
+
   size_t pos = mIndexPointer[index];
-  //    cout << "Setting heap at " << pos << " to be " << new_key << endl;
   mHeap[pos].mKey = new_key;
   updateAux(pos);
 }
 
-void CIndexedPriorityQueue::swapNodes(const size_t pos1, const size_t pos2)
+void CIndexedPriorityQueue::updateNodeDeferred(const size_t index, const C_FLOAT64 key)
 {
-  //    cout << "Swapping node " << pos1 << "(" << mHeap[pos1].mKey << ") with node ";
-  //    cout << pos2 << "(" << mHeap[pos2].mKey << ")\n";
-  C_FLOAT64 tempkey = mHeap[pos1].mKey;
-  size_t index1 = mHeap[pos1].mIndex;
-  size_t index2 = mHeap[pos2].mIndex;
-  // Put the contents of the node at pos2 into the node at pos1
-  mHeap[pos1].mIndex = index2;
-  mHeap[pos1].mKey = mHeap[pos2].mKey;
-  // Put the contents formerly in the node at pos1 into the node at pos2
-  mHeap[pos2].mIndex = index1;
-  mHeap[pos2].mKey = tempkey;
-  // Swap the pointers in the index vector
-  mIndexPointer[index1] = pos2;
-  mIndexPointer[index2] = pos1;
+  ++mStatistics.DeferredUpdates;
+
+  mPendingUpdates.push_back(PQNode(index, key));
 }
 
-void CIndexedPriorityQueue::heapify(const size_t current)
+void CIndexedPriorityQueue::flushUpdates()
 {
-  size_t left = leftChild(current);
-  size_t right = rightChild(current);
-  size_t highest_priority = current;
+  if (mPendingUpdates.empty()) return;
 
-  //    cout << "Heapifying " << current << "(Currently " << mHeap[current].mKey << ")" << endl;
-  if ((static_cast<unsigned int>(left) < mHeap.size()) && (mHeap[left].mKey < mHeap[current].mKey))
-    {
-      highest_priority = left;
-    }
+  // Moving a single node costs up to the depth of the heap whereas
+  // rebuilding the heap is linear in its size.
+  size_t Depth = 1;
+
+  for (size_t Size = mHeap.size(); Size > Arity; Size /= Arity)
+    ++Depth;
+
+  bool Rebuild = (mPendingUpdates.size() * Depth > mHeap.size());
+
+  std::vector< PQNode >::const_iterator it = mPendingUpdates.begin();
+  std::vector< PQNode >::const_iterator end = mPendingUpdates.end();
 
-  if ((static_cast<unsigned int>(right) < mHeap.size()) && (mHeap[right].mKey < mHeap[highest_priority].mKey))
+  for (; it != end; ++it)
     {
-      highest_priority = right;
+      size_t pos = mIndexPointer[it->mIndex];
+
+      // the node has been removed in the meantime
+      if (pos == C_INVALID_INDEX) continue;
+
+      mHeap[pos].mKey = it->mKey;
+
+      if (!Rebuild)
+        {
+          updateAux(pos);
+        }
     }
 
-  if (highest_priority != current)
+  mPendingUpdates.clear();
+
+  if (Rebuild)
     {
-      swapNodes(current, highest_priority);
-      heapify(highest_priority);
+      buildHeap();
     }
 }
 
-void CIndexedPriorityQueue::updateAux(const size_t pos)
+const CIndexedPriorityQueue::sStatistics & CIndexedPriorityQueue::getStatistics() const
+{
+  return mStatistics;
+}
+
+void CIndexedPriorityQueue::resetStatistics()
 {
-  size_t parent_pos = parent(pos);
-  C_FLOAT64 keyval = mHeap[pos].mKey;
+  mStatistics.Pushes = 0;
+  mStatistics.Removals = 0;
+  mStatistics.Updates = 0;
+  mStatistics.DeferredUpdates = 0;
+  mStatistics.Rebuilds = 0;
+  mStatistics.Moves = 0;
+  mStatistics.Comparisons = 0;
+}
 
-  if (parent_pos != C_INVALID_INDEX &&
-      keyval < mHeap[parent_pos].mKey)
+size_t CIndexedPriorityQueue::siftUp(size_t pos, const PQNode & node)
+{
+  while (pos > 0)
     {
-      swapNodes(pos, parent_pos);
-      updateAux(parent_pos);
+      size_t Parent = parent(pos);
+
+      ++mStatistics.Comparisons;
+
+      if (!(node.mKey < mHeap[Parent].mKey)) break;
+
+      place(pos, mHeap[Parent]);
+      pos = Parent;
     }
-  else
+
+  place(pos, node);
+
+  return pos;
+}
+
+size_t CIndexedPriorityQueue::siftDown(size_t pos, const PQNode & node)
+{
+  const size_t Size = mHeap.size();
+  size_t Child = firstChild(pos);
+
+  while (Child < Size)
     {
-      size_t left = leftChild(pos);
-      size_t right = rightChild(pos);
-      C_FLOAT64 min = 0.0;
-      size_t min_pos = 0;
+      // The children of a node are adjacent in memory.
+      size_t End = std::min(Child + Arity, Size);
+      size_t Min = Child;
 
-      if (left < mHeap.size())
+      for (size_t i = Child + 1; i < End; ++i)
         {
-          min = mHeap[left].mKey;
-          min_pos = left;
+          ++mStatistics.Comparisons;
+
+          if (mHeap[i].mKey < mHeap[Min].mKey) Min = i;
         }
 
-      C_FLOAT64 val; // = mHeap[right].mKey; //!!!
+      ++mStatistics.Comparisons;
 
-      if ((right < mHeap.size()) && ((val = mHeap[right].mKey) < min))
-        {
-          min = val;
-          min_pos = right;
-        }
+      if (!(mHeap[Min].mKey < node.mKey)) break;
 
-      if ((min_pos > 0) && (keyval > min))
-        {
-          //            swapNodes(mHeap[pos].mIndex, min_pos);
-          swapNodes(pos, min_pos);
-          updateAux(min_pos);
-        }
+      place(pos, mHeap[Min]);
+      pos = Min;
+      Child = firstChild(pos);
+    }
+
+  place(pos, node);
+
+  return pos;
+}
+
+void CIndexedPriorityQueue::updateAux(const size_t pos)
+{
+  PQNode Node = mHeap[pos];
+
+  if (pos > 0 && Node.mKey < mHeap[parent(pos)].mKey)
+    {
+      siftUp(pos, Node);
+    }
+  else
+    {
+      siftDown(pos, Node);
     }
 }
 
 #ifdef TEST_PRIORITY_QUEUE
+#include <iostream>
+#include <cstdlib>
+
+#include "randomGenerator/CRandom.h"
+#include "utilities/CopasiTime.h"
 
+// Micro benchmark reproducing the queue operations of the next reaction method
+// on a synthetic reaction network. Each fired reaction changes the putative
+// reaction times of a fixed number of randomly chosen dependent reactions.
+// The updates are applied once node by node and once in bulk.
 int main(int argc, char **argv)
 {
-  // Generates a vector of pairs, with a size given by the first argument. Each element is added to a priority queue.
-  if (argc != 2)
+  if (argc < 2)
     {
-      cout << "Usage: " << argv[0] << " <number of pairs to generate>" << endl;
+      std::cout << "Usage: " << argv[0] << " <number of reactions> [<dependents per reaction> [<number of events>]]" << std::endl;
       return - 1;
     }
 
-  int count = atoi(argv[1]);
-  cout << "Creating priority queue of size " << count << endl;
-  std::vector<C_FLOAT64> invec;
-  CIndexedPriorityQueue pq;
-  CRandom *rand = new CRandom(1);
-  C_FLOAT64 rndval;
-  cout << "Input vector:\n";
+  size_t Reactions = strtoul(argv[1], NULL, 10);
+  size_t Dependents = (argc > 2) ? strtoul(argv[2], NULL, 10) : 5;
+  size_t Events = (argc > 3) ? strtoul(argv[3], NULL, 10) : 1000000;
 
-  for (int i = 0; i < count; i++)
+  if (Reactions < 1)
     {
-      rndval = rand->getUniformRandom();
-      invec.push_back(rndval);
-      cout << "element " << i << ":" << rndval << endl;
-      pq.pushPair(i, invec[i]);
+      std::cout << "The number of reactions must be positive." << std::endl;
+      return - 1;
     }
 
-  cout << "Building heap\n";
-  pq.buildHeap();
-  cout << "Done building heap\n";
-  // Display the priority queue
-  cout << "\nPriority Queue:\n";
+  CRandom * pRandom = CRandom::createGenerator(CRandom::mt19937, 1);
 
-  for (int i = 0; i < count; i++)
+  std::vector< C_FLOAT64 > Amu(Reactions);
+  std::vector< std::vector< size_t > > DependencyGraph(Reactions);
+  size_t i, j, k;
+
+  for (i = 0; i < Reactions; i++)
     {
-      cout << "Queue: ";
+      Amu[i] = 0.1 + pRandom->getRandomCC();
 
-      for (int j = 0; j < count; j++) cout << " " << j << "-" << pq[j];
+      for (j = 0; j < Dependents; j++)
+        DependencyGraph[i].push_back(pRandom->getRandomU(Reactions - 1));
+    }
 
-      cout << endl;
-      cout << "Position: " << i;
-      cout << " Index = " << pq.topIndex();
-      cout << " Key = " << pq.topKey() << endl;
-      pq.updateNode(pq.topIndex(), 10000000);
+  for (k = 0; k < 2; k++)
+    {
+      bool Bulk = (k == 1);
+
+      CIndexedPriorityQueue PQ;
+      pRandom->initialize(1);
+
+      for (i = 0; i < Reactions; i++)
+        PQ.pushPair(i, -log(pRandom->getRandomOO()) / Amu[i]);
+
+      PQ.buildHeap();
+      PQ.resetStatistics();
+
+      CCopasiTimeVariable Start = CCopasiTimeVariable::getCurrentWallTime();
+
+      for (i = 0; i < Events; i++)
+        {
+          size_t Fired = PQ.topIndex();
+          C_FLOAT64 Time = PQ.topKey();
+
+          std::vector< size_t >::const_iterator it = DependencyGraph[Fired].begin();
+          std::vector< size_t >::const_iterator end = DependencyGraph[Fired].end();
+
+          for (; it != end; ++it)
+            if (*it != Fired)
+              {
+                C_FLOAT64 Key = Time - log(pRandom->getRandomOO()) / Amu[*it];
+
+                if (Bulk)
+                  PQ.updateNodeDeferred(*it, Key);
+                else
+                  PQ.updateNode(*it, Key);
+              }
+
+          C_FLOAT64 Key = Time - log(pRandom->getRandomOO()) / Amu[Fired];
+
+          if (Bulk)
+            {
+              PQ.updateNodeDeferred(Fired, Key);
+              PQ.flushUpdates();
+            }
+          else
+            PQ.updateNode(Fired, Key);
+        }
+
+      CCopasiTimeVariable Elapsed = CCopasiTimeVariable::getCurrentWallTime() - Start;
+      const CIndexedPriorityQueue::sStatistics & Statistics = PQ.getStatistics();
+
+      std::cout << (Bulk ? "Bulk update" : "Single update") << std::endl;
+      std::cout << "  Reactions:        " << Reactions << std::endl;
+      std::cout << "  Events:           " << Events << std::endl;
+      std::cout << "  Wall time [ms]:   " << Elapsed.getMilliSeconds() << std::endl;
+      std::cout << "  Updates:          " << Statistics.Updates << std::endl;
+      std::cout << "  Deferred updates: " << Statistics.DeferredUpdates << std::endl;
+      std::cout << "  Rebuilds:         " << Statistics.Rebuilds << std::endl;
+      std::cout << "  Moves/event:      " << (C_FLOAT64) Statistics.Moves / Events << std::endl;
+      std::cout << "  Comparisons/event:" << (C_FLOAT64) Statistics.Comparisons / Events << std::endl;
     }
 
+  delete pRandom;
+
   return 0;
 }
 
@@ -70,6 +70,16 @@ private:
  * The index can be used to access elements from positions other than at
  * the front of the queue.
  *
+ * The queue is implemented as a 4-ary heap stored in one contiguous vector.
+ * Compared to a binary heap the tree is half as deep and the children of a
+ * node are adjacent in memory, which reduces the number of cache lines touched
+ * when a node is moved down. Nodes are moved into a hole instead of being
+ * swapped pairwise.
+ *
+ * Several keys may be changed at once with updateNodeDeferred() followed by
+ * flushUpdates(). Depending on the number of changes the heap is either
+ * repaired node by node or rebuilt in linear time.
+ *
  * The indexed priority queue as applied to stochastic simulations is described in
  * "Efficient Exact Stochastic Simulation of Chemical Systems with Many Species
  * and Many Channels", Gibson and Bruck, J. Phys. Chem. A 104 (2000) 1876-1889
@@ -78,6 +88,27 @@ private:
 class CIndexedPriorityQueue
 {
 public:
+  /**
+   * Counters describing the work done by the queue. The number of moved nodes
+   * and compared keys is a portable measure of the memory traffic, i.e.,
+   * the cache behavior, of the heap operations.
+   */
+  struct sStatistics
+  {
+    size_t Pushes;
+    size_t Removals;
+    size_t Updates;
+    size_t DeferredUpdates;
+    size_t Rebuilds;
+    size_t Moves;
+    size_t Comparisons;
+  };
+
+  /**
+   * The arity of the heap
+   */
+  static const size_t Arity = 4;
+
   // Lifecycle methods
   /**
    * Constructor
@@ -154,6 +185,21 @@ public:
    */
   void updateNode(const size_t index, const C_FLOAT64 key);
 
+  /**
+   * Record a new key value for the node at the given index. The heap is
+   * not modified until flushUpdates() is called, i.e., getKey, topKey, and
+   * topIndex still report the old state.
+   * @param index The index used to access the node
+   * @param key The key value used to determine the priority
+   */
+  void updateNodeDeferred(const size_t index, const C_FLOAT64 key);
+
+  /**
+   * Apply all updates recorded with updateNodeDeferred. If many nodes are
+   * affected the heap is rebuilt otherwise each node is moved individually.
+   */
+  void flushUpdates();
+
   /**
    * Overloads the [] operator. Gives the indexth element on the heap
    * @return Returns the key
@@ -175,6 +221,17 @@ public:
     return mHeap[mIndexPointer[index]].mKey;
   }
 
+  /**
+   * Retrieve the counters collected since the last reset
+   * @return const sStatistics & statistics
+   */
+  const sStatistics & getStatistics() const;
+
+  /**
+   * Reset all counters to zero
+   */
+  void resetStatistics();
+
   /**
    * insert operator
    */
@@ -184,15 +241,34 @@ public:
 private:
   // Private operations
   /**
-   *  Swap a pair of nodes and update the index structure accordingly.
+   * Move the node up starting from the hole at the given position until
+   * the heap ordering is restored.
+   * @param size_t pos The position of the hole
+   * @param const PQNode & node The node to be placed
+   * @return size_t The final position of the node
+   */
+  size_t siftUp(size_t pos, const PQNode & node);
+
+  /**
+   * Move the node down starting from the hole at the given position until
+   * the heap ordering is restored.
+   * @param size_t pos The position of the hole
+   * @param const PQNode & node The node to be placed
+   * @return size_t The final position of the node
    */
-  void swapNodes(const size_t index1, const size_t index2);
+  size_t siftDown(size_t pos, const PQNode & node);
 
   /**
-   * Make a tree rooted at a given position into a heap
-   * @param pos The root position of the tree to heapify
+   * Place the node at the given position and update the index structure.
+   * @param const size_t & pos
+   * @param const PQNode & node
    */
-  void heapify(const size_t pos);
+  void place(const size_t & pos, const PQNode & node)
+  {
+    mHeap[pos] = node;
+    mIndexPointer[node.mIndex] = pos;
+    ++mStatistics.Moves;
+  }
 
   /**
    * Used by the updateNode function. Update the node at a given position.
@@ -206,21 +282,15 @@ private:
    * @param pos The current node position
    * @return The parent node position
    */
-  size_t parent(const size_t pos) const {return (pos + 1) / 2 - 1;}
+  size_t parent(const size_t pos) const {return (pos + Arity - 1) / Arity - 1;}
 
   /**
-   * Provide the position in the heap of the left child of the current node.
+   * Provide the position in the heap of the first child of the current node.
+   * The remaining children are stored contiguously after it.
    * @param pos The current node position
-   * @return The left child position
+   * @return The first child position
    */
-  size_t leftChild(const size_t pos) const {return 2*pos + 1;}
-
-  /**
-   * Provide the position in the heap of the right child of the current node.
-   * @param pos The current node position
-   * @return The right child position
-   */
-  size_t rightChild(const size_t pos) const {return 2*pos + 2;}
+  size_t firstChild(const size_t pos) const {return Arity * pos + 1;}
 
 private:
   // Members
@@ -232,6 +302,16 @@ private:
    * The vector which stores a pointer to each indexed node on the heap
    */
   std::vector<size_t> mIndexPointer;
+
+  /**
+   * The updates recorded by updateNodeDeferred which are not yet applied.
+   */
+  std::vector<PQNode> mPendingUpdates;
+
+  /**
+   * The counters
+   */
+  sStatistics mStatistics;
 };
 
 #endif // COPASI_CPriorityQueue
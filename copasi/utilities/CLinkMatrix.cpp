@@ -9,12 +9,14 @@
 // All rights reserved.
 
 #include <cmath>
+#include <iostream>
 
 #include "copasi.h"
 
 #include "CLinkMatrix.h"
 
 #include "copasi/core/CDataVector.h"
+#include "copasi/utilities/utility.h"
 
 #include "lapack/blaswrap.h"
 #include "lapack/lapackwrap.h"
@@ -386,6 +388,79 @@ void CLinkMatrix::completePivotInformation()
     }
 }
 
+bool CLinkMatrix::save(std::ostream & os) const
+{
+  unsigned C_INT64 Size[3] = {mIndependent, numRows(), numCols()};
+  os.write((const char *) Size, sizeof(Size));
+
+  unsigned C_INT64 Count = mRowPivots.size();
+  os.write((const char *) &Count, sizeof(Count));
+
+  for (const size_t * pPivot = mRowPivots.array(), * pEnd = pPivot + Count; pPivot != pEnd; ++pPivot)
+    {
+      unsigned C_INT64 Pivot = *pPivot;
+      os.write((const char *) &Pivot, sizeof(Pivot));
+    }
+
+  if (size() > 0)
+    os.write((const char *) array(), size() * sizeof(C_FLOAT64));
+
+  return !os.fail();
+}
+
+bool CLinkMatrix::load(std::istream & is)
+{
+  unsigned C_INT64 Size[3] = {0, 0, 0};
+  unsigned C_INT64 Count = 0;
+
+  is.read((char *) Size, sizeof(Size));
+  is.read((char *) &Count, sizeof(Count));
+
+  if (is.fail() || Size[0] > Count)
+    return false;
+
+  // The link matrix has a row for each dependent and a column for each
+  // independent row of the stoichiometry matrix. We must not allocate more than
+  // the stream can provide.
+  unsigned C_INT64 Remaining = remainingBytes(is);
+
+  if (Size[1] != Count - Size[0] ||
+      Size[2] != Size[0] ||
+      Count > Remaining / sizeof(unsigned C_INT64) ||
+      (Size[2] > 0 &&
+       Size[1] > (Remaining - Count * sizeof(unsigned C_INT64)) / sizeof(C_FLOAT64) / Size[2]))
+    return false;
+
+  mRowPivots.resize(Count);
+  std::vector< bool > Found(Count, false);
+
+  for (size_t * pPivot = mRowPivots.array(), * pEnd = pPivot + Count; pPivot != pEnd && !is.fail(); ++pPivot)
+    {
+      unsigned C_INT64 Pivot = Count;
+      is.read((char *) &Pivot, sizeof(Pivot));
+
+      // The pivots must be a permutation.
+      if (Pivot >= Count || Found[Pivot])
+        return false;
+
+      Found[Pivot] = true;
+      *pPivot = Pivot;
+    }
+
+  resize(Size[1], Size[2]);
+
+  if (size() > 0)
+    is.read((char *) array(), size() * sizeof(C_FLOAT64));
+
+  if (is.fail())
+    return false;
+
+  mIndependent = Size[0];
+  completePivotInformation();
+
+  return true;
+}
+
 void CLinkMatrix::clearPivoting()
 {
   size_t * pPivot = mRowPivots.array();
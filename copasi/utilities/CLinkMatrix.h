@@ -48,6 +48,20 @@ public:
    */
   void clearPivoting();
 
+  /**
+   * Write the link matrix including its row pivots in binary form
+   * @param std::ostream & os
+   * @return bool success
+   */
+  bool save(std::ostream & os) const;
+
+  /**
+   * Read a link matrix written with save
+   * @param std::istream & is
+   * @return bool success
+   */
+  bool load(std::istream & is);
+
   /**
    * Right multiply the given matrix M with L, i.e., P = alpha M * L.
    * Note the columns of M must be in the same order as L.
@@ -206,6 +206,8 @@ const MESSAGES Messages[] =
   {MCOptimization + 7, "Optimization (7): No Task Type specified."},
   {MCOptimization + 8, "Optimization (8): '%d' Function Evaluations out of '%d' failed."},
   {MCOptimization + 9, "Optimization (9): '%d' Constraint Checks out of '%d' failed."},
+  {MCOptimization + 10, "Optimization (10): The island directory '%s' does not exist or is not writable."},
+  {MCOptimization + 11, "Optimization (11): The evaluation trace file '%s' could not be opened."},
 
   // SBML
   {MCSBML + 1, "SBML (1): SBML currently does not support initial times different from 0. This information will be lost in the exported file."},
@@ -356,6 +358,8 @@ const MESSAGES Messages[] =
   {MCCopasiTask + 6, "CCopasiTask (6): Requested output object:\n '%s'\n not found. It will be ignored."},
   {MCCopasiTask + 7, "CCopasiTask (7): Problems compiling output."},
   {MCCopasiTask + 8, "CCopasiTask (8): '%d' Function Evaluations out of '%d' failed."},
+  {MCCopasiTask + 9, "CCopasiTask (9): Could not connect to the output socket '%s'."},
+  {MCCopasiTask + 10, "CCopasiTask (10): '%d' output rows were dropped since the consumer of the socket '%s' did not keep up."},
 
   {
     MCSteadyState + 1, "CSteadyState (1): The model is explicitly time dependent. "
@@ -472,6 +476,8 @@ const MESSAGES Messages[] =
     " time '%d' due to a negative delay."
   },
   {MCMathModel + 3, "CMathModel (3): Recursive prerequisites encountered for object '%s'."},
+  {MCMathModel + 4, "CMathModel (4): The object '%s' is not an initial value which can be changed."},
+  {MCMathModel + 5, "CMathModel (5): The number of values '%d' does not match the number of targets '%d'."},
 
   //CModelMerging
   {MCModelMerging + 1, "CModelMerging (1): An error has occurred while constructing the temporary (joined)  data model."},
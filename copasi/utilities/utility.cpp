@@ -433,6 +433,23 @@ bool strToIndex(const std::string & str, size_t & index)
   return (found == 1 && index != C_INVALID_INDEX);
 }
 
+unsigned C_INT64 remainingBytes(std::istream & is)
+{
+  std::istream::pos_type Current = is.tellg();
+
+  if (Current == std::istream::pos_type(-1))
+    return std::numeric_limits< unsigned C_INT64 >::max();
+
+  is.seekg(0, std::ios_base::end);
+  std::istream::pos_type End = is.tellg();
+  is.seekg(Current);
+
+  if (End == std::istream::pos_type(-1) || End < Current)
+    return std::numeric_limits< unsigned C_INT64 >::max();
+
+  return (unsigned C_INT64)(End - Current);
+}
+
 void * stringToPointer(const std::string str)
 {
 #ifdef _MSC_VER
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <array>
+#include <iosfwd>
 #include <string.h>
 // #include <stdio.h>
 #include <stdarg.h>
@@ -194,6 +195,14 @@ void * stringToPointer(const std::string str);
  */
 std::string pointerToString(const void * pVoid);
 
+/**
+ * Determine the number of bytes remaining in an input stream. For streams
+ * which do not support seeking the maximal value is returned.
+ * @param std::istream & is
+ * @return unsigned C_INT64 remainingBytes
+ */
+unsigned C_INT64 remainingBytes(std::istream & is);
+
 /**
  * Convert a utf8 encoded name to a XmlId
  * @param const std::string & name
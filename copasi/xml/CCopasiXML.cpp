@@ -193,20 +193,24 @@ bool CCopasiXML::load(std::istream & is,
   Parser.setLayoutList(mpLayoutList);
   Parser.setDatamodel(this->mpDataModel);
 
-#define BUFFER_SIZE 0xfffe
-  char * pBuffer = new char[BUFFER_SIZE + 1];
+#define BUFFER_SIZE 0x40000
 
   try
     {
       while (!done)
         {
-          mpIstream->get(pBuffer, BUFFER_SIZE, 0);
+          // We read directly into the buffer of the parser to avoid copying the data.
+          char * pBuffer = (char *) Parser.getBuffer(BUFFER_SIZE);
+
+          if (pBuffer == NULL) fatalError();
+
+          mpIstream->read(pBuffer, BUFFER_SIZE);
 
           if (mpIstream->eof()) done = true;
 
           if (mpIstream->fail() && !done) fatalError();
 
-          if (!Parser.parse(pBuffer, -1, done))
+          if (!Parser.parseBuffer((int) mpIstream->gcount(), done))
             {
               CCopasiMessage Message(CCopasiMessage::RAW, MCXML + 2,
                                      Parser.getCurrentLineNumber(),
@@ -223,9 +227,12 @@ bool CCopasiXML::load(std::istream & is,
       success = false;
     }
 
-  delete [] pBuffer;
 #undef BUFFER_SIZE
 
+#ifdef COPASI_XML_PROFILE
+  Parser.printProfile(std::cerr);
+#endif // COPASI_XML_PROFILE
+
   mpModel = Parser.getModel();
   mpReportList = Parser.getReportList();
   mpTaskList = Parser.getTaskList();
@@ -1505,6 +1512,9 @@ bool CCopasiXML::saveReportList()
       Attributes.add("separator", pReport->getSeparator().getStaticString());
       Attributes.add("precision", pReport->getPrecision());
 
+      if (pReport->getOutputInterval() > 0.0)
+        Attributes.add("outputInterval", pReport->getOutputInterval());
+
       startSaveElement("Report", Attributes);
 
       startSaveElement("Comment");
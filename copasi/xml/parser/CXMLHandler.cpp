@@ -47,10 +47,7 @@ void CXMLHandler::start(const XML_Char * pszName,
           IncreaseLevel = true;
         }
 
-      const std::set< Type > ValidElements =  mValidElements[mLastKnownElement.first];
-      std::set< Type >::iterator itValidElement = ValidElements.find(itElementType->second.first);
-
-      if (itValidElement != ValidElements.end())
+      if (isValidElement(mLastKnownElement.first, itElementType->second.first))
         {
           mCurrentElement = itElementType->second;
           mLastKnownElement = mCurrentElement;
@@ -100,9 +97,7 @@ void CXMLHandler::end(const XML_Char * pszName)
     {
       if (itElementType->second == std::make_pair(mElementType, mHandlerType))
         {
-          const std::set< Type > ValidElements =  mValidElements[mLastKnownElement.first];
-
-          if (ValidElements.find(AFTER) == ValidElements.end())
+          if (!isValidElement(mLastKnownElement.first, AFTER))
             {
               // We have an element closing without finding all required child elements
               CCopasiMessage(CCopasiMessage::WARNING, MCXML + 24,
@@ -137,6 +132,13 @@ void CXMLHandler::end(const XML_Char * pszName)
     }
 }
 
+bool CXMLHandler::isValidElement(const Type & lastElement, const Type & element) const
+{
+  std::map< Type, std::set< Type > >::const_iterator found = mValidElements.find(lastElement);
+
+  return found != mValidElements.end() && found->second.find(element) != found->second.end();
+}
+
 CXMLHandler * CXMLHandler::getHandler(const Type & type)
 {
   return mpParser->getHandler(type);
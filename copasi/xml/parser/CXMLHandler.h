@@ -241,6 +241,14 @@ protected:
 
   CXMLHandler * getHandler(const Type & type);
 
+  /**
+   * Check whether the element may follow the last known element
+   * @param const Type & lastElement
+   * @param const Type & element
+   * @return bool isValid
+   */
+  bool isValidElement(const Type & lastElement, const Type & element) const;
+
   void addFix(const std::string & key, CDataObject * pObject);
 
   void init();
@@ -36,6 +36,7 @@
 #include "utilities/CUnitDefinition.h"
 
 #include "utilities/CVersion.h"
+#include "utilities/CopasiTime.h"
 #include "utilities/CCopasiParameter.h"
 #include "utilities/CCopasiParameterGroup.h"
 #include "utilities/CSlider.h"
@@ -90,6 +91,11 @@ CXMLParser::CXMLParser(CVersion & version) :
   mCharacterData(),
   mCharacterDataEncoding(CCopasiXMLInterface::none),
   mElementHandlerStack()
+#ifdef COPASI_XML_PROFILE
+  , mDispatching(false)
+  , mProfileStack()
+  , mProfile()
+#endif // COPASI_XML_PROFILE
 {
   create();
 
@@ -115,8 +121,23 @@ void CXMLParser::onStartElement(const XML_Char *pszName,
   std::cout << mElementHandlerStack.size() << ", " << getCurrentLineNumber() << ": Start " << pszName << std::endl;
 #endif // DEBUG_OUTPUT
 
+#ifdef COPASI_XML_PROFILE
+  // Handlers forward the element to the next handler by calling this method again,
+  // i.e., we must only record the element when called by expat.
+  bool Dispatching = mDispatching;
+
+  if (!Dispatching)
+    mProfileStack.push_back(std::make_pair(CCopasiTimeVariable::getCurrentWallTime().getMicroSeconds(), 0));
+
+  mDispatching = true;
+#endif // COPASI_XML_PROFILE
+
   assert(mElementHandlerStack.size() != 0);
   mElementHandlerStack.top()->start(pszName, papszAttrs);
+
+#ifdef COPASI_XML_PROFILE
+  mDispatching = Dispatching;
+#endif // COPASI_XML_PROFILE
 }
 
 void CXMLParser::onEndElement(const XML_Char *pszName)
@@ -125,11 +146,47 @@ void CXMLParser::onEndElement(const XML_Char *pszName)
   std::cout << mElementHandlerStack.size() << ", " << getCurrentLineNumber() << ": End   " << pszName << std::endl;
 #endif // DEBUG_OUTPUT
 
+#ifdef COPASI_XML_PROFILE
+  bool Dispatching = mDispatching;
+  mDispatching = true;
+#endif // COPASI_XML_PROFILE
+
   if (mElementHandlerStack.size() != 0)
     mElementHandlerStack.top()->end(pszName);
-  else
-    return;
+
+#ifdef COPASI_XML_PROFILE
+  mDispatching = Dispatching;
+
+  if (!Dispatching && !mProfileStack.empty())
+    {
+      C_INT64 Total = CCopasiTimeVariable::getCurrentWallTime().getMicroSeconds() - mProfileStack.back().first;
+      sProfile & Profile = mProfile[pszName];
+
+      Profile.count++;
+      Profile.total += Total;
+      Profile.self += Total - mProfileStack.back().second;
+
+      mProfileStack.pop_back();
+
+      if (!mProfileStack.empty())
+        mProfileStack.back().second += Total;
+    }
+#endif // COPASI_XML_PROFILE
+}
+
+#ifdef COPASI_XML_PROFILE
+void CXMLParser::printProfile(std::ostream & os) const
+{
+  os << "Element\tCount\tTotal [ms]\tSelf [ms]" << std::endl;
+
+  std::map< std::string, sProfile >::const_iterator it = mProfile.begin();
+  std::map< std::string, sProfile >::const_iterator end = mProfile.end();
+
+  for (; it != end; ++it)
+    os << it->first << "\t" << it->second.count << "\t"
+       << it->second.total * 1e-3 << "\t" << it->second.self * 1e-3 << std::endl;
 }
+#endif // COPASI_XML_PROFILE
 
 #ifdef XXXX
 void CXMLParser::onStartCdataSection()
@@ -176,6 +233,13 @@ void CXMLParser::enableCharacterDataHandler(bool fEnable)
 void CXMLParser::onCharacterData(const XML_Char *pszData,
                                  int nLength)
 {
+  // Expat delivers the data in many small pieces, i.e., we avoid temporaries if no encoding is needed.
+  if (mCharacterDataEncoding == CCopasiXMLInterface::none)
+    {
+      mCharacterData.append(pszData, nLength);
+      return;
+    }
+
   std::string Data;
   Data.append(pszData, nLength);
 
@@ -185,31 +249,38 @@ void CXMLParser::onCharacterData(const XML_Char *pszData,
 std::string CXMLParser::getCharacterData(const std::string & toBeStripped,
     const std::string & join)
 {
-  std::string tmp(mCharacterData);
+  std::string tmp;
+  tmp.swap(mCharacterData);
 
   enableCharacterDataHandler(false); /* Resetting for future calls. */
 
   if (toBeStripped == "") return tmp;
 
-  std::string::size_type Start = tmp.find_first_of(toBeStripped);
-  std::string::size_type End = 0;
+  // We build the stripped data in a single pass instead of erasing and inserting in place.
+  std::string Stripped;
+  Stripped.reserve(tmp.length());
 
-  while (Start != std::string::npos)
+  std::string::size_type Start = 0;
+  std::string::size_type End = tmp.find_first_of(toBeStripped);
+
+  while (End != std::string::npos)
     {
-      End = tmp.find_first_not_of(toBeStripped, Start);
+      Stripped.append(tmp, Start, End - Start);
+      Start = tmp.find_first_not_of(toBeStripped, End);
 
-      tmp.erase(Start, End - Start);
+      // Leading and trailing sequences are removed without join.
+      if (Start == std::string::npos)
+        return Stripped;
 
-      if (Start && End != std::string::npos)
-        {
-          tmp.insert(Start, join);
-          Start += join.length();
-        }
+      if (End > 0)
+        Stripped += join;
 
-      Start = tmp.find_first_of(toBeStripped, Start);
+      End = tmp.find_first_of(toBeStripped, Start);
     }
 
-  return tmp;
+  Stripped.append(tmp, Start, std::string::npos);
+
+  return Stripped;
 }
 
 void CXMLParser::pushElementHandler(CXMLHandler * pElementHandler)
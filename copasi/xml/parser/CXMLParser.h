@@ -64,6 +64,35 @@ private:
    */
   std::stack< CXMLHandler * > mElementHandlerStack;
 
+#ifdef COPASI_XML_PROFILE
+  /**
+   * The accumulated statistics of an element name
+   */
+  struct sProfile
+  {
+    sProfile(): count(0), total(0), self(0) {}
+
+    size_t count;
+    C_INT64 total;
+    C_INT64 self;
+  };
+
+  /**
+   * Indicates that an element event is currently dispatched to the handlers
+   */
+  bool mDispatching;
+
+  /**
+   * The start time and the time spent in child elements for each open element in microseconds
+   */
+  std::vector< std::pair< C_INT64, C_INT64 > > mProfileStack;
+
+  /**
+   * The statistics for each element name
+   */
+  std::map< std::string, sProfile > mProfile;
+#endif // COPASI_XML_PROFILE
+
   // Operations
 private:
   /**
@@ -231,6 +260,15 @@ public:
   CXMLHandler * getHandler(const CXMLHandler::Type & type);
 
   void setCharacterEncoding(const CCopasiXMLInterface::EncodingType & encoding);
+
+#ifdef COPASI_XML_PROFILE
+  /**
+   * Print the number of occurrences and the total and self wall time spent
+   * for each element name
+   * @param std::ostream & os
+   */
+  void printProfile(std::ostream & os) const;
+#endif // COPASI_XML_PROFILE
 };
 
 #endif // COPASI_CXMLParser
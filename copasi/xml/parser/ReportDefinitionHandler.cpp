@@ -40,6 +40,7 @@ CXMLHandler * ReportDefinitionHandler::processStart(const XML_Char * pszName,
   const char * Name;
   const char * Separator;
   const char * Precision;
+  const char * OutputInterval;
   CTaskEnum::Task type;
 
   switch (mCurrentElement.first)
@@ -51,12 +52,14 @@ CXMLHandler * ReportDefinitionHandler::processStart(const XML_Char * pszName,
 
         Separator = mpParser->getAttributeValue("separator", papszAttrs, "\t");
         Precision = mpParser->getAttributeValue("precision", papszAttrs, "6");
+        OutputInterval = mpParser->getAttributeValue("outputInterval", papszAttrs, "0");
 
         // create a new report
         mpData->pReport = new CReportDefinition();
         mpData->pReport->setTaskType(type);
         mpData->pReport->setSeparator(Separator);
         mpData->pReport->setPrecision(strToUnsignedInt(Precision));
+        mpData->pReport->setOutputInterval(CCopasiXMLInterface::DBL(OutputInterval));
 
         {
           // We need to make sure that the name is unique.